@@ -0,0 +1,425 @@
+/***********************************************************************
+* rendering-bench.cpp - Scripted rendering benchmarks                  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <time.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+// The heap allocation counter of the unit tests
+#include "allocation-counter.inc"
+
+namespace fc = finalcut::fc;
+using finalcut::FPoint;
+using finalcut::FSize;
+
+
+//----------------------------------------------------------------------
+// class RenderingBench
+//----------------------------------------------------------------------
+
+class RenderingBench final
+{
+  public:
+    // Typedef
+    struct Result
+    {
+      std::string name;
+      int         frames;
+      double      wall_time;    // seconds
+      double      cpu_time;     // seconds
+      std::size_t bytes;
+      std::size_t allocations;
+    };
+
+    // Constructor
+    RenderingBench (finalcut::FApplication&, finalcut::FSystemHeadless&);
+
+    // Disable copy constructor
+    RenderingBench (const RenderingBench&) = delete;
+
+    // Destructor
+    ~RenderingBench() = default;
+
+    // Disable assignment operator (=)
+    RenderingBench& operator = (const RenderingBench&) = delete;
+
+    // Accessor
+    const std::vector<Result>& getResults() const;
+
+    // Inquiry
+    static bool isScenario (const std::string&);
+
+    // Methods
+    void run (const std::string&);
+    static void printResults (const std::vector<Result>&);
+    static void printUsage (const char*);
+
+  private:
+    // Constants
+    static constexpr int dialog_count = 30;
+    static constexpr int textview_lines = 100000;
+    static constexpr int listview_rows = 50000;
+
+    // Methods
+    template <typename StepFunction>
+    void measure (const std::string&, int, StepFunction);
+    void finishFrame();
+    void openDialogs();
+    void dragWindow();
+    void scrollTextView();
+    void sortListView();
+    static double getCpuTime();
+
+    // Data members
+    finalcut::FApplication&     app;
+    finalcut::FSystemHeadless&  terminal;
+    std::vector<Result>         results{};
+};
+
+//----------------------------------------------------------------------
+RenderingBench::RenderingBench ( finalcut::FApplication& fapp
+                               , finalcut::FSystemHeadless& fsys )
+  : app{fapp}
+  , terminal{fsys}
+{
+  // Render every frame immediately
+  finalcut::FVTerm::setFrameInterval(0);
+  finishFrame();
+}
+
+//----------------------------------------------------------------------
+inline const std::vector<RenderingBench::Result>&
+    RenderingBench::getResults() const
+{
+  return results;
+}
+
+//----------------------------------------------------------------------
+bool RenderingBench::isScenario (const std::string& name)
+{
+  return name == "dialogs"
+      || name == "drag"
+      || name == "textview"
+      || name == "listview-sort";
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::run (const std::string& name)
+{
+  if ( name == "dialogs" )
+    openDialogs();
+  else if ( name == "drag" )
+    dragWindow();
+  else if ( name == "textview" )
+    scrollTextView();
+  else if ( name == "listview-sort" )
+    sortListView();
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::printResults (const std::vector<Result>& result_list)
+{
+  std::printf ( "%-16s %8s %10s %12s %12s %13s\n", "Scenario", "Frames"
+              , "Frames/s", "CPU/frame", "Bytes/frame", "Allocs/frame" );
+
+  for (auto&& r : result_list)
+  {
+    const double frames = ( r.frames > 0 ) ? double(r.frames) : 1.0;
+    const double fps = ( r.wall_time > 0.0 ) ? r.frames / r.wall_time : 0.0;
+    std::printf ( "%-16s %8d %10.1f %9.3f ms %12.1f %13.1f\n"
+                , r.name.c_str(), r.frames, fps
+                , r.cpu_time * 1000.0 / frames
+                , double(r.bytes) / frames
+                , double(r.allocations) / frames );
+  }
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::printUsage (const char* progname)
+{
+  std::cout << "Usage: " << progname << " [scenario ...]\n\n"
+            << "Scenarios:\n"
+            << "  dialogs          Open and close " << int(dialog_count)
+            << " dialogs\n"
+            << "  drag             Drag a window around the screen\n"
+            << "  textview         Scroll a " << int(textview_lines)
+            << "-line text view\n"
+            << "  listview-sort    Sort a " << int(listview_rows)
+            << "-row list view\n\n"
+            << "Without arguments all scenarios are run.\n";
+}
+
+//----------------------------------------------------------------------
+template <typename StepFunction>
+void RenderingBench::measure ( const std::string& name, int frames
+                             , StepFunction step )
+{
+  // Every step changes the widgets and renders one frame
+
+  Result result{name, frames, 0.0, 0.0, 0, 0};
+  terminal.clearOutput();
+  const std::size_t start_allocations = test::getAllocationCount();
+  const double start_cpu_time = getCpuTime();
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int frame{0}; frame < frames; frame++)
+  {
+    step(frame);
+    app.updateTerminal();
+    result.bytes += terminal.getOutput().length();
+    terminal.clearOutput();
+  }
+
+  const std::chrono::duration<double> wall_time = \
+      std::chrono::steady_clock::now() - start;
+  result.wall_time = wall_time.count();
+  result.cpu_time = getCpuTime() - start_cpu_time;
+  result.allocations = test::getAllocationCount() - start_allocations;
+  results.push_back(result);
+}
+
+//----------------------------------------------------------------------
+inline void RenderingBench::finishFrame()
+{
+  // Renders the setup outside of the measurement
+
+  app.updateTerminal();
+  terminal.clearOutput();
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::openDialogs()
+{
+  // Opens dialog_count cascaded dialogs and closes them again
+
+  static constexpr int rounds = 10;
+  std::vector<finalcut::FDialog*> dialogs{};
+  const int max_x = int(app.getWidth()) - 36;
+  const int max_y = int(app.getHeight()) - 10;
+
+  measure ( "dialogs", rounds * dialog_count * 2
+          , [&] (int frame)
+            {
+              if ( frame % (dialog_count * 2) < dialog_count )
+              {
+                const int n = int(dialogs.size());
+                auto dgl = new finalcut::FDialog(&app);
+                dgl->setText ("Dialog " + std::to_string(n + 1));
+                dgl->setGeometry ( FPoint{1 + (2 * n) % max_x, 1 + n % max_y}
+                                 , FSize{36, 10} );
+                dgl->setShadow();
+                auto label = new finalcut::FLabel("Name:", dgl);
+                label->setGeometry (FPoint{2, 2}, FSize{6, 1});
+                auto input = new finalcut::FLineEdit("Final Cut", dgl);
+                input->setGeometry (FPoint{9, 2}, FSize{22, 1});
+                auto button = new finalcut::FButton("&OK", dgl);
+                button->setGeometry (FPoint{22, 5}, FSize{10, 1});
+                dgl->show();
+                dialogs.push_back(dgl);
+              }
+              else
+              {
+                delete dialogs.back();
+                dialogs.pop_back();
+              }
+            } );
+
+  finishFrame();
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::dragWindow()
+{
+  // Drags a dialog around the screen in front of a text background
+
+  static constexpr int rounds = 5;
+  const int width = int(app.getWidth());
+  const int height = int(app.getHeight());
+  finalcut::FDialog background(&app);
+  background.setText ("Background");
+  background.setGeometry (FPoint{1, 1}, FSize(app.getWidth(), app.getHeight()));
+  finalcut::FTextView text(&background);
+  text.setGeometry (FPoint{1, 1}, FSize(app.getWidth() - 2, app.getHeight() - 2));
+
+  for (int y{0}; y < height; y++)
+    text.append (finalcut::FString(std::size_t(width), wchar_t(L'a' + y % 26)));
+
+  background.show();
+  finalcut::FDialog window(&app);
+  window.setText ("Drag me");
+  window.setGeometry (FPoint{1, 1}, FSize{40, 12});
+  window.setShadow();
+  finalcut::FButton button("&Button", &window);
+  button.setGeometry (FPoint{14, 5}, FSize{10, 1});
+  window.show();
+  finishFrame();
+
+  // The way around the screen
+  const int right = width - 41;
+  const int down = height - 12;
+  const int lap = 2 * (right + down);
+
+  measure ( "drag", rounds * lap
+          , [&] (int frame)
+            {
+              const int step = frame % lap;
+
+              if ( step < right )
+                window.move (FPoint{1, 0});
+              else if ( step < right + down )
+                window.move (FPoint{0, 1});
+              else if ( step < 2 * right + down )
+                window.move (FPoint{-1, 0});
+              else
+                window.move (FPoint{0, -1});
+            } );
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::scrollTextView()
+{
+  // Scrolls line by line through a long text
+
+  static constexpr int frames = 3000;
+  finalcut::FDialog dgl(&app);
+  dgl.setText ("Text view");
+  dgl.setGeometry (FPoint{1, 1}, FSize(app.getWidth(), app.getHeight()));
+  finalcut::FTextView text(&dgl);
+  text.setGeometry (FPoint{1, 1}, FSize(app.getWidth() - 2, app.getHeight() - 2));
+
+  for (int line{1}; line <= textview_lines; line++)
+    text.append ( finalcut::FString().sprintf("%6d", line)
+                + "  The quick brown fox jumps over the lazy dog "
+                + finalcut::FString(std::size_t(1 + line % 40), L'.') );
+
+  dgl.show();
+  finishFrame();
+  measure ("textview", frames, [&] (int) { text.scrollBy (0, 1); });
+}
+
+//----------------------------------------------------------------------
+void RenderingBench::sortListView()
+{
+  // Sorts a long list alternately by all columns
+
+  static constexpr int frames = 30;
+  finalcut::FDialog dgl(&app);
+  dgl.setText ("List view");
+  dgl.setGeometry (FPoint{1, 1}, FSize(app.getWidth(), app.getHeight()));
+  finalcut::FListView list(&dgl);
+  list.setGeometry (FPoint{1, 1}, FSize(app.getWidth() - 2, app.getHeight() - 2));
+  list.addColumn ("Name", 20);
+  list.addColumn ("Number", 10);
+  list.addColumn ("Text");
+  list.setColumnAlignment (2, fc::alignRight);
+  list.setColumnSortType (1, fc::by_name);
+  list.setColumnSortType (2, fc::by_number);
+  list.setColumnSortType (3, fc::by_name);
+  uInt random{12345};  // Reproducible pseudo-random numbers
+
+  for (int row{0}; row < listview_rows; row++)
+  {
+    random = random * 1103515245 + 12345;
+    const finalcut::FStringList line
+    {
+      finalcut::FString().sprintf("Item %05u", (random >> 8) % 100000),
+      finalcut::FString().sprintf("%d", row),
+      finalcut::FString().sprintf("%c row %d", 'A' + random % 26, row)
+    };
+    list.insert (line);
+  }
+
+  dgl.show();
+  finishFrame();
+
+  measure ( "listview-sort", frames
+          , [&] (int frame)
+            {
+              const auto order = ( (frame / 3) % 2 == 0 ) ? fc::descending
+                                                          : fc::ascending;
+              list.setColumnSort (frame % 3 + 1, order);
+              list.sort();
+              list.redraw();
+            } );
+}
+
+//----------------------------------------------------------------------
+double RenderingBench::getCpuTime()
+{
+  struct timespec ts{};
+  clock_gettime (CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return double(ts.tv_sec) + double(ts.tv_nsec) / 1e9;
+}
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+
+int main (int argc, char* argv[])
+{
+  std::vector<std::string> scenarios{};
+
+  for (int i{1}; i < argc; i++)
+  {
+    if ( ! RenderingBench::isScenario(argv[i]) )
+    {
+      RenderingBench::printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    scenarios.push_back(argv[i]);
+  }
+
+  if ( scenarios.empty() )
+    scenarios = { "dialogs", "drag", "textview", "listview-sort" };
+
+  std::vector<RenderingBench::Result> results{};
+
+  {
+    // Render into a reproducible in-memory terminal
+    // (FTerm takes over the ownership)
+    auto terminal = new finalcut::FSystemHeadless(120, 40, "xterm-256color");
+    finalcut::FTerm::setFSystem(terminal);
+
+    // The command line options do not change the measurement
+    const int app_argc{1};
+    char* app_argv[] = { argv[0], nullptr };
+    finalcut::FApplication app(app_argc, app_argv);
+    RenderingBench bench(app, *terminal);
+
+    for (auto&& name : scenarios)
+      bench.run(name);
+
+    results = bench.getResults();
+  }
+
+  RenderingBench::printResults(results);
+  return EXIT_SUCCESS;
+}
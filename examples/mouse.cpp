@@ -501,11 +501,8 @@ void MouseDraw::drawCanvas()
                 , canvaschar
                 , sizeof(finalcut::FChar) * unsigned(x_end) );
 
-    if ( int(printarea->changes[ay + y].xmin) > ax )
-      printarea->changes[ay + y].xmin = uInt(ax);
-
-    if ( int(printarea->changes[ay + y].xmax) < ax + x_end - 1 )
-      printarea->changes[ay + y].xmax = uInt(ax + x_end - 1);
+    addLineChanges ( printarea->changes[ay + y]
+                   , uInt(ax), uInt(ax + x_end - 1) );
   }
 
   printarea->has_changes = true;
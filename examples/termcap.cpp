@@ -72,6 +72,8 @@ data::termcap_string data::strings[] =
   { "t_insert_padding", fc::t_insert_padding },
   { "t_insert_character", fc::t_insert_character },
   { "t_parm_ich", fc::t_parm_ich },
+  { "t_delete_character", fc::t_delete_character },
+  { "t_parm_dch", fc::t_parm_dch },
   { "t_repeat_char", fc::t_repeat_char },
   { "t_initialize_color", fc::t_initialize_color },
   { "t_initialize_pair", fc::t_initialize_pair },
@@ -101,6 +103,13 @@ data::termcap_string data::strings[] =
   { "t_restore_cursor", fc::t_restore_cursor },
   { "t_scroll_forward", fc::t_scroll_forward },
   { "t_scroll_reverse", fc::t_scroll_reverse },
+  { "t_parm_index", fc::t_parm_index },
+  { "t_parm_rindex", fc::t_parm_rindex },
+  { "t_change_scroll_region", fc::t_change_scroll_region },
+  { "t_insert_line", fc::t_insert_line },
+  { "t_delete_line", fc::t_delete_line },
+  { "t_parm_insert_line", fc::t_parm_insert_line },
+  { "t_parm_delete_line", fc::t_parm_delete_line },
   { "t_enter_ca_mode", fc::t_enter_ca_mode },
   { "t_exit_ca_mode", fc::t_exit_ca_mode },
   { "t_enable_acs", fc::t_enable_acs },
@@ -20,19 +20,26 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <cstdlib>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "final/fapplication.h"
 #include "final/fevent.h"
+#include "final/feventqueue.h"
 #include "final/fmenu.h"
 #include "final/fmenubar.h"
 #include "final/fmessagebox.h"
 #include "final/fmouse.h"
+#include "final/fpoll.h"
+#include "final/fpostqueue.h"
 #include "final/fstartoptions.h"
 #include "final/fstatusbar.h"
 #include "final/ftermdata.h"
 #include "final/ftermios.h"
+#include "final/fthreadpool.h"
+#include "final/ftrace.h"
 #include "final/fwidgetcolors.h"
 #include "final/fwindow.h"
 
@@ -59,7 +66,10 @@ int            FApplication::loop_level      {0};        // event loop level
 int            FApplication::quit_code       {0};
 bool           FApplication::quit_now        {false};
 
-FApplication::eventQueue* FApplication::event_queue{nullptr};
+FEventQueue* FApplication::event_queue{nullptr};
+std::atomic<FPostQueue*> FApplication::post_queue{nullptr};
+std::atomic<int> FApplication::active_posts{0};
+FThreadPool* FApplication::thread_pool{nullptr};
 
 
 //----------------------------------------------------------------------
@@ -99,9 +109,33 @@ FApplication::FApplication ( const int& _argc
 //----------------------------------------------------------------------
 FApplication::~FApplication()  // destructor
 {
+  if ( FTrace::isEnabled() )
+  {
+    FTrace::dump();
+    FTrace::stop();
+  }
+
+  // Waits for the running background jobs
+  if ( thread_pool )
+    delete thread_pool;
+
+  thread_pool = nullptr;
+
+  // Other threads can no longer post. The posts that
+  // are already in progress are completed first.
+  const auto queue = post_queue.exchange(nullptr);
+
+  while ( active_posts > 0 )
+    std::this_thread::yield();
+
+  FPoll::finish();
+
   if ( event_queue )
     delete event_queue;
 
+  if ( queue )
+    delete queue;
+
   event_queue = nullptr;
   app_object = nullptr;
 }
@@ -114,6 +148,30 @@ FApplication* FApplication::getApplicationObject()
   return app_object;
 }
 
+//----------------------------------------------------------------------
+FThreadPool* FApplication::getThreadPool()
+{
+  // The worker threads start with the first background job
+
+  if ( ! app_object )
+    return nullptr;
+
+  if ( ! thread_pool )
+  {
+    try
+    {
+      thread_pool = new FThreadPool;
+    }
+    catch (const std::bad_alloc& ex)
+    {
+      std::cerr << bad_alloc_str << ex.what() << std::endl;
+      return nullptr;
+    }
+  }
+
+  return thread_pool;
+}
+
 //----------------------------------------------------------------------
 bool FApplication::isQuit()
 {
@@ -233,22 +291,26 @@ bool FApplication::sendEvent ( const FObject* receiver
 void FApplication::queueEvent ( const FObject* receiver
                               , const FEvent* event )
 {
-  if ( ! receiver )
+  if ( ! receiver || ! event || ! event_queue )
     return;
 
-  // queue this event
-  eventPair send_event (receiver, std::make_shared<const FEvent>(*event));
-  event_queue->push_back(send_event);
+  // queue a copy of this event
+  event_queue->push (receiver, event);
 }
 
 //----------------------------------------------------------------------
 void FApplication::sendQueuedEvents()
 {
-  while ( eventInQueue() )
+  if ( ! app_object )
+    return;
+
+  // The popped event stays valid during a nested event loop
+  FEventQueue::FEventItem item{};
+
+  while ( event_queue->pop(item) )
   {
-    sendEvent( event_queue->front().first,
-               event_queue->front().second.get() );
-    event_queue->pop_front();
+    sendEvent (item.receiver, item.event);
+    event_queue->release(item);
   }
 }
 
@@ -256,7 +318,7 @@ void FApplication::sendQueuedEvents()
 bool FApplication::eventInQueue()
 {
   if ( app_object )
-    return ( ! event_queue->empty() );
+    return ( ! event_queue->isEmpty() );
   else
     return false;
 }
@@ -264,27 +326,75 @@ bool FApplication::eventInQueue()
 //----------------------------------------------------------------------
 bool FApplication::removeQueuedEvent (const FObject* receiver)
 {
-  if ( ! eventInQueue() )
+  if ( ! receiver )
     return false;
 
-  if ( ! receiver )
+  // Events from other threads that are not yet delivered
+  const auto queue = post_queue.load();
+  bool retval = queue && queue->removeReceiver(receiver);
+
+  if ( event_queue && event_queue->removeReceiver(receiver) )
+    retval = true;
+
+  return retval;
+}
+
+//----------------------------------------------------------------------
+bool FApplication::postEvent ( const FObject* receiver
+                             , std::unique_ptr<FEvent> event )
+{
+  // Thread-safe: queues the event for delivery in the event loop
+  // (the receiver must remain valid or be destroyed in the event loop).
+  // Returns false after the application has started its shutdown.
+
+  if ( ! receiver || ! event )
     return false;
 
-  bool retval{false};
-  auto iter = event_queue->begin();
+  active_posts++;
+  const auto queue = post_queue.load();
 
-  while ( iter != event_queue->end() )
+  if ( queue )
   {
-    if ( iter->first == receiver )
-    {
-      iter = event_queue->erase(iter);
-      retval = true;
-    }
-    else
-      ++iter;
+    queue->push (receiver, std::move(event));
+    FPoll::wakeUp();
   }
 
-  return retval;
+  active_posts--;
+  return queue != nullptr;
+}
+
+//----------------------------------------------------------------------
+bool FApplication::postTask (std::function<void()> task)
+{
+  // Thread-safe: calls the function in the event loop.
+  // Returns false after the application has started its shutdown.
+
+  if ( ! task )
+    return false;
+
+  active_posts++;
+  const auto queue = post_queue.load();
+
+  if ( queue )
+  {
+    queue->push (std::move(task));
+    FPoll::wakeUp();
+  }
+
+  active_posts--;
+  return queue != nullptr;
+}
+
+//----------------------------------------------------------------------
+bool FApplication::cancelBackgroundJobs (const FObject* owner)
+{
+  // Cancels the thread pool jobs of owner and waits
+  // for its running jobs to return
+
+  if ( ! thread_pool || ! owner )
+    return false;
+
+  return thread_pool->cancel(owner);
 }
 
 //----------------------------------------------------------------------
@@ -326,6 +436,16 @@ void FApplication::showParameterUsage()
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
     << "    Do not optimize SGR sequences\n"
+    << "  --max-fps <n>             "
+    << "    Limits the terminal updates per second\n"
+    << "                            "
+    << "    (0 = unlimited, default = 60)\n"
+    << "  --async-output            "
+    << "    Write the terminal output in a separate thread\n"
+    << "  --trace <file>            "
+    << "    Write an event loop timeline to file\n"
+    << "                            "
+    << "    (Chrome trace format, dumps also on SIGUSR1)\n"
     << "  --vgafont                 "
     << "    Set the standard vga 8x16 font\n"
     << "  --newfont                 "
@@ -396,9 +516,30 @@ void FApplication::init (uInt64 key_time, uInt64 dblclick_time)
   if ( mouse )
     mouse->setDblclickInterval (dblclick_time);
 
+  // Limit the terminal updates to max_fps frames per second
+  const uInt max_fps = getStartOptions().max_fps;
+  setFrameInterval ( ( max_fps > 0 ) ? 1000000 / max_fps : 0 );
+
+  // Write the terminal output in a separate thread
+  if ( getStartOptions().async_output )
+    setAsyncOutput();
+
+  // Record the event loop timeline
+  FString trace_file{getStartOptions().trace_file};
+
+  if ( trace_file.isEmpty() && std::getenv("FINALCUT_TRACE") )
+    trace_file = std::getenv("FINALCUT_TRACE");
+
+  if ( ! trace_file.isEmpty() )
+    FTrace::start (trace_file);
+
+  // Signals and other threads interrupt the event loop wait
+  FPoll::init();
+
   try
   {
-    event_queue = new eventQueue;
+    event_queue = new FEventQueue;
+    post_queue = new FPostQueue;
   }
   catch (const std::bad_alloc& ex)
   {
@@ -423,6 +564,9 @@ void FApplication::cmd_options (const int& argc, char* argv[])
       {C_STR("no-terminal-data-request"), no_argument,       nullptr,  0 },
       {C_STR("no-color-change"),          no_argument,       nullptr,  0 },
       {C_STR("no-sgr-optimizer"),         no_argument,       nullptr,  0 },
+      {C_STR("max-fps"),                  required_argument, nullptr,  0 },
+      {C_STR("async-output"),             no_argument,       nullptr,  0 },
+      {C_STR("trace"),                    required_argument, nullptr,  0 },
       {C_STR("vgafont"),                  no_argument,       nullptr,  0 },
       {C_STR("newfont"),                  no_argument,       nullptr,  0 },
 
@@ -483,6 +627,26 @@ void FApplication::cmd_options (const int& argc, char* argv[])
       if ( std::strcmp(long_options[idx].name, "no-sgr-optimizer")  == 0 )
         getStartOptions().sgr_optimizer = false;
 
+      if ( std::strcmp(long_options[idx].name, "max-fps")  == 0 )
+      {
+        const FString fps(optarg);
+
+        try
+        {
+          getStartOptions().max_fps = fps.toUInt();
+        }
+        catch (const std::exception&)
+        {
+          exitWithMessage ("Invalid frame rate " + std::string(optarg));
+        }
+      }
+
+      if ( std::strcmp(long_options[idx].name, "async-output")  == 0 )
+        getStartOptions().async_output = true;
+
+      if ( std::strcmp(long_options[idx].name, "trace")  == 0 )
+        getStartOptions().trace_file = optarg;
+
       if ( std::strcmp(long_options[idx].name, "vgafont")  == 0 )
         getStartOptions().vgafont = true;
 
@@ -540,9 +704,51 @@ inline void FApplication::findKeyboardWidget()
 inline bool FApplication::isKeyPressed()
 {
   if ( mouse && mouse->isGpmMouseEnabled() )
+  {
+    FPoll::waitForInput (-1, 0);  // Dispatches the ready watches
     return mouse->getGpmKeyPressed(keyboard->unprocessedInput());
+  }
 
-  return keyboard->isKeyPressed();
+  // Sleeps until input, a watched file descriptor, a signal,
+  // the next timer or the next frame is due
+  return FPoll::waitForInput (FTermios::getStdIn(), getEventWaitTime());
+}
+
+//----------------------------------------------------------------------
+uInt64 FApplication::getEventWaitTime()
+{
+  // Returns the time in microseconds that the event loop can sleep
+
+  if ( keyboard->isInputDataPending()
+    || eventInQueue()
+    || (post_queue.load() && ! post_queue.load()->isEmpty())
+    || hasChangedTermSize()
+    || (getWidgetCloseList() && ! getWidgetCloseList()->empty()) )
+    return 0;
+
+  const uInt64 wait_time = std::min ( keyboard->getKeypressWaitTime()
+                                    , getFrameWaitTime() );
+  return std::min(wait_time, getTimerWaitTime());
+}
+
+//----------------------------------------------------------------------
+uInt64 FApplication::getTimerWaitTime()
+{
+  // Returns the time in microseconds until the next timer expires
+
+  timeval timeout{};
+
+  if ( ! getNextTimerTimeout(&timeout) )
+    return FPoll::NO_TIMEOUT;
+
+  timeval now{};
+  getMonotonicTime (&now);
+
+  if ( ! (now < timeout) )
+    return 0;
+
+  const timeval diff = timeout - now;
+  return uInt64(diff.tv_sec) * 1000000 + uInt64(diff.tv_usec);
 }
 
 //----------------------------------------------------------------------
@@ -1149,19 +1355,73 @@ void FApplication::processCloseWidget()
   updateTerminal (FVTerm::start_refresh);
 }
 
+//----------------------------------------------------------------------
+void FApplication::processPostedEvents()
+{
+  // Delivers the events and tasks of other threads in posting order
+
+  const auto queue = post_queue.load();
+
+  if ( ! queue )
+    return;
+
+  FPostQueue::FPostItem item{};
+
+  while ( queue->pop(item) )
+  {
+    if ( item.task )
+      item.task();
+    else if ( item.receiver && item.event )
+      sendEvent (item.receiver, item.event.get());
+  }
+}
+
 //----------------------------------------------------------------------
 bool FApplication::processNextEvent()
 {
   uInt num_events{0};
 
-  processKeyboardEvent();
-  processMouseEvent();
-  processResizeEvent();
-  processTerminalUpdate();
+  if ( FTrace::isDumpRequested() )
+    FTrace::dump();
+
+  FTraceScope trace("processNextEvent", "event loop");
+
+  {
+    FTraceScope span("processKeyboardEvent", "event loop");
+    processKeyboardEvent();
+  }
+
+  {
+    FTraceScope span("processMouseEvent", "event loop");
+    processMouseEvent();
+  }
+
+  {
+    FTraceScope span("processResizeEvent", "event loop");
+    processResizeEvent();
+  }
+
+  {
+    FTraceScope span("processTerminalUpdate", "event loop");
+    processTerminalUpdate();
+  }
+
   processCloseWidget();
 
-  sendQueuedEvents();
-  num_events += processTimerEvent();
+  {
+    FTraceScope span("processPostedEvents", "event loop");
+    processPostedEvents();
+  }
+
+  {
+    FTraceScope span("sendQueuedEvents", "event loop");
+    sendQueuedEvents();
+  }
+
+  {
+    FTraceScope span("processTimerEvent", "event loop");
+    num_events += processTimerEvent();
+  }
 
   return ( num_events > 0 );
 }
@@ -1170,6 +1430,7 @@ bool FApplication::processNextEvent()
 void FApplication::performTimerAction ( const FObject* receiver
                                       , const FEvent* event )
 {
+  FTraceScope trace(receiver, "timer");
   sendEvent (receiver, event);
 }
 
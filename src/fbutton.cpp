@@ -596,7 +596,6 @@ inline void FButton::drawButtonTextLine (const FString& button_text)
 //----------------------------------------------------------------------
 void FButton::draw()
 {
-  FString button_text{};
   const auto& parent_widget = getParentWidget();
   column_width = getColumnWidth(text);
   space_char = int(' ');
@@ -0,0 +1,154 @@
+/***********************************************************************
+* fcharstyletable.cpp - Interned character styles for packed cells     *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstring>
+
+#include "final/fcharstyletable.h"
+
+namespace finalcut
+{
+
+static_assert ( sizeof(FCharCell) == sizeof(uInt64)
+              , "FCharCell does not fit into a 64-bit word" );
+
+//----------------------------------------------------------------------
+// class FCharStyleTable
+//----------------------------------------------------------------------
+
+// public methods of FCharStyleTable
+//----------------------------------------------------------------------
+bool FCharStyleTable::pack (const FChar& fchar, FCharCell& cell)
+{
+  // Converts fchar into a packed cell with an interned style.
+  // Returns false if the style table has no free index.
+
+  const uInt64 key = getStyleKey(fchar);
+  const auto iter = style_index.find(key);
+  uInt16 index{};
+
+  if ( iter != style_index.end() )
+  {
+    index = iter->second;
+  }
+  else
+  {
+    if ( isFull() )
+      return false;
+
+    index = uInt16(style_list.size());
+    style_list.push_back(key);
+    style_index[key] = index;
+  }
+
+  cell.ch = uInt32(fchar.ch);
+  cell.style = index;
+  cell.state = fchar.attr.byte[2];
+  return true;
+}
+
+//----------------------------------------------------------------------
+FChar FCharStyleTable::unpack (const FCharCell& cell) const
+{
+  // Converts a packed cell back into a FChar. The encoded
+  // character is determined later during the terminal output.
+
+  FChar fchar{};
+  fchar.ch = wchar_t(cell.ch);
+  fchar.encoded_char = fchar.ch;
+
+  if ( cell.style < style_list.size() )
+  {
+    const uInt64 key = style_list[cell.style];
+    fchar.fg_color = FColor(key & 0xffff);
+    fchar.bg_color = FColor((key >> 16) & 0xffff);
+    fchar.attr.byte[0] = uInt8((key >> 32) & 0xff);
+    fchar.attr.byte[1] = uInt8((key >> 40) & 0xff);
+  }
+
+  fchar.attr.byte[2] = cell.state;
+  return fchar;
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTable::clear()
+{
+  style_list.clear();
+  style_index.clear();
+}
+
+//----------------------------------------------------------------------
+std::size_t FCharStyleTable::getChangedCellPos ( const FCharCell* cell1
+                                               , const FCharCell* cell2
+                                               , std::size_t length )
+{
+  // Returns the position of the first cell that looks different
+  // on the terminal (or length, if none). Each cell is compared
+  // as one masked 64-bit word.
+
+  static const uInt64 mask = getCompareMask();
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    uInt64 word1{}, word2{};
+    std::memcpy (&word1, &cell1[i], sizeof(word1));
+    std::memcpy (&word2, &cell2[i], sizeof(word2));
+
+    if ( (word1 ^ word2) & mask )
+      return i;
+  }
+
+  return length;
+}
+
+
+// private methods of FCharStyleTable
+//----------------------------------------------------------------------
+uInt64 FCharStyleTable::getStyleKey (const FChar& fchar)
+{
+  // The style covers all FChar properties of the equality operator
+  // except for the character code (colors, attribute byte #0 and #1
+  // and the full-width padding bit)
+
+  FChar::attribute padding{};
+  padding.bit.fullwidth_padding = fchar.attr.bit.fullwidth_padding;
+
+  return uInt64(fchar.fg_color)
+       | uInt64(fchar.bg_color) << 16
+       | uInt64(fchar.attr.byte[0]) << 32
+       | uInt64(fchar.attr.byte[1]) << 40
+       | uInt64(padding.byte[2]) << 48;
+}
+
+//----------------------------------------------------------------------
+uInt64 FCharStyleTable::getCompareMask()
+{
+  // Bit mask of the character and style fields of a packed cell
+
+  FCharCell cell{};
+  cell.ch = ~uInt32(0);
+  cell.style = ~uInt16(0);
+  uInt64 mask{};
+  std::memcpy (&mask, &cell, sizeof(mask));
+  return mask;
+}
+
+}  // namespace finalcut
@@ -35,6 +35,10 @@ FEvent::FEvent (fc::events ev_type)  // constructor
   : t{ev_type}
 { }
 
+//----------------------------------------------------------------------
+FEvent::~FEvent()  // destructor
+{ }
+
 //----------------------------------------------------------------------
 fc::events FEvent::type() const
 { return t; }
@@ -0,0 +1,319 @@
+/***********************************************************************
+* feventqueue.cpp - Queue of events in preallocated slots              *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <iostream>
+#include <new>
+
+#include "final/feventqueue.h"
+#include "final/fobject.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr std::size_t FEventQueue::NO_SLOT;
+constexpr std::size_t FEventQueue::BLOCK_SIZE;
+
+
+//----------------------------------------------------------------------
+// class FEventQueue
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FEventQueue::FEventQueue()
+{ }
+
+//----------------------------------------------------------------------
+FEventQueue::~FEventQueue()  // destructor
+{
+  clear();
+
+  // Destroys the events that were popped but not released
+  for (std::size_t i{0}; i < getSlotCount(); i++)
+  {
+    auto& slot = getSlot(i);
+
+    if ( slot.event )
+      slot.event->~FEvent();
+  }
+}
+
+
+// public methods of FEventQueue
+//----------------------------------------------------------------------
+bool FEventQueue::push (const FObject* receiver, const FEvent* event)
+{
+  // Appends a copy of event to the queue
+
+  if ( ! receiver || ! event )
+    return false;
+
+  const auto index = getFreeSlot();
+
+  if ( index == NO_SLOT )
+    return false;
+
+  auto& slot = getSlot(index);
+  slot.event = copyEvent(&slot.storage, event);
+  slot.receiver = receiver;
+  slot.sequence = next_sequence++;
+  slot.next = NO_SLOT;
+
+  if ( last == NO_SLOT )
+    first = index;
+  else
+    getSlot(last).next = index;
+
+  last = index;
+  receiver->queued_events++;
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FEventQueue::pop (FEventItem& item)
+{
+  // Takes the oldest event out of the queue. The event stays valid
+  // until it is released, even if events are queued in the meantime.
+
+  item.receiver = nullptr;
+  item.event = nullptr;
+  item.slot = NO_SLOT;
+
+  while ( first != NO_SLOT )
+  {
+    const auto index = first;
+    auto& slot = getSlot(index);
+    first = slot.next;
+
+    if ( first == NO_SLOT )
+      last = NO_SLOT;
+
+    if ( isRemoved(slot) )
+    {
+      freeSlot (index);
+      continue;
+    }
+
+    if ( slot.receiver->queued_events > 0 )
+      slot.receiver->queued_events--;
+
+    item.receiver = slot.receiver;
+    item.event = slot.event;
+    item.slot = index;
+    break;
+  }
+
+  // The tombstones only apply to queued events
+  if ( first == NO_SLOT )
+    tombstones.clear();
+
+  return item.slot != NO_SLOT;
+}
+
+//----------------------------------------------------------------------
+void FEventQueue::release (FEventItem& item)
+{
+  // Destroys a popped event and reuses its slot
+
+  if ( item.slot == NO_SLOT )
+    return;
+
+  freeSlot (item.slot);
+  item.receiver = nullptr;
+  item.event = nullptr;
+  item.slot = NO_SLOT;
+}
+
+//----------------------------------------------------------------------
+bool FEventQueue::removeReceiver (const FObject* receiver)
+{
+  // Discards all queued events for the receiver without searching them
+
+  if ( ! receiver || receiver->queued_events == 0 )
+    return false;
+
+  receiver->queued_events = 0;
+
+  if ( isEmpty() )
+    return false;
+
+  FTombstone tombstone{};
+  tombstone.receiver = receiver;
+  tombstone.sequence = next_sequence;
+  tombstones.push_back(tombstone);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FEventQueue::clear()
+{
+  FEventItem item{};
+
+  while ( pop(item) )
+    release(item);
+}
+
+
+// private methods of FEventQueue
+//----------------------------------------------------------------------
+bool FEventQueue::isRemoved (const FSlot& slot) const
+{
+  for (auto&& tombstone : tombstones)
+  {
+    if ( tombstone.receiver == slot.receiver
+      && tombstone.sequence > slot.sequence )
+      return true;
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+std::size_t FEventQueue::getFreeSlot()
+{
+  if ( free_slot == NO_SLOT )
+  {
+    // Adds a new block of slots to the pool
+    const std::size_t begin = getSlotCount();
+
+    try
+    {
+      blocks.emplace_back(new FSlot[BLOCK_SIZE]);
+    }
+    catch (const std::bad_alloc& ex)
+    {
+      std::cerr << bad_alloc_str << ex.what() << std::endl;
+      return NO_SLOT;
+    }
+
+    for (std::size_t i{BLOCK_SIZE}; i > 0; i--)
+    {
+      getSlot(begin + i - 1).next = free_slot;
+      free_slot = begin + i - 1;
+    }
+  }
+
+  const auto index = free_slot;
+  free_slot = getSlot(index).next;
+  return index;
+}
+
+//----------------------------------------------------------------------
+void FEventQueue::freeSlot (std::size_t index)
+{
+  auto& slot = getSlot(index);
+
+  if ( slot.event )
+    slot.event->~FEvent();
+
+  slot.event = nullptr;
+  slot.receiver = nullptr;
+  slot.next = free_slot;
+  free_slot = index;
+}
+
+//----------------------------------------------------------------------
+FEvent* FEventQueue::copyEvent (void* storage, const FEvent* event)
+{
+  // Constructs a copy of the concrete event type in storage
+
+  switch ( event->type() )
+  {
+    case fc::KeyPress_Event:
+    case fc::KeyUp_Event:
+    case fc::KeyDown_Event:
+      return copyEventAs<FKeyEvent>(storage, event);
+
+    case fc::MouseDown_Event:
+    case fc::MouseUp_Event:
+    case fc::MouseDoubleClick_Event:
+    case fc::MouseMove_Event:
+      return copyEventAs<FMouseEvent>(storage, event);
+
+    case fc::MouseWheel_Event:
+      return copyEventAs<FWheelEvent>(storage, event);
+
+    case fc::FocusIn_Event:
+    case fc::FocusOut_Event:
+    case fc::ChildFocusIn_Event:
+    case fc::ChildFocusOut_Event:
+      return copyEventAs<FFocusEvent>(storage, event);
+
+    case fc::Accelerator_Event:
+      if ( auto ev = dynamic_cast<const FAccelEvent*>(event) )
+      {
+        // FAccelEvent cannot be copied
+        auto accel_ev = new (storage) FAccelEvent(ev->type(), ev->focusedWidget());
+
+        if ( ev->isAccepted() )
+          accel_ev->accept();
+
+        return accel_ev;
+      }
+      break;
+
+    case fc::Resize_Event:
+      return copyEventAs<FResizeEvent>(storage, event);
+
+    case fc::Show_Event:
+      return copyEventAs<FShowEvent>(storage, event);
+
+    case fc::Hide_Event:
+      return copyEventAs<FHideEvent>(storage, event);
+
+    case fc::Close_Event:
+      return copyEventAs<FCloseEvent>(storage, event);
+
+    case fc::Timer_Event:
+      return copyEventAs<FTimerEvent>(storage, event);
+
+    case fc::User_Event:
+      if ( auto ev = dynamic_cast<const FUserEvent*>(event) )
+      {
+        // FUserEvent cannot be copied
+        auto user_ev = new (storage) FUserEvent(ev->type(), ev->getUserId());
+        user_ev->setData(ev->getData());
+        return user_ev;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return new (storage) FEvent(*event);
+}
+
+//----------------------------------------------------------------------
+template <typename EventT>
+FEvent* FEventQueue::copyEventAs (void* storage, const FEvent* event)
+{
+  // A base class event with this type is copied as FEvent
+
+  if ( auto ev = dynamic_cast<const EventT*>(event) )
+    return new (storage) EventT(*ev);
+
+  return new (storage) FEvent(*event);
+}
+
+}  // namespace finalcut
@@ -31,6 +31,7 @@
 #include "final/fkeyboard.h"
 #include "final/fkey_map.h"
 #include "final/fobject.h"
+#include "final/fpoll.h"
 #include "final/fterm.h"
 #include "final/ftermios.h"
 
@@ -107,6 +108,27 @@ void FKeyboard::init()
 #endif
 }
 
+//----------------------------------------------------------------------
+uInt64 FKeyboard::getKeypressWaitTime()
+{
+  // Returns the time in microseconds until an incomplete
+  // key sequence in the fifo buffer times out
+
+  if ( ! fifo_in_use )
+    return FPoll::NO_TIMEOUT;
+
+  timeval now{};
+  FObject::getMonotonicTime (&now);
+  const timeval elapsed = now - time_keypressed;
+  const uInt64 elapsed_usec = uInt64(elapsed.tv_sec) * 1000000
+                            + uInt64(elapsed.tv_usec);
+
+  if ( elapsed_usec >= key_timeout )
+    return 0;
+
+  return key_timeout - elapsed_usec;
+}
+
 //----------------------------------------------------------------------
 bool& FKeyboard::unprocessedInput()
 {
@@ -347,7 +369,7 @@ bool FKeyboard::setNonBlockingInput (bool enable)
 //----------------------------------------------------------------------
 bool FKeyboard::isKeypressTimeout()
 {
-  return FObject::isTimeout (&time_keypressed, key_timeout);
+  return FObject::isMonotonicTimeout (&time_keypressed, key_timeout);
 }
 
 //----------------------------------------------------------------------
@@ -412,7 +434,7 @@ inline ssize_t FKeyboard::readKey()
 void FKeyboard::parseKeyBuffer()
 {
   ssize_t bytesread{};
-  FObject::getCurrentTime (&time_keypressed);
+  FObject::getMonotonicTime (&time_keypressed);
 
   while ( (bytesread = readKey()) > 0 )
   {
@@ -21,7 +21,6 @@
 ***********************************************************************/
 
 #include <memory>
-#include <utility>
 
 #include "final/fapplication.h"
 #include "final/fcolorpair.h"
@@ -356,7 +355,7 @@ void FLabel::drawMultiLine()
     else
       align_offset = getAlignOffset(length);
 
-    printLine (std::move(label_text));
+    printLine (label_text);
     y++;
   }
 }
@@ -364,7 +363,6 @@ void FLabel::drawMultiLine()
 //----------------------------------------------------------------------
 void FLabel::drawSingleLine()
 {
-  FString label_text{};
   column_width = getColumnWidth(text);
   hotkeypos = finalcut::getHotkeyPos (text, label_text);
 
@@ -373,18 +371,18 @@ void FLabel::drawSingleLine()
 
   print() << FPoint(1, 1);
   align_offset = getAlignOffset(column_width);
-  printLine (std::move(label_text));
+  printLine (label_text);
 }
 
 //----------------------------------------------------------------------
-void FLabel::printLine (FString&& line)
+void FLabel::printLine (FString& line)
 {
   std::size_t to_char{};
   std::size_t to_column{};
   const std::size_t width(getWidth());
 
   if ( align_offset > 0 )
-    print (FString(align_offset, ' '));  // leading spaces
+    printRepeated (this, L' ', align_offset);  // leading spaces
 
   if ( column_width <= width )
   {
@@ -444,7 +442,7 @@ void FLabel::printLine (FString&& line)
   {
     // Print trailing spaces
     const std::size_t len = width - align_offset - to_column;
-    print (FString(len, ' '));
+    printRepeated (this, L' ', len);
   }
 
   if ( hasReverseMode() )
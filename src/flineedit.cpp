@@ -789,8 +789,20 @@ inline std::size_t FLineEdit::printTextField()
 {
   const std::size_t text_offset_column = getColumnWidth (print_text, text_offset);
   const std::size_t start_column = text_offset_column - char_width_offset + 1;
+  const std::size_t field_width = getWidth() - 2;
+
+  if ( start_column == 1 && getColumnWidth(print_text) <= field_width )
+  {
+    // The whole text fits into the field (no substring copy required)
+    if ( ! print_text.isEmpty() )
+      print (print_text);
+
+    x_pos = getColumnWidth(print_text);
+    return text_offset_column;
+  }
+
   const FString& show_text = \
-      getColumnSubString(print_text, start_column, getWidth() - 2);
+      getColumnSubString(print_text, start_column, field_width);
 
   if ( ! show_text.isEmpty() )
     print (show_text);
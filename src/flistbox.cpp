@@ -196,6 +196,7 @@ void FListBox::insert (FListBoxItem listItem)
   recalculateHorizontalBar (column_width, has_brackets);
 
   itemlist.push_back (listItem);
+  last_yoffset = -1;  // The drawn rows are no longer valid
 
   if ( current == 0 )
     current = 1;
@@ -211,6 +212,7 @@ void FListBox::remove (std::size_t item)
     return;
 
   itemlist.erase (itemlist.begin() + int(item) - 1);
+  last_yoffset = -1;
   const std::size_t element_count = getCount();
   max_line_width = 0;
 
@@ -606,6 +608,7 @@ void FListBox::adjustSize()
   const std::size_t element_count = getCount();
   const std::size_t width = getClientWidth();
   const std::size_t height = getClientHeight();
+  last_yoffset = -1;
 
   adjustYOffset (element_count);
 
@@ -746,6 +749,7 @@ void FListBox::draw()
     setReverse(false);
 
   drawScrollbars();
+  last_yoffset = -1;  // Redraw all rows
   drawList();
 
   if ( getFlags().focus && getStatusBar() )
@@ -831,10 +835,48 @@ void FListBox::drawList()
     start = std::min(last_pos, current_pos);
     num = std::max(last_pos, current_pos) + 1;
   }
+  else if ( last_yoffset >= 0
+         && last_yoffset != yoffset
+         && num == getHeight() - 2
+         && std::abs(yoffset - last_yoffset) < int(num) )
+  {
+    // speed up: scroll the rows and redraw only the exposed rows
+    // and the rows of the current element before and after
+    const int dy = yoffset - last_yoffset;
+    const FRect box ( getTermX() + 1, getTermY() + 1
+                    , getWidth() - nf_offset - 2, num );
+    scrollArea (box, dy);
+
+    if ( dy > 0 )
+      drawListRows (num - std::size_t(dy), num);
+    else
+      drawListRows (0, std::size_t(-dy));
+
+    for (auto&& pos : { last_current - yoffset - 1
+                      , int(current) - yoffset - 1 })
+    {
+      if ( pos >= 0 && pos < int(num) )
+        drawListRows (std::size_t(pos), std::size_t(pos) + 1);
+    }
+
+    unsetAttributes();
+    last_yoffset = yoffset;
+    last_current = int(current);
+    return;
+  }
 
+  drawListRows (start, num);
+  unsetAttributes();
+  last_yoffset = yoffset;
+  last_current = int(current);
+}
+
+//----------------------------------------------------------------------
+void FListBox::drawListRows (std::size_t start, std::size_t end)
+{
   auto iter = index2iterator(start + std::size_t(yoffset));
 
-  for (std::size_t y = start; y < num && iter != itemlist.end() ; y++)
+  for (std::size_t y = start; y < end && iter != itemlist.end() ; y++)
   {
     bool serach_mark{false};
     const bool lineHasBrackets = hasBrackets(iter);
@@ -858,10 +900,6 @@ void FListBox::drawList()
 
     ++iter;
   }
-
-  unsetAttributes();
-  last_yoffset = yoffset;
-  last_current = int(current);
 }
 
 //----------------------------------------------------------------------
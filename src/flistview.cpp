@@ -50,6 +50,7 @@ bool sortAscendingByName (const FObject*, const FObject*);
 bool sortDescendingByName (const FObject*, const FObject*);
 bool sortAscendingByNumber (const FObject*, const FObject*);
 bool sortDescendingByNumber (const FObject*, const FObject*);
+void appendText (std::wstring&, const FString&);
 
 // non-member functions
 //----------------------------------------------------------------------
@@ -157,6 +158,13 @@ bool sortDescendingByNumber (const FObject* lhs, const FObject* rhs)
   return bool( l_number > r_number );
 }
 
+//----------------------------------------------------------------------
+inline void appendText (std::wstring& line, const FString& text)
+{
+  if ( ! text.isEmpty() )
+    line.append (text.wc_str(), text.getLength());
+}
+
 
 //----------------------------------------------------------------------
 // class FListViewItem
@@ -256,7 +264,9 @@ uInt FListViewItem::getDepth() const
 {
   const auto& parent = getParent();
 
-  if ( parent && parent->isInstanceOf("FListViewItem") )
+  // The parent is either the list view widget or
+  // another item (without a class name comparison)
+  if ( parent && ! parent->isWidget() )
   {
     const auto& parent_item = static_cast<FListViewItem*>(parent);
     return parent_item->getDepth() + 1;
@@ -956,6 +966,7 @@ void FListView::clear()
   last_visible_line = FListView::null_iter;
   recalculateVerticalBar (0);
   first_line_position_before = -1;
+  last_first_line_position = -1;
   xoffset = 0;
   vbar->setMinimum(0);
   vbar->setValue(0);
@@ -1674,6 +1685,19 @@ void FListView::drawList()
   const auto& itemlist_end = itemlist.end();
   auto path_end = itemlist_end;
   auto iter = first_visible_line;
+  const int dy = first_visible_line.getPosition() - last_first_line_position;
+
+  if ( last_first_line_position >= 0 && dy != 0
+    && std::abs(dy) < int(getClientHeight()) )
+  {
+    // Scroll the already drawn rows, so that the terminal
+    // update can move them with a scrolling region
+    const FRect box ( getTermX() + 1, getTermY() + 1
+                    , getClientWidth(), getClientHeight() );
+    scrollArea (box, dy);
+  }
+
+  last_first_line_position = first_visible_line.getPosition();
 
   while ( iter != path_end && iter != itemlist_end && y < page_height )
   {
@@ -1712,8 +1736,8 @@ void FListView::drawList()
   // Clean empty space after last element
   while ( y < uInt(getClientHeight()) )
   {
-    print() << FPoint(2, 2 + int(y))
-            << FString(std::size_t(getClientWidth()), ' ');
+    print() << FPoint(2, 2 + int(y));
+    printRepeated (this, L' ', std::size_t(getClientWidth()));
     y++;
   }
 }
@@ -1728,7 +1752,9 @@ void FListView::drawListLine ( const FListViewItem* item
 
   // Print the entry
   const std::size_t indent = item->getDepth() << 1;  // indent = 2 * depth
-  FString line(getLinePrefix (item, indent));
+  auto& line = line_buffer;  // Keeps its capacity between the lines
+  line.clear();
+  appendLinePrefix (line, item, indent);
 
   // Print columns
   if ( ! item->column_list.empty() )
@@ -1754,50 +1780,66 @@ void FListView::drawListLine ( const FListViewItem* item
       }
 
       // Insert alignment spaces
-      if ( align_offset > 0 )
-        line += FString(align_offset, L' ');
+      line.append (align_offset, L' ');
 
       if ( align_offset + column_width <= width )
       {
         // Insert text and trailing space
         static constexpr std::size_t leading_space = 1;
-        line += getColumnSubString (text, 1, width);
-        line += FString ( leading_space + width
-                        - align_offset - column_width, L' ');
+        appendText (line, text);
+        line.append ( leading_space + width
+                    - align_offset - column_width, L' ' );
       }
       else if ( align == fc::alignRight )
       {
         // Ellipse right align text
         const std::size_t first = getColumnWidth(text) + 1 - width;
-        line += FString (L"..");
-        line += getColumnSubString (text, first, width - ellipsis_length);
+        line += L"..";
+        const auto sub = getColumnSubString (text, first, width - ellipsis_length);
+        appendText (line, sub);
         line += L' ';
       }
       else
       {
         // Ellipse left align text and center text
-        line += getColumnSubString (text, 1, width - ellipsis_length);
-        line += FString (L".. ");
+        const auto sub = getColumnSubString (text, 1, width - ellipsis_length);
+        appendText (line, sub);
+        line += L".. ";
       }
     }
   }
 
   const std::size_t width = getWidth() - nf_offset - 2;
-  line = getColumnSubString ( line, std::size_t(xoffset) + 1, width );
-  const std::size_t len = line.getLength();
+
+  if ( xoffset > 0 )  // Horizontally scrolled
+  {
+    const FString text = getColumnSubString ( FString{line}
+                                            , std::size_t(xoffset) + 1
+                                            , width );
+    line.clear();
+    appendText (line, text);
+  }
+
   std::size_t char_width{0};
 
-  for (std::size_t i{0}; i < len; i++)
+  for (auto&& ch : line)
   {
-    try
-    {
-      char_width += getColumnWidth(line[i]);
-      print() << line[i];
-    }
-    catch (const std::out_of_range&)
+    const std::size_t ch_width = getColumnWidth(ch);
+
+    if ( char_width + ch_width > width )
     {
-      return;
+      // Cut the line like getColumnSubString() does
+      if ( char_width < width )
+      {
+        print() << wchar_t(fc::SingleRightAngleQuotationMark);  // ›
+        char_width++;
+      }
+
+      break;
     }
+
+    char_width += ch_width;
+    print() << ch;
   }
 
   for (std::size_t i = char_width; i < width; i++)
@@ -1893,15 +1935,13 @@ inline FString FListView::getCheckBox (const FListViewItem* item)
 }
 
 //----------------------------------------------------------------------
-inline FString FListView::getLinePrefix ( const FListViewItem* item
+inline void FListView::appendLinePrefix ( std::wstring& line
+                                        , const FListViewItem* item
                                         , std::size_t indent )
 {
-  FString line{};
-
   if ( tree_view )
   {
-    if ( indent > 0 )
-      line = FString(indent, L' ');
+    line.append (indent, L' ');
 
     if ( item->isExpandable()  )
     {
@@ -1920,12 +1960,10 @@ inline FString FListView::getLinePrefix ( const FListViewItem* item
       line += L"  ";
   }
   else
-    line.setString(" ");
+    line += L' ';
 
   if ( item->isCheckable() )
-    line += getCheckBox(item);
-
-  return line;
+    appendText (line, getCheckBox(item));
 }
 
 //----------------------------------------------------------------------
@@ -1946,7 +1984,7 @@ inline void FListView::drawSortIndicator ( std::size_t& length
   if ( length < column_max  )
   {
     length++;
-    headerline << ' ';
+    headerline << L' ';
   }
 }
 
@@ -1954,8 +1992,9 @@ inline void FListView::drawSortIndicator ( std::size_t& length
 inline void FListView::drawHeaderBorder (std::size_t length)
 {
   setColor();
-  const FString line (length, fc::BoxDrawingsHorizontal);
-  headerline << line;  // horizontal line
+
+  for (std::size_t i{0}; i < length; i++)
+    headerline << fc::BoxDrawingsHorizontal;  // horizontal line
 }
 
 
@@ -1965,9 +2004,8 @@ void FListView::drawHeadlineLabel (const headerItems::const_iterator& iter)
   // Print label text
   static constexpr std::size_t leading_space = 1;
   const auto& text = iter->name;
-  FString txt(" " + text);
   const std::size_t width = std::size_t(iter->width);
-  std::size_t column_width = getColumnWidth(txt);
+  std::size_t column_width = leading_space + getColumnWidth(text);
   const std::size_t column_max = leading_space + width;
   const headerItems::const_iterator first = header.begin();
   const int column = int(std::distance(first, iter)) + 1;
@@ -1982,27 +2020,27 @@ void FListView::drawHeadlineLabel (const headerItems::const_iterator& iter)
   if ( has_sort_indicator && column_width >= column_max - 1 && column_width > 1 )
   {
     column_width = column_max - 2;
-    txt = getColumnSubString (txt, 1, column_width);
+    headerline << getColumnSubString (" " + text, 1, column_width);
   }
-
-  if ( column_width <= column_max )
+  else if ( column_width <= column_max )
+    headerline << L' ' << text;  // Without a temporary string
+  else
   {
-    headerline << txt;
+    drawColumnEllipsis (iter, text);  // Print ellipsis
+    return;
+  }
 
-    if ( column_width < column_max )
-    {
-      column_width++;
-      headerline << ' ';  // trailing space
-    }
+  if ( column_width < column_max )
+  {
+    column_width++;
+    headerline << L' ';  // trailing space
+  }
 
-    if ( has_sort_indicator )
-      drawSortIndicator (column_width, column_max );
+  if ( has_sort_indicator )
+    drawSortIndicator (column_width, column_max );
 
-    if ( column_width < column_max )
-      drawHeaderBorder (column_max - column_width);
-  }
-  else
-    drawColumnEllipsis (iter, text);  // Print ellipsis
+  if ( column_width < column_max )
+    drawHeaderBorder (column_max - column_width);
 }
 
 //----------------------------------------------------------------------
@@ -2051,9 +2089,9 @@ void FListView::drawBufferedHeadline()
     if ( left_truncated_fullwidth )
       column_width++;
 
-    for (auto&& tc : FTermBuffer(first, last))
+    for (auto iter = first; iter != last; ++iter)
     {
-      const uInt8 char_width = tc.attr.bit.char_width;
+      const uInt8 char_width = iter->attr.bit.char_width;
 
       if ( column_width + char_width > getClientWidth() )
       {
@@ -2081,7 +2119,11 @@ void FListView::drawBufferedHeadline()
   if ( left_truncated_fullwidth )
     print (fc::SingleLeftAngleQuotationMark);  // ‹
 
-  print() << FTermBuffer(first, last);
+  for (auto iter = first; iter != last; ++iter)
+  {
+    auto fchar = *iter;
+    print (fchar);
+  }
 
   if ( right_truncated_fullwidth )
     print (fc::SingleRightAngleQuotationMark);  // ›
@@ -1380,7 +1380,7 @@ inline void FMenu::drawSubMenuIndicator (std::size_t& startpos)
   if ( len > 0 )
   {
     // Print filling blank spaces
-    print (FString(len, L' '));
+    printRepeated (this, L' ', len);
     // Print BlackRightPointingPointer ►
     print (fc::BlackRightPointingPointer);
     startpos = max_item_width - (c + 2);
@@ -290,7 +290,7 @@ void FMouse::setEvent()
 //----------------------------------------------------------------------
 bool FMouse::isDblclickTimeout (timeval* time)
 {
-  return FObject::isTimeout (time, dblclick_interval);
+  return FObject::isMonotonicTimeout (time, dblclick_interval);
 }
 
 
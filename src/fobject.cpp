@@ -20,6 +20,10 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <time.h>
+
+#include <algorithm>
+#include <functional>
 #include <memory>
 
 #include "final/emptyfstring.h"
@@ -33,6 +37,9 @@ namespace finalcut
 // static class attributes
 bool FObject::timer_modify_lock;
 FObject::FTimerList* FObject::timer_list{nullptr};
+std::vector<std::size_t> FObject::timer_position{};
+std::vector<int> FObject::free_timer_ids{};
+constexpr std::size_t FObject::NOT_SCHEDULED;
 const FString* fc::emptyFString::empty_string{nullptr};
 
 
@@ -78,6 +85,8 @@ FObject::~FObject()  // destructor
   {
     delete timer_list;
     timer_list = nullptr;
+    timer_position.clear();
+    free_timer_ids.clear();
   }
 
   if ( ! has_parent && ! fc::emptyFString::isNull() )
@@ -237,15 +246,52 @@ void FObject::getCurrentTime (timeval* time)
   }
 }
 
+//----------------------------------------------------------------------
+void FObject::getMonotonicTime (timeval* time)
+{
+  // Get the time of the monotonic clock as timeval struct
+  // (not affected by system clock changes, only for time spans)
+
+#if defined(CLOCK_MONOTONIC)
+  timespec now{};
+
+  if ( clock_gettime(CLOCK_MONOTONIC, &now) == 0 )
+  {
+    time->tv_sec  = now.tv_sec;
+    time->tv_usec = suseconds_t(now.tv_nsec / 1000);
+    return;
+  }
+#endif
+
+  getCurrentTime (time);
+}
+
 //----------------------------------------------------------------------
 bool FObject::isTimeout (timeval* time, uInt64 timeout)
 {
   // Checks whether the specified time span (timeout in µs) has elapse
 
   struct timeval now{};
-  struct timeval diff{};
-
   FObject::getCurrentTime(&now);
+  return isElapsed (now, time, timeout);
+}
+
+//----------------------------------------------------------------------
+bool FObject::isMonotonicTimeout (timeval* time, uInt64 timeout)
+{
+  // Checks whether the specified time span (timeout in µs)
+  // has elapse since a time from getMonotonicTime()
+
+  struct timeval now{};
+  FObject::getMonotonicTime(&now);
+  return isElapsed (now, time, timeout);
+}
+
+//----------------------------------------------------------------------
+bool FObject::isElapsed ( const timeval& now, const timeval* time
+                        , uInt64 timeout )
+{
+  struct timeval diff{};
   diff.tv_sec = now.tv_sec - time->tv_sec;
   diff.tv_usec = now.tv_usec - time->tv_usec;
 
@@ -259,52 +305,39 @@ bool FObject::isTimeout (timeval* time, uInt64 timeout)
   return ( diff_usec > timeout );
 }
 
+//----------------------------------------------------------------------
+bool FObject::getNextTimerTimeout (timeval* time)
+{
+  // Gets the time when the next timer expires
+
+  if ( timer_modify_lock || ! timer_list || timer_list->empty() )
+    return false;
+
+  *time = timer_list->front().timeout;
+  return true;
+}
+
 //----------------------------------------------------------------------
 int FObject::addTimer (int interval)
 {
   // Create a timer and returns the timer identifier number
   // (interval in ms)
 
+  if ( ! timer_list )
+    return 0;
+
   timeval time_interval{};
   timeval currentTime{};
-  int id{1};
   timer_modify_lock = true;
-
-  // find an unused timer id
-  if ( ! timer_list->empty() )
-  {
-    auto iter = timer_list->begin();
-    const auto& last = timer_list->end();
-
-    while ( iter != last )
-    {
-      if ( iter->id == id )
-      {
-        iter = timer_list->begin();
-        id++;
-        continue;
-      }
-      ++iter;
-    }
-  }
-
-  if ( id <= 0 || id > int(timer_list->size() + 1) )
-    return 0;
-
+  const int id = getFreeTimerId();
   time_interval.tv_sec  =  interval / 1000;
   time_interval.tv_usec = (interval % 1000) * 1000;
-  getCurrentTime (&currentTime);
-  timeval timeout = currentTime + time_interval;
-  FTimerData t{ id, time_interval, timeout, this };
-
-  // insert in list sorted by timeout
-  auto iter = timer_list->begin();
-  const auto& last = timer_list->end();
-
-  while ( iter != last && iter->timeout < t.timeout )
-    ++iter;
-
-  timer_list->insert (iter, t);
+  getMonotonicTime (&currentTime);
+  const timeval timeout = currentTime + time_interval;
+  timer_list->push_back({ id, time_interval, timeout, this });
+  const std::size_t pos = timer_list->size() - 1;
+  timer_position[std::size_t(id)] = pos;
+  siftUpTimer (pos);
   timer_modify_lock = false;
   return id;
 }
@@ -314,25 +347,16 @@ bool FObject::delTimer (int id)
 {
   // Deletes a timer by using the timer identifier number
 
-  if ( id <= 0 )
+  if ( id <= 0
+    || ! timer_list
+    || std::size_t(id) >= timer_position.size()
+    || timer_position[std::size_t(id)] == NOT_SCHEDULED )
     return false;
 
   timer_modify_lock = true;
-  auto iter = timer_list->begin();
-  const auto& last = timer_list->end();
-
-  while ( iter != last && iter->id != id )
-    ++iter;
-
-  if ( iter != last )
-  {
-    timer_list->erase(iter);
-    timer_modify_lock = false;
-    return true;
-  }
-
+  removeTimer (timer_position[std::size_t(id)]);
   timer_modify_lock = false;
-  return false;
+  return true;
 }
 
 //----------------------------------------------------------------------
@@ -347,15 +371,25 @@ bool FObject::delOwnTimer()
     return false;
 
   timer_modify_lock = true;
-  auto iter = timer_list->begin();
 
-  while ( iter != timer_list->end() )
-  {
-    if ( iter->object == this )
-      iter = timer_list->erase(iter);
-    else
-      ++iter;
-  }
+  for (auto&& timer : *timer_list)
+    if ( timer.object == this )
+      releaseTimerId (timer.id);
+
+  timer_list->erase ( std::remove_if ( timer_list->begin()
+                                     , timer_list->end()
+                                     , [this] (const FTimerData& timer)
+                                       {
+                                         return timer.object == this;
+                                       } )
+                    , timer_list->end() );
+
+  // Rebuilds the heap
+  for (std::size_t pos{0}; pos < timer_list->size(); pos++)
+    timer_position[std::size_t((*timer_list)[pos].id)] = pos;
+
+  for (std::size_t pos = timer_list->size() / 2; pos > 0; pos--)
+    siftDownTimer (pos - 1);
 
   timer_modify_lock = false;
   return true;
@@ -375,6 +409,8 @@ bool FObject::delAllTimer()
   timer_modify_lock = true;
   timer_list->clear();
   timer_list->shrink_to_fit();
+  timer_position.clear();
+  free_timer_ids.clear();
   timer_modify_lock = false;
   return true;
 }
@@ -395,7 +431,7 @@ uInt FObject::processTimerEvent()
   timeval currentTime{};
   uInt activated{0};
 
-  getCurrentTime (&currentTime);
+  getMonotonicTime (&currentTime);
 
   if ( isTimerInUpdating() )
     return 0;
@@ -403,33 +439,144 @@ uInt FObject::processTimerEvent()
   if ( ! timer_list )
     return 0;
 
-  if ( timer_list->empty() )
-    return 0;
-
-  for (auto&& timer : *timer_list)
+  while ( ! timer_list->empty() )
   {
-    if ( ! timer.id
-      || ! timer.object
-      || currentTime < timer.timeout )  // no timer expired
+    auto& timer = timer_list->front();
+
+    if ( currentTime < timer.timeout )  // no timer expired
       break;
 
+    // The new timeout lies after the current time,
+    // so that each timer expires only once per call
     timer.timeout += timer.interval;
 
-    if ( timer.timeout < currentTime )
+    if ( ! (currentTime < timer.timeout) )
+    {
       timer.timeout = currentTime + timer.interval;
 
+      if ( ! (currentTime < timer.timeout) )  // Zero interval
+        timer.timeout = currentTime + timeval{0, 1};
+    }
+
     if ( timer.interval.tv_usec > 0 || timer.interval.tv_sec > 0 )
       activated++;
 
-    FTimerEvent t_ev(fc::Timer_Event, timer.id);
-    performTimerAction (timer.object, &t_ev);
+    // The timer action can add or delete timers
+    const int id = timer.id;
+    FObject* object = timer.object;
+    siftDownTimer (0);
+    FTimerEvent t_ev(fc::Timer_Event, id);
+    performTimerAction (object, &t_ev);
   }
 
   return activated;
 }
 
+
+// private methods of FObject
 //----------------------------------------------------------------------
 void FObject::performTimerAction (const FObject*, const FEvent*)
 { }
 
+//----------------------------------------------------------------------
+int FObject::getFreeTimerId()
+{
+  // Reuses the lowest released id or creates a new one
+
+  if ( ! free_timer_ids.empty() )
+  {
+    std::pop_heap ( free_timer_ids.begin()
+                  , free_timer_ids.end()
+                  , std::greater<int>() );
+    const int id = free_timer_ids.back();
+    free_timer_ids.pop_back();
+    return id;
+  }
+
+  if ( timer_position.empty() )
+    timer_position.push_back(NOT_SCHEDULED);  // 0 is not a valid id
+
+  timer_position.push_back(NOT_SCHEDULED);
+  return int(timer_position.size() - 1);
+}
+
+//----------------------------------------------------------------------
+void FObject::releaseTimerId (int id)
+{
+  timer_position[std::size_t(id)] = NOT_SCHEDULED;
+  free_timer_ids.push_back(id);
+  std::push_heap ( free_timer_ids.begin()
+                 , free_timer_ids.end()
+                 , std::greater<int>() );
+}
+
+//----------------------------------------------------------------------
+void FObject::swapTimer (std::size_t pos1, std::size_t pos2)
+{
+  auto& timer1 = (*timer_list)[pos1];
+  auto& timer2 = (*timer_list)[pos2];
+  std::swap (timer1, timer2);
+  timer_position[std::size_t(timer1.id)] = pos1;
+  timer_position[std::size_t(timer2.id)] = pos2;
+}
+
+//----------------------------------------------------------------------
+void FObject::siftUpTimer (std::size_t pos)
+{
+  // Moves an earlier timeout towards the top of the heap
+
+  while ( pos > 0 )
+  {
+    const std::size_t parent = (pos - 1) / 2;
+
+    if ( ! ((*timer_list)[pos].timeout < (*timer_list)[parent].timeout) )
+      break;
+
+    swapTimer (pos, parent);
+    pos = parent;
+  }
+}
+
+//----------------------------------------------------------------------
+void FObject::siftDownTimer (std::size_t pos)
+{
+  // Moves a later timeout towards the bottom of the heap
+
+  const std::size_t size = timer_list->size();
+
+  while ( 2 * pos + 1 < size )
+  {
+    std::size_t child = 2 * pos + 1;
+
+    if ( child + 1 < size
+      && (*timer_list)[child + 1].timeout < (*timer_list)[child].timeout )
+      child++;
+
+    if ( ! ((*timer_list)[child].timeout < (*timer_list)[pos].timeout) )
+      break;
+
+    swapTimer (pos, child);
+    pos = child;
+  }
+}
+
+//----------------------------------------------------------------------
+void FObject::removeTimer (std::size_t pos)
+{
+  const int id = (*timer_list)[pos].id;
+  const std::size_t last = timer_list->size() - 1;
+
+  if ( pos != last )
+    swapTimer (pos, last);
+
+  timer_list->pop_back();
+  releaseTimerId (id);
+
+  if ( pos < timer_list->size() )
+  {
+    siftUpTimer (pos);
+    siftDownTimer (pos);
+  }
+}
+
 }  // namespace finalcut
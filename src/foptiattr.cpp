@@ -20,6 +20,9 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 #include "final/fc.h"
@@ -387,6 +390,7 @@ void FOptiAttr::set_a_foreground_color (char cap[])
   {
     F_set_a_foreground.cap = cap;
     F_set_a_foreground.caused_reset = false;
+    clearColorTable();
   }
 }
 
@@ -397,6 +401,7 @@ void FOptiAttr::set_a_background_color (char cap[])
   {
     F_set_a_background.cap = cap;
     F_set_a_background.caused_reset = false;
+    clearColorTable();
   }
 }
 
@@ -407,6 +412,7 @@ void FOptiAttr::set_foreground_color (char cap[])
   {
     F_set_foreground.cap = cap;
     F_set_foreground.caused_reset = false;
+    clearColorTable();
   }
 }
 
@@ -417,6 +423,7 @@ void FOptiAttr::set_background_color (char cap[])
   {
     F_set_background.cap = cap;
     F_set_background.caused_reset = false;
+    clearColorTable();
   }
 }
 
@@ -427,6 +434,7 @@ void FOptiAttr::set_term_color_pair (char cap[])
   {
     F_set_color_pair.cap = cap;
     F_set_color_pair.caused_reset = false;
+    clearColorTable();
   }
 }
 
@@ -456,6 +464,15 @@ bool FOptiAttr::isNormal (const FChar* const& ch)
   return hasNoAttribute(ch) && ! hasColor(ch);
 }
 
+//----------------------------------------------------------------------
+bool FOptiAttr::isDirectSGR() const
+{
+  // Returns true if attribute changes are encoded directly
+  // into one SGR sequence instead of using the termcap path
+
+  return direct_sgr && FStartOptions::getFStartOptions().sgr_optimizer;
+}
+
 //----------------------------------------------------------------------
 void FOptiAttr::initialize()
 {
@@ -501,6 +518,10 @@ void FOptiAttr::initialize()
 
   if ( hasCharsetEquivalence() )
     alt_equal_pc_charset = true;
+
+  initColorTable();
+  initDirectSGR();
+  clearCache();
 }
 
 //----------------------------------------------------------------------
@@ -545,13 +566,58 @@ FColor FOptiAttr::vga2ansi (FColor color)
 //----------------------------------------------------------------------
 char* FOptiAttr::changeAttribute (FChar*& term, FChar*& next)
 {
-  const bool next_has_color = hasColor(next);
   fake_reverse = false;
   attr_buf[0] = '\0';
 
   if ( ! (term && next) )
     return attr_buf;
 
+  // The result only depends on the colors and attributes of term
+  // and next. Recurring transitions are taken from the cache.
+  const bool sgr_optimize = FStartOptions::getFStartOptions().sgr_optimizer;
+  const uInt64 term_key = getAttributeKey(term);
+  const uInt64 next_key = getAttributeKey(next) | uInt64(sgr_optimize) << 48;
+  auto& entry = attr_cache[getCacheIndex(term_key, next_key)];
+
+  if ( entry.valid
+    && entry.term_key == term_key
+    && entry.next_key == next_key )
+  {
+    cache_hits++;
+    setAttributeKey (term, entry.term_state);
+    setAttributeKey (next, entry.next_state);
+
+    // Simulate invisible characters
+    if ( ! F_enter_secure_mode.cap && next->attr.bit.invisible )
+      next->encoded_char = ' ';
+
+    return ( entry.no_changes ) ? nullptr : entry.sequence;
+  }
+
+  cache_misses++;
+  entry.term_key = term_key;
+  entry.next_key = next_key;
+  char* sequence = createAttributeSequence(term, next);
+  storeCacheEntry (entry, term, next, sequence);
+  return sequence;
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::clearCache()
+{
+  // Has to be called after changing the terminal capabilities
+  // or the color mode
+
+  for (auto&& entry : attr_cache)
+    entry.valid = false;
+}
+
+
+// private methods of FOptiAttr
+//----------------------------------------------------------------------
+char* FOptiAttr::createAttributeSequence (FChar*& term, FChar*& next)
+{
+  const bool next_has_color = hasColor(next);
   prevent_no_color_video_attributes (term, next_has_color);
   prevent_no_color_video_attributes (next);
   detectSwitchOn (term, next);
@@ -565,6 +631,12 @@ char* FOptiAttr::changeAttribute (FChar*& term, FChar*& next)
   if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
     return nullptr;
 
+  if ( canUseDirectSGR(term, next) )
+  {
+    changeAttributeDirectSGR (term, next);
+    return attr_buf;  // Needs no SGR optimization
+  }
+
   if ( hasNoAttribute(next) )
   {
     deactivateAttributes (term, next);
@@ -585,8 +657,59 @@ char* FOptiAttr::changeAttribute (FChar*& term, FChar*& next)
   return attr_buf;
 }
 
+//----------------------------------------------------------------------
+inline uInt64 FOptiAttr::getAttributeKey (const FChar* const& ch)
+{
+  return uInt64(ch->fg_color)
+       | uInt64(ch->bg_color) << 16
+       | uInt64(ch->attr.byte[0]) << 32
+       | uInt64(ch->attr.byte[1]) << 40;
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::setAttributeKey (FChar*& ch, uInt64 key)
+{
+  ch->fg_color = FColor(key & 0xffff);
+  ch->bg_color = FColor((key >> 16) & 0xffff);
+  ch->attr.byte[0] = uInt8((key >> 32) & 0xff);
+  ch->attr.byte[1] = uInt8((key >> 40) & 0xff);
+}
+
+//----------------------------------------------------------------------
+inline std::size_t FOptiAttr::getCacheIndex (uInt64 term_key, uInt64 next_key)
+{
+  // Multiplicative hashing of both keys
+  const uInt64 hash = ( term_key * 0x9e3779b97f4a7c15ULL )
+                    ^ ( next_key * 0xc2b2ae3d27d4eb4fULL );
+  return std::size_t(hash >> 32) & (ATTR_CACHE_SIZE - 1);
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::storeCacheEntry ( attrCacheEntry& entry
+                                , const FChar* const& term
+                                , const FChar* const& next
+                                , const char sequence[] )
+{
+  // Long sequences are not cached
+
+  entry.valid = false;
+
+  if ( sequence )
+  {
+    const std::size_t length = std::strlen(sequence);
+
+    if ( length >= CACHED_SEQUENCE_SIZE )
+      return;
+
+    std::memcpy (entry.sequence, sequence, length + 1);
+  }
+
+  entry.term_state = getAttributeKey(term);
+  entry.next_state = getAttributeKey(next);
+  entry.no_changes = ! sequence;
+  entry.valid = true;
+}
 
-// private methods of FOptiAttr
 //----------------------------------------------------------------------
 inline bool FOptiAttr::setTermBold (FChar*& term)
 {
@@ -1499,33 +1622,413 @@ inline void FOptiAttr::change_current_color ( const FChar* const& term
     const auto ansi_bg = vga2ansi(bg);
 
     if ( (term->fg_color != fg || frev)
-      && (color_str = tparm(AF, ansi_fg, 0, 0, 0, 0, 0, 0, 0, 0)) )
+      && (color_str = getForegroundSequence(AF, fg, ansi_fg)) )
       append_sequence (color_str);
 
     if ( (term->bg_color != bg || frev)
-      && (color_str = tparm(AB, ansi_bg, 0, 0, 0, 0, 0, 0, 0, 0)) )
+      && (color_str = getBackgroundSequence(AB, bg, ansi_bg)) )
       append_sequence (color_str);
   }
   else if ( Sf && Sb )
   {
     if ( (term->fg_color != fg || frev)
-      && (color_str = tparm(Sf, fg, 0, 0, 0, 0, 0, 0, 0, 0)) )
+      && (color_str = getForegroundSequence(Sf, fg, fg)) )
       append_sequence (color_str);
 
     if ( (term->bg_color != bg || frev)
-      && (color_str = tparm(Sb, bg, 0, 0, 0, 0, 0, 0, 0, 0)) )
+      && (color_str = getBackgroundSequence(Sb, bg, bg)) )
       append_sequence (color_str);
   }
   else if ( sp )
   {
-    fg = vga2ansi(fg);
-    bg = vga2ansi(bg);
-
-    if ( (color_str = tparm(sp, fg, bg, 0, 0, 0, 0, 0, 0, 0)) )
+    if ( (color_str = getColorPairSequence(sp, fg, bg)) )
       append_sequence (color_str);
   }
 }
 
+//----------------------------------------------------------------------
+void FOptiAttr::initColorTable()
+{
+  // Precomputes the color sequences of all color indices, so that
+  // tparm() does not have to interpret the capability on every
+  // color change. Color pairs are only stored for up to 16 colors.
+
+  clearColorTable();
+
+  if ( monochron || max_color < 1 )
+    return;
+
+  const auto& AF = F_set_a_foreground.cap;
+  const auto& AB = F_set_a_background.cap;
+  const auto& Sf = F_set_foreground.cap;
+  const auto& Sb = F_set_background.cap;
+  const auto& sp = F_set_color_pair.cap;
+  const auto size = std::min ( std::size_t(max_color)
+                             , std::size_t(COLOR_TABLE_SIZE) );
+
+  if ( (AF && AB) || (Sf && Sb) )
+  {
+    const bool ansi = AF && AB;
+    char* fg_cap = ( ansi ) ? AF : Sf;
+    char* bg_cap = ( ansi ) ? AB : Sb;
+
+    for (std::size_t color{0}; color < size; color++)
+    {
+      const int param = ( ansi ) ? vga2ansi(FColor(color)) : int(color);
+
+      if ( ! setColorSequence(color_table[color].fg, fg_cap, param)
+        || ! setColorSequence(color_table[color].bg, bg_cap, param) )
+        return;  // Sequence too long for the table
+    }
+
+    color_table_size = size;
+  }
+  else if ( sp && size <= COLOR_PAIR_TABLE_SIZE )
+  {
+    for (std::size_t fg{0}; fg < size; fg++)
+    {
+      for (std::size_t bg{0}; bg < size; bg++)
+      {
+        if ( ! setColorSequence ( color_pair_table[fg][bg], sp
+                                , vga2ansi(FColor(fg))
+                                , vga2ansi(FColor(bg)) ) )
+          return;  // Sequence too long for the table
+      }
+    }
+
+    color_pair_table_size = size;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::clearColorTable()
+{
+  color_table_size = 0;
+  color_pair_table_size = 0;
+}
+
+//----------------------------------------------------------------------
+bool FOptiAttr::setColorSequence ( colorsequence& sequence
+                                 , char cap[], int p1, int p2 )
+{
+  const char* str = tparm(cap, p1, p2, 0, 0, 0, 0, 0, 0, 0);
+  sequence[0] = '\0';
+
+  if ( ! str )
+    return true;
+
+  if ( std::strlen(str) >= sizeof(sequence) )
+    return false;
+
+  std::strcpy (sequence, str);
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline char* FOptiAttr::getForegroundSequence ( char cap[]
+                                              , FColor color, int param )
+{
+  if ( color < color_table_size )
+    return color_table[color].fg;
+
+  return tparm(cap, param, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+//----------------------------------------------------------------------
+inline char* FOptiAttr::getBackgroundSequence ( char cap[]
+                                              , FColor color, int param )
+{
+  if ( color < color_table_size )
+    return color_table[color].bg;
+
+  return tparm(cap, param, 0, 0, 0, 0, 0, 0, 0, 0);
+}
+
+//----------------------------------------------------------------------
+inline char* FOptiAttr::getColorPairSequence ( char cap[]
+                                             , FColor fg, FColor bg )
+{
+  if ( fg < color_pair_table_size && bg < color_pair_table_size )
+    return color_pair_table[fg][bg];
+
+  return tparm(cap, vga2ansi(fg), vga2ansi(bg), 0, 0, 0, 0, 0, 0, 0);
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::initDirectSGR()
+{
+  // Tests whether all attribute and color capabilities are plain
+  // ECMA-48 SGR sequences, which can be combined into one sequence
+
+  direct_sgr = false;
+  const capability* enter_cap[SGR_ATTRIBUTES] =
+  {
+    &F_enter_bold_mode, &F_enter_dim_mode, &F_enter_italics_mode,
+    &F_enter_underline_mode, &F_enter_blink_mode, &F_enter_reverse_mode,
+    &F_enter_standout_mode, &F_enter_secure_mode,
+    &F_enter_crossed_out_mode, &F_enter_dbl_underline_mode
+  };
+  const capability* exit_cap[SGR_ATTRIBUTES] =
+  {
+    &F_exit_bold_mode, &F_exit_dim_mode, &F_exit_italics_mode,
+    &F_exit_underline_mode, &F_exit_blink_mode, &F_exit_reverse_mode,
+    &F_exit_standout_mode, &F_exit_secure_mode,
+    &F_exit_crossed_out_mode, &F_exit_dbl_underline_mode
+  };
+  const auto& me = F_exit_attribute_mode.cap;
+
+  if ( ! ansi_default_color || color_table_size == 0 )
+    return;
+
+  // The reset sequence must contain a SGR 0, and the alternate
+  // character set must not be switched by SGR parameters
+  if ( ! me || ! (std::strstr(me, CSI "m") || std::strstr(me, CSI "0m"))
+    || isSGRSequence(F_enter_alt_charset_mode.cap)
+    || isSGRSequence(F_exit_alt_charset_mode.cap) )
+    return;
+
+  for (std::size_t color{0}; color < color_table_size; color++)
+  {
+    if ( ! isSGRSequence(color_table[color].fg)
+      || ! isSGRSequence(color_table[color].bg) )
+      return;
+  }
+
+  for (std::size_t n{0}; n < SGR_ATTRIBUTES; n++)
+  {
+    sgr_attribute[n] = { 0, 0 };
+
+    if ( ! enter_cap[n]->cap )
+      continue;  // Attribute not supported
+
+    const int enter = getSGRParameter(enter_cap[n]->cap);
+
+    if ( enter <= 0 )
+      return;
+
+    sgr_attribute[n].enter = enter;
+    sgr_attribute[n].exit = std::max(getSGRParameter(exit_cap[n]->cap), 0);
+  }
+
+  direct_sgr = true;
+}
+
+//----------------------------------------------------------------------
+bool FOptiAttr::isSGRSequence (const char seq[])
+{
+  // Tests for "CSI Ps ; ... ; Ps m"
+
+  if ( ! seq || std::strncmp(seq, CSI, 2) != 0 )
+    return false;
+
+  const std::size_t len = std::strlen(seq);
+
+  if ( len < 3 || seq[len - 1] != 'm' )
+    return false;
+
+  for (std::size_t i{2}; i < len - 1; i++)
+    if ( ! (std::isdigit(uChar(seq[i])) || seq[i] == ';') )
+      return false;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+int FOptiAttr::getSGRParameter (const char seq[])
+{
+  // Returns the parameter of a "CSI Ps m" sequence
+  // (-1 if the sequence has another format)
+
+  if ( ! isSGRSequence(seq) || std::strchr(seq, ';') )
+    return -1;
+
+  return std::atoi(seq + 2);
+}
+
+//----------------------------------------------------------------------
+inline uInt16 FOptiAttr::getSGRAttributes (const FChar* const& ch)
+{
+  // Attribute byte #0 and the crossed out and double underline
+  // bits in the order of the sgr_attribute array
+
+  return uInt16(ch->attr.byte[0])
+       | uInt16(ch->attr.bit.crossed_out) << 8
+       | uInt16(ch->attr.bit.dbl_underline) << 9;
+}
+
+//----------------------------------------------------------------------
+inline bool FOptiAttr::canUseDirectSGR ( const FChar* const& term
+                                       , const FChar* const& next ) const
+{
+  if ( ! isDirectSGR() || fake_reverse
+    || term->attr.bit.pc_charset || next->attr.bit.pc_charset
+    || term->attr.bit.protect || next->attr.bit.protect )
+    return false;
+
+  // The colors must be in the color table
+  for (auto&& color : { next->fg_color, next->bg_color })
+  {
+    if ( color != fc::Default
+      && std::size_t(color % max_color) >= color_table_size )
+      return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::changeAttributeDirectSGR (FChar*& term, FChar*& next)
+{
+  // Creates one SGR sequence from the attribute and color difference.
+  // The changes are either set incrementally or after a reset
+  // with "0", depending on which sequence is shorter.
+
+  char changes[SGR_PARAMETER_SIZE]{};
+  char after_reset[SGR_PARAMETER_SIZE]{"0"};
+  uInt16 supported{0};
+  uInt16 off_mask{0};  // Attributes switched off by an exit parameter
+  bool reset_required{false};
+
+  if ( next->fg_color != fc::Default )
+    next->fg_color %= max_color;
+
+  if ( next->bg_color != fc::Default )
+    next->bg_color %= max_color;
+
+  for (std::size_t n{0}; n < SGR_ATTRIBUTES; n++)
+    if ( sgr_attribute[n].enter )
+      supported |= uInt16(1 << n);
+
+  const uInt16 term_attr = getSGRAttributes(term) & supported;
+  const uInt16 next_attr = getSGRAttributes(next) & supported;
+
+  for (std::size_t n{0}; n < SGR_ATTRIBUTES; n++)
+  {
+    const auto bit = uInt16(1 << n);
+
+    if ( ! (term_attr & bit) || (next_attr & bit) || (off_mask & bit) )
+      continue;
+
+    const int exit = sgr_attribute[n].exit;
+
+    if ( ! exit )
+    {
+      reset_required = true;
+      break;
+    }
+
+    // An exit parameter can switch off several attributes (e.g. 22)
+    for (std::size_t m{0}; m < SGR_ATTRIBUTES; m++)
+      if ( sgr_attribute[m].exit == exit )
+        off_mask |= uInt16(1 << m);
+
+    addSGRParameter (changes, exit);
+  }
+
+  const uInt16 active = term_attr & ~off_mask;
+
+  for (std::size_t n{0}; n < SGR_ATTRIBUTES; n++)
+  {
+    const auto bit = uInt16(1 << n);
+
+    if ( ! (next_attr & bit) )
+      continue;
+
+    // Avoid duplicate parameters (e.g. reverse and standout)
+    bool duplicate{false};
+
+    for (std::size_t m{0}; m < n; m++)
+      if ( (next_attr & (1 << m))
+        && sgr_attribute[m].enter == sgr_attribute[n].enter )
+        duplicate = true;
+
+    if ( duplicate )
+      continue;
+
+    if ( ! (active & bit) )
+      addSGRParameter (changes, sgr_attribute[n].enter);
+
+    addSGRParameter (after_reset, sgr_attribute[n].enter);
+  }
+
+  if ( term->fg_color != next->fg_color )
+    addSGRColor (changes, next->fg_color, true);
+
+  if ( term->bg_color != next->bg_color )
+    addSGRColor (changes, next->bg_color, false);
+
+  if ( next->fg_color != fc::Default )
+    addSGRColor (after_reset, next->fg_color, true);
+
+  if ( next->bg_color != fc::Default )
+    addSGRColor (after_reset, next->bg_color, false);
+
+  // The alternate character set is switched separately
+  if ( on.attr.bit.alt_charset )
+    append_sequence (F_enter_alt_charset_mode.cap);
+  else if ( off.attr.bit.alt_charset )
+    append_sequence (F_exit_alt_charset_mode.cap);
+
+  const char* param = ( reset_required
+                     || std::strlen(after_reset) < std::strlen(changes) )
+                      ? after_reset : changes;
+
+  if ( *param )
+  {
+    char sgr[SGR_PARAMETER_SIZE + 3]{CSI};
+    std::strcat (sgr, param);
+    std::strcat (sgr, "m");
+    append_sequence (sgr);
+  }
+
+  term->fg_color = next->fg_color;
+  term->bg_color = next->bg_color;
+  term->attr.byte[0] = next->attr.byte[0];
+  term->attr.bit.crossed_out = next->attr.bit.crossed_out;
+  term->attr.bit.dbl_underline = next->attr.bit.dbl_underline;
+  term->attr.bit.alt_charset = next->attr.bit.alt_charset;
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::addSGRColor ( char list[], FColor color
+                                   , bool foreground ) const
+{
+  if ( color == fc::Default )
+  {
+    addSGRParameter (list, ( foreground ) ? 39 : 49);
+    return;
+  }
+
+  // Parameters between "CSI" and "m" of the color table sequence
+  const char* seq = ( foreground ) ? color_table[color].fg
+                                   : color_table[color].bg;
+  addSGRParameter (list, seq + 2, std::strlen(seq) - 3);
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::addSGRParameter ( char list[]
+                                , const char param[], std::size_t len )
+{
+  std::size_t pos = std::strlen(list);
+
+  if ( len == 0 || pos + len + 2 > SGR_PARAMETER_SIZE )
+    return;
+
+  if ( pos > 0 )
+    list[pos++] = ';';
+
+  std::memcpy (list + pos, param, len);
+  list[pos + len] = '\0';
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::addSGRParameter (char list[], int param)
+{
+  char num[8]{};
+  std::snprintf (num, sizeof(num), "%d", param);
+  addSGRParameter (list, num, std::strlen(num));
+}
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::resetAttribute (FChar*& attr)
 {
@@ -20,6 +20,7 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <cstring>
 
 #include "final/fc.h"
@@ -61,6 +62,19 @@ void FOptiMove::setBaudRate (int baud)
   assert ( baud >= 0 );
   baudrate = baud;
   calculateCharDuration();
+  calculateCapDurations();
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::setThroughput (uInt64 bytes_per_second)
+{
+  // Sets the baud rate from the measured output throughput
+
+  if ( bytes_per_second == 0 )
+    return;
+
+  const uInt64 baud = bytes_per_second * BAUD_BYTE;
+  setBaudRate (int(std::min(baud, uInt64(INT_MAX))));
 }
 
 //----------------------------------------------------------------------
@@ -104,6 +118,8 @@ void FOptiMove::setTermEnvironment (termEnv& term_env)
   set_repeat_char (term_env.t_repeat_char);
   set_clr_bol (term_env.t_clr_bol);
   set_clr_eol (term_env.t_clr_eol);
+  set_parm_ich (term_env.t_parm_ich);
+  set_parm_dch (term_env.t_parm_dch);
   setTabStop (term_env.tabstop);
   set_auto_left_margin (term_env.automatic_left_margin);
   set_eat_newline_glitch (term_env.eat_nl_glitch);
@@ -458,6 +474,42 @@ void FOptiMove::set_clr_eol (char cap[])
   }
 }
 
+//----------------------------------------------------------------------
+void FOptiMove::set_parm_ich (char cap[])
+{
+  if ( cap )
+  {
+    char* temp = tparm(cap, 23, 0, 0, 0, 0, 0, 0, 0, 0);
+    F_parm_ich.cap = cap;
+    F_parm_ich.duration = capDuration (temp, 1);
+    F_parm_ich.length = capDurationToLength (F_parm_ich.duration);
+  }
+  else
+  {
+    F_parm_ich.cap = nullptr;
+    F_parm_ich.duration = \
+    F_parm_ich.length   = LONG_DURATION;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::set_parm_dch (char cap[])
+{
+  if ( cap )
+  {
+    char* temp = tparm(cap, 23, 0, 0, 0, 0, 0, 0, 0, 0);
+    F_parm_dch.cap = cap;
+    F_parm_dch.duration = capDuration (temp, 1);
+    F_parm_dch.length = capDurationToLength (F_parm_dch.duration);
+  }
+  else
+  {
+    F_parm_dch.cap = nullptr;
+    F_parm_dch.duration = \
+    F_parm_dch.length   = LONG_DURATION;
+  }
+}
+
 //----------------------------------------------------------------------
 void FOptiMove::check_boundaries ( int& xold, int& yold
                                  , int& xnew, int& ynew )
@@ -536,8 +588,7 @@ void FOptiMove::calculateCharDuration()
 {
   if ( baudrate != 0 )
   {
-    static constexpr int baudbyte = 9;  // = 7 bit + 1 parity + 1 stop
-    char_duration = (baudbyte * 1000 * 10)
+    char_duration = (BAUD_BYTE * 1000 * 10)
                   / (baudrate > 0 ? baudrate : 9600);  // milliseconds
 
     if ( char_duration <= 0 )
@@ -547,6 +598,35 @@ void FOptiMove::calculateCharDuration()
     char_duration = 1;
 }
 
+//----------------------------------------------------------------------
+void FOptiMove::calculateCapDurations()
+{
+  // The capability durations depend on the character duration
+
+  set_cursor_home (F_cursor_home.cap);
+  set_cursor_to_ll (F_cursor_to_ll.cap);
+  set_carriage_return (F_carriage_return.cap);
+  set_tabular (F_tab.cap);
+  set_back_tab (F_back_tab.cap);
+  set_cursor_up (F_cursor_up.cap);
+  set_cursor_down (F_cursor_down.cap);
+  set_cursor_left (F_cursor_left.cap);
+  set_cursor_right (F_cursor_right.cap);
+  set_cursor_address (F_cursor_address.cap);
+  set_column_address (F_column_address.cap);
+  set_row_address (F_row_address.cap);
+  set_parm_up_cursor (F_parm_up_cursor.cap);
+  set_parm_down_cursor (F_parm_down_cursor.cap);
+  set_parm_left_cursor (F_parm_left_cursor.cap);
+  set_parm_right_cursor (F_parm_right_cursor.cap);
+  set_erase_chars (F_erase_chars.cap);
+  set_repeat_char (F_repeat_char.cap);
+  set_clr_bol (F_clr_bol.cap);
+  set_clr_eol (F_clr_eol.cap);
+  set_parm_ich (F_parm_ich.cap);
+  set_parm_dch (F_parm_dch.cap);
+}
+
 //----------------------------------------------------------------------
 int FOptiMove::capDuration (char cap[], int affcnt)
 {
@@ -0,0 +1,164 @@
+/***********************************************************************
+* foutputmonitor.cpp - Measures the throughput of the terminal output  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/ioctl.h>
+
+#include "final/foutputmonitor.h"
+#include "final/fsystem.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FOutputMonitor
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FOutputMonitor::FOutputMonitor (FSystem* fsys, int fd)
+  : fsystem{fsys}
+  , output_fd{fd}
+{ }
+
+
+// public methods of FOutputMonitor
+//----------------------------------------------------------------------
+bool FOutputMonitor::isBacklogged (uInt64 interval) const
+{
+  // Returns true if the terminal needs longer than
+  // interval microseconds for the queued output
+
+  if ( queue_length <= 0 )
+    return false;
+
+  if ( throughput == 0 )
+    return queue_length > MAX_UNKNOWN_QUEUE;
+
+  return uInt64(queue_length) * 1000000 / throughput > interval;
+}
+
+//----------------------------------------------------------------------
+uInt64 FOutputMonitor::getDrainTime (uInt64 interval) const
+{
+  // Returns the time in microseconds until the queued output
+  // is no longer backlogged (0 = not backlogged)
+
+  if ( ! isBacklogged(interval) )
+    return 0;
+
+  if ( throughput == 0 )
+    return interval;
+
+  return uInt64(queue_length) * 1000000 / throughput - interval;
+}
+
+//----------------------------------------------------------------------
+bool FOutputMonitor::addWriteTime (std::size_t bytes, uInt64 usec)
+{
+  // A write that had to wait for the terminal shows the throughput
+  // of the link (e.g. on a pseudoterminal without queue length).
+  // Returns true if there is a new throughput value.
+
+  if ( bytes == 0 || usec < MIN_WRITE_TIME )
+    return false;
+
+  updateThroughput (uInt64(bytes) * 1000000 / usec);
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FOutputMonitor::measure (const timeval& now)
+{
+  // Reads the output queue length and updates the throughput.
+  // Returns true if there is a new throughput value.
+
+  const int queue = readQueueLength();
+  queue_length = ( queue > 0 ) ? queue : 0;
+
+  if ( queue < 0 )  // Queue length unknown
+    return false;
+
+  if ( sample_queue < 0 )
+  {
+    sample_queue = queue;
+    sample_time = now;
+    written_bytes = 0;
+    return false;
+  }
+
+  const sInt64 elapsed = sInt64(now.tv_sec - sample_time.tv_sec) * 1000000
+                       + sInt64(now.tv_usec - sample_time.tv_usec);
+
+  if ( elapsed < sInt64(MIN_SAMPLE_TIME) )
+    return false;
+
+  bool updated{false};
+
+  // Only a link that was busy the whole time shows its throughput
+  if ( sample_queue > 0 && queue > 0 )
+  {
+    const uInt64 queued = uInt64(sample_queue) + written_bytes;
+
+    if ( queued > uInt64(queue) )
+    {
+      updateThroughput ( (queued - uInt64(queue)) * 1000000
+                       / uInt64(elapsed) );
+      updated = true;
+    }
+  }
+
+  sample_queue = queue;
+  sample_time = now;
+  written_bytes = 0;
+  return updated;
+}
+
+
+// private methods of FOutputMonitor
+//----------------------------------------------------------------------
+int FOutputMonitor::readQueueLength()
+{
+  // Returns the number of bytes in the terminal output queue
+  // or -1 if the system does not provide this information
+
+#if defined(TIOCOUTQ)
+  int queue{0};
+
+  if ( fsystem && fsystem->ioctl(output_fd, TIOCOUTQ, &queue) == 0 )
+    return queue;
+#endif
+
+  return -1;
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitor::updateThroughput (uInt64 sample)
+{
+  // Smoothes the measured values
+
+  if ( throughput == 0 )
+    throughput = sample;
+  else
+    throughput = (3 * throughput + sample) / 4;
+}
+
+}  // namespace finalcut
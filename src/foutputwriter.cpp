@@ -0,0 +1,254 @@
+/***********************************************************************
+* foutputwriter.cpp - Writes the terminal output in a separate thread  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+
+#include "final/foutputwriter.h"
+#include "final/fpoll.h"
+#include "final/fsystem.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr uInt64 FOutputWriter::WAIT_INTERVAL;
+constexpr uInt64 FOutputWriter::MAX_SHUTDOWN_WAIT;
+
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FOutputWriter::FOutputWriter (FSystem* fsys, int fd)
+  : fsystem{fsys}
+{
+  openOutput (fd);
+
+  try
+  {
+    thread = std::thread(&FOutputWriter::run, this);
+  }
+  catch (...)
+  {
+    if ( own_output_fd )
+      fsystem->close(output_fd);
+
+    throw;
+  }
+}
+
+//----------------------------------------------------------------------
+FOutputWriter::~FOutputWriter()  // destructor
+{
+  // The writer thread writes out the remaining data before it ends.
+  // It gives up the data if the terminal does not take it any more.
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    terminate = true;
+  }
+
+  data_available.notify_one();
+  thread.join();
+
+  if ( own_output_fd )
+    fsystem->close(output_fd);
+}
+
+
+// public methods of FOutputWriter
+//----------------------------------------------------------------------
+bool FOutputWriter::getWriteTime (std::size_t& length, uInt64& usec)
+{
+  // Gets the size and the duration of the last write.
+  // Returns false if there was no new write.
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  if ( write_length == 0 )
+    return false;
+
+  length = write_length;
+  usec = write_time;
+  write_length = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FOutputWriter::isBusy()
+{
+  // Returns true while data has not yet been written out
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return writing || ! pending_data.empty();
+}
+
+//----------------------------------------------------------------------
+void FOutputWriter::write (std::string& data)
+{
+  // Takes over the data and leaves an empty buffer behind.
+  // Data that arrives while the thread is writing is combined
+  // into a single pending buffer.
+
+  if ( data.empty() )
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if ( pending_data.empty() )
+      pending_data.swap(data);
+    else
+      pending_data.append(data);
+  }
+
+  data.clear();
+
+  data_available.notify_one();
+}
+
+//----------------------------------------------------------------------
+void FOutputWriter::waitForCompletion()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+  data_written.wait (lock, [this] { return ! writing && pending_data.empty(); });
+}
+
+
+// private methods of FOutputWriter
+//----------------------------------------------------------------------
+void FOutputWriter::openOutput (int fd)
+{
+  // A separate non-blocking file descriptor for the terminal
+  // does not change the file status flags of stdin and stdout
+
+  output_fd = fd;
+
+  if ( ! fsystem->isTTY(fd) )
+    return;
+
+  char termfilename[256]{};
+
+  if ( ttyname_r(fd, termfilename, sizeof(termfilename)) )
+    return;
+
+  const int nonblocking_fd = fsystem->open ( termfilename
+                                           , O_WRONLY | O_NOCTTY | O_NONBLOCK );
+
+  if ( nonblocking_fd < 0 )
+    return;
+
+  output_fd = nonblocking_fd;
+  own_output_fd = true;
+}
+
+//----------------------------------------------------------------------
+void FOutputWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex);
+
+  while ( true )
+  {
+    data_available.wait (lock, [this] { return terminate || ! pending_data.empty(); });
+
+    if ( pending_data.empty() )  // Terminate
+      break;
+
+    active_data.swap(pending_data);
+    writing = true;
+    lock.unlock();
+    const auto start = std::chrono::steady_clock::now();
+    writeData (active_data);
+    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>
+                          (std::chrono::steady_clock::now() - start);
+    lock.lock();
+    write_length = active_data.length();
+    write_time = uInt64(duration.count());
+    active_data.clear();
+    writing = false;
+    data_written.notify_all();
+
+    // The event loop waits for the end of the write
+    FPoll::wakeUp();
+  }
+}
+
+//----------------------------------------------------------------------
+void FOutputWriter::writeData (const std::string& data)
+{
+  const char* buffer = data.data();
+  std::size_t length = data.length();
+
+  while ( length > 0 )
+  {
+    const ssize_t bytes = fsystem->write (output_fd, buffer, length);
+
+    if ( bytes < 0 )
+    {
+      if ( errno == EINTR )
+        continue;
+
+      if ( (errno == EAGAIN || errno == EWOULDBLOCK) && waitForOutput() )
+        continue;
+
+      break;  // Output error - discard the rest
+    }
+
+    buffer += bytes;
+    length -= std::size_t(bytes);
+  }
+}
+
+//----------------------------------------------------------------------
+bool FOutputWriter::waitForOutput()
+{
+  // Waits until the terminal can accept more data. A stalled terminal
+  // (e.g. after XOFF or on a dead network link) delays the shutdown
+  // only for MAX_SHUTDOWN_WAIT microseconds in total.
+
+  while ( ! FPoll::waitForOutput(fsystem, output_fd, WAIT_INTERVAL) )
+  {
+    if ( isTerminating() )
+    {
+      shutdown_wait += WAIT_INTERVAL;
+
+      if ( shutdown_wait >= MAX_SHUTDOWN_WAIT )
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FOutputWriter::isTerminating()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  return terminate;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,334 @@
+/***********************************************************************
+* fpoll.cpp - Waits for input, file descriptor events and signals      *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
+#include "final/fpoll.h"
+#include "final/fsystem.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr uInt64           FPoll::NO_TIMEOUT;
+std::vector<FPoll::FWatch> FPoll::watch_list{};
+std::vector<pollfd>        FPoll::poll_list{};
+std::atomic<int>           FPoll::wakeup_pipe[2]{{-1}, {-1}};
+
+
+//----------------------------------------------------------------------
+// class FPoll
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FPoll::FPoll()
+{ }
+
+//----------------------------------------------------------------------
+FPoll::~FPoll()  // destructor
+{ }
+
+
+// public methods of FPoll
+//----------------------------------------------------------------------
+bool FPoll::isWatched (int fd)
+{
+  for (auto&& watch : watch_list)
+    if ( watch.fd == fd )
+      return true;
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+bool FPoll::init()
+{
+  // Creates the self-pipe that interrupts the wait
+
+  if ( wakeup_pipe[0] != -1 )
+    return true;
+
+  int pipe_fd[2]{-1, -1};
+
+  if ( ::pipe(pipe_fd) != 0 )
+    return false;
+
+  for (auto&& fd : pipe_fd)
+  {
+    ::fcntl (fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl (fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  wakeup_pipe[0] = pipe_fd[0];
+  wakeup_pipe[1] = pipe_fd[1];
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FPoll::finish()
+{
+  watch_list.clear();
+
+  // The descriptors are invalidated before they are closed,
+  // so that wakeUp() in another thread no longer uses them
+  for (auto&& fd : wakeup_pipe)
+  {
+    const int pipe_fd = fd.exchange(-1);
+
+    if ( pipe_fd != -1 )
+      ::close(pipe_fd);
+  }
+}
+
+//----------------------------------------------------------------------
+bool FPoll::addWatch (int fd, int events, const FWatchCallback& callback)
+{
+  // Calls callback when fd becomes readable or writable.
+  // A second call for the same fd replaces the watch.
+
+  if ( fd < 0 || ! callback )
+    return false;
+
+  for (auto&& watch : watch_list)
+  {
+    if ( watch.fd == fd )
+    {
+      watch.events = events;
+      watch.callback = callback;
+      return true;
+    }
+  }
+
+  watch_list.push_back({fd, events, callback});
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FPoll::setWatchEvents (int fd, int events)
+{
+  // Changes the watched events (no_event pauses the watch)
+
+  for (auto&& watch : watch_list)
+  {
+    if ( watch.fd == fd )
+    {
+      watch.events = events;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+bool FPoll::delWatch (int fd)
+{
+  auto iter = std::find_if ( watch_list.begin(), watch_list.end()
+                           , [&fd] (const FWatch& watch)
+                             {
+                               return watch.fd == fd;
+                             } );
+
+  if ( iter == watch_list.end() )
+    return false;
+
+  watch_list.erase(iter);
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FPoll::waitForInput (int input_fd, uInt64 timeout)
+{
+  // Sleeps until input_fd is readable, a watched file descriptor
+  // is ready, wakeUp() is called or the timeout (in microseconds)
+  // expires. Returns true if input_fd is readable.
+
+  init();
+  poll_list.clear();
+
+  if ( input_fd >= 0 )
+    poll_list.push_back({input_fd, POLLIN, 0});
+
+  if ( wakeup_pipe[0] != -1 )
+    poll_list.push_back({wakeup_pipe[0], POLLIN, 0});
+
+  const std::size_t first_watch = poll_list.size();
+
+  for (auto&& watch : watch_list)
+    if ( watch.events != no_event )
+      poll_list.push_back({watch.fd, toPollEvents(watch.events), 0});
+
+  const int result = ::poll ( poll_list.data()
+                            , nfds_t(poll_list.size())
+                            , toMilliseconds(timeout) );
+
+  if ( result <= 0 )  // Timeout or interrupted by a signal
+    return false;
+
+  const bool has_input = input_fd >= 0 && poll_list[0].revents != 0;
+
+  if ( wakeup_pipe[0] != -1 && poll_list[first_watch - 1].revents != 0 )
+    clearWakeUp();
+
+  if ( first_watch == poll_list.size() )
+    return has_input;
+
+  // A callback can start a nested event loop (e.g. a modal dialog)
+  // that reuses poll_list, so the ready entries are copied first
+  std::vector<pollfd> ready_list{};
+
+  for (std::size_t i = first_watch; i < poll_list.size(); i++)
+    if ( poll_list[i].revents != 0 )
+      ready_list.push_back(poll_list[i]);
+
+  for (auto&& entry : ready_list)
+    dispatch (entry);
+
+  return has_input;
+}
+
+//----------------------------------------------------------------------
+bool FPoll::waitForOutput (FSystem* fsystem, int output_fd, uInt64 timeout)
+{
+  // Sleeps until output_fd can take more data or the timeout
+  // (in microseconds) expires. Returns false on timeout. An error
+  // state also ends the wait, so that the next write reports it.
+  // Unlike waitForInput(), it can be called from any thread.
+
+  if ( ! fsystem || output_fd < 0 )
+    return false;
+
+  pollfd pfd{output_fd, POLLOUT, 0};
+  int result;
+
+  do
+  {
+    result = fsystem->poll (&pfd, 1, toMilliseconds(timeout));
+  }
+  while ( result < 0 && errno == EINTR );
+
+  return result > 0;
+}
+
+//----------------------------------------------------------------------
+void FPoll::wakeUp()
+{
+  // Interrupts the wait (async-signal-safe)
+
+  const int pipe_fd = wakeup_pipe[1];
+
+  if ( pipe_fd == -1 )
+    return;
+
+  const int saved_errno = errno;
+  const char byte{0};
+  const ssize_t ret = ::write(pipe_fd, &byte, 1);
+  static_cast<void>(ret);  // A full pipe already wakes up
+  errno = saved_errno;
+}
+
+
+// private methods of FPoll
+//----------------------------------------------------------------------
+short FPoll::toPollEvents (int events)
+{
+  short poll_events{0};
+
+  if ( events & readable )
+    poll_events |= POLLIN;
+
+  if ( events & writable )
+    poll_events |= POLLOUT;
+
+  return poll_events;
+}
+
+//----------------------------------------------------------------------
+int FPoll::fromPollEvents (short poll_events)
+{
+  int events{no_event};
+
+  if ( poll_events & (POLLIN | POLLPRI | POLLHUP | POLLERR) )
+    events |= readable;
+
+  if ( poll_events & (POLLOUT | POLLHUP | POLLERR) )
+    events |= writable;
+
+  return events;
+}
+
+//----------------------------------------------------------------------
+int FPoll::toMilliseconds (uInt64 timeout)
+{
+  if ( timeout == NO_TIMEOUT )
+    return -1;  // Infinite
+
+  // Rounds up so that a short wait does not become a busy loop
+  const uInt64 msec = (timeout + 999) / 1000;
+  return ( msec > uInt64(INT_MAX) ) ? INT_MAX : int(msec);
+}
+
+//----------------------------------------------------------------------
+void FPoll::dispatch (const pollfd& entry)
+{
+  auto iter = std::find_if ( watch_list.begin(), watch_list.end()
+                           , [&entry] (const FWatch& watch)
+                             {
+                               return watch.fd == entry.fd;
+                             } );
+
+  if ( iter == watch_list.end() )  // Removed by a previous callback
+    return;
+
+  if ( entry.revents & POLLNVAL )
+  {
+    // The file descriptor was closed without delWatch()
+    watch_list.erase(iter);
+    return;
+  }
+
+  const int events = fromPollEvents(entry.revents) & iter->events;
+
+  if ( events == no_event )
+    return;
+
+  // The copy stays valid if the callback removes its own watch
+  const auto callback = iter->callback;
+  callback (entry.fd, events);
+}
+
+//----------------------------------------------------------------------
+void FPoll::clearWakeUp()
+{
+  char buffer[64];
+
+  while ( ::read(wakeup_pipe[0], buffer, sizeof(buffer)) > 0 )
+    continue;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,198 @@
+/***********************************************************************
+* fpostqueue.cpp - Lock-free queue for events from other threads       *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <iostream>
+#include <new>
+#include <utility>
+
+#include "final/fpostqueue.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FPostQueue
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FPostQueue::FPostQueue()
+  : head{&stub}
+  , tail{&stub}
+{ }
+
+//----------------------------------------------------------------------
+FPostQueue::~FPostQueue()  // destructor
+{
+  while ( auto node = popNode() )
+    delete node;
+}
+
+
+// public methods of FPostQueue
+//----------------------------------------------------------------------
+bool FPostQueue::isEmpty() const
+{
+  // An item whose producer has not yet linked it counts as
+  // not queued; the producer wakes up the event loop afterwards
+  return tail == &stub
+      && stub.next.load(std::memory_order_acquire) == nullptr;
+}
+
+//----------------------------------------------------------------------
+void FPostQueue::push ( const FObject* receiver
+                      , std::unique_ptr<FEvent> event )
+{
+  // Queues an event for the receiver (thread-safe)
+
+  FNode* node;
+
+  try
+  {
+    node = new FNode;
+  }
+  catch (const std::bad_alloc& ex)
+  {
+    std::cerr << bad_alloc_str << ex.what() << std::endl;
+    return;
+  }
+
+  node->item.receiver = receiver;
+  node->item.event = std::move(event);
+  pushNode (node);
+}
+
+//----------------------------------------------------------------------
+void FPostQueue::push (FTask task)
+{
+  // Queues a function call (thread-safe)
+
+  FNode* node;
+
+  try
+  {
+    node = new FNode;
+  }
+  catch (const std::bad_alloc& ex)
+  {
+    std::cerr << bad_alloc_str << ex.what() << std::endl;
+    return;
+  }
+
+  node->item.task = std::move(task);
+  pushNode (node);
+}
+
+//----------------------------------------------------------------------
+bool FPostQueue::pop (FPostItem& item)
+{
+  // Moves the oldest item into item (event loop thread only)
+
+  auto node = popNode();
+
+  if ( ! node )
+    return false;
+
+  item = std::move(node->item);
+  delete node;
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FPostQueue::removeReceiver (const FObject* receiver)
+{
+  // Discards all queued events for the receiver (event loop thread only)
+
+  if ( ! receiver )
+    return false;
+
+  bool found{false};
+  auto node = tail;
+
+  while ( node )
+  {
+    if ( node != &stub && node->item.receiver == receiver )
+    {
+      node->item.receiver = nullptr;
+      node->item.event.reset();
+      found = true;
+    }
+
+    node = node->next.load(std::memory_order_acquire);
+  }
+
+  return found;
+}
+
+
+// private methods of FPostQueue
+//----------------------------------------------------------------------
+void FPostQueue::pushNode (FNode* node)
+{
+  // A producer only swaps the head and then links its predecessor,
+  // so pushing never waits for another thread
+
+  node->next.store (nullptr, std::memory_order_relaxed);
+  auto prev = head.exchange(node, std::memory_order_acq_rel);
+  prev->next.store (node, std::memory_order_release);
+}
+
+//----------------------------------------------------------------------
+FPostQueue::FNode* FPostQueue::popNode()
+{
+  auto node = tail;
+  auto next = node->next.load(std::memory_order_acquire);
+
+  if ( node == &stub )  // Skip the placeholder node
+  {
+    if ( ! next )
+      return nullptr;  // Empty
+
+    tail = next;
+    node = next;
+    next = next->next.load(std::memory_order_acquire);
+  }
+
+  if ( next )
+  {
+    tail = next;
+    return node;
+  }
+
+  if ( node != head.load(std::memory_order_acquire) )
+    return nullptr;  // A producer has not yet linked its node
+
+  // The last node can only be removed with a placeholder behind it
+  pushNode (&stub);
+  next = node->next.load(std::memory_order_acquire);
+
+  if ( next )
+  {
+    tail = next;
+    return node;
+  }
+
+  return nullptr;
+}
+
+}  // namespace finalcut
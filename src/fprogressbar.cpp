@@ -238,9 +238,9 @@ void FProgressbar::drawProgressBackground (std::size_t len)
   setColor (wc.progressbar_fg, wc.progressbar_bg);
 
   if ( getMaxColor() < 16 )
-    print() << FString (bg_len, fc::MediumShade);  // ▒
+    printRepeated (this, fc::MediumShade, bg_len);  // ▒
   else
-    print() << FString (bg_len, L' ');
+    printRepeated (this, L' ', bg_len);
 }
 
 }  // namespace finalcut
@@ -403,9 +403,20 @@ void FScrollView::scrollTo (int x, int y)
     }
   }
 
+  if ( changeY && ! changeX && hasPrintArea()
+    && getCurrentPrintArea() != viewport
+    && std::abs(yoffset - yoffset_before) < int(getViewportHeight()) )
+  {
+    // Scroll the visible part, so that the terminal
+    // update can move it with a scrolling region
+    const FRect box ( getTermX() + 1, getTermY() + 1
+                    , getViewportWidth(), getViewportHeight() );
+    scrollArea (getCurrentPrintArea(), box, yoffset - yoffset_before);
+  }
+
   viewport->has_changes = true;
   copy2area();
-  updateTerminal();
+  requestTerminalUpdate();
 }
 
 //----------------------------------------------------------------------
@@ -673,11 +684,8 @@ void FScrollView::copy2area()
     ac = &printarea->data[(ay + y) * a_line_len + ax];
     std::memcpy (ac, vc, sizeof(FChar) * unsigned(x_end));
 
-    if ( int(printarea->changes[ay + y].xmin) > ax )
-      printarea->changes[ay + y].xmin = uInt(ax);
-
-    if ( int(printarea->changes[ay + y].xmax) < ax + x_end - 1 )
-      printarea->changes[ay + y].xmax = uInt(ax + x_end - 1);
+    addLineChanges ( printarea->changes[ay + y]
+                   , uInt(ax), uInt(ax + x_end - 1) );
   }
 
   setViewportCursor();
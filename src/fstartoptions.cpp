@@ -43,7 +43,10 @@ FStartOptions::FStartOptions()
   , sgr_optimizer{true}
   , vgafont{false}
   , newfont{false}
+  , async_output{false}
   , encoding{fc::UNKNOWN}
+  , max_fps{60}
+  , trace_file{}
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   , meta_sends_escape{true}
   , change_cursorstyle{true}
@@ -92,7 +95,10 @@ void FStartOptions::setDefault()
   color_change = true;
   vgafont = false;
   newfont = false;
+  async_output = false;
   encoding = fc::UNKNOWN;
+  max_fps = 60;
+  trace_file.clear();
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
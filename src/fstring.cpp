@@ -73,10 +73,17 @@ FString::FString (const FString& s)  // copy constructor
 }
 
 //----------------------------------------------------------------------
-FString::FString (FString&& s)  // move constructor
+FString::FString (FString&& s) noexcept  // move constructor
+  : string{s.string}
+  , length{s.length}
+  , bufsize{s.bufsize}
+  , c_string{s.c_string}
 {
-  if ( ! s.isNull() )
-    _assign (std::move(s.string));
+  // Takes over the buffer of s
+  s.string = nullptr;
+  s.length = 0;
+  s.bufsize = 0;
+  s.c_string = nullptr;
 }
 
 //----------------------------------------------------------------------
@@ -171,9 +178,23 @@ FString& FString::operator = (const FString& s)
 }
 
 //----------------------------------------------------------------------
-FString& FString::operator = (FString&& s)
+FString& FString::operator = (FString&& s) noexcept
 {
-  _assign (std::move(s.string));
+  if ( &s == this )
+    return *this;
+
+  if ( string && s.string && s.length <= capacity() )
+  {
+    _assign (s.string);  // Keeps the existing buffer
+  }
+  else
+  {
+    std::swap (string, s.string);
+    std::swap (length, s.length);
+    std::swap (bufsize, s.bufsize);
+    std::swap (c_string, s.c_string);
+  }
+
   return *this;
 }
 
@@ -184,6 +205,26 @@ const FString& FString::operator += (const FString& s)
   return *this;
 }
 
+//----------------------------------------------------------------------
+const FString& FString::operator += (const wchar_t c)
+{
+  // Appends without a temporary string (a null character is ignored)
+
+  if ( c )
+  {
+    const wchar_t s[2] = { c, L'\0' };
+    _insert (length, 1, s);
+  }
+
+  return *this;
+}
+
+//----------------------------------------------------------------------
+const FString& FString::operator += (const char c)
+{
+  return operator += (wchar_t(c & 0xff));
+}
+
 
 //----------------------------------------------------------------------
 const FString FString::operator + (const FString& s)
@@ -721,11 +762,9 @@ FString FString::right (std::size_t len) const
 //----------------------------------------------------------------------
 FString FString::mid (std::size_t pos, std::size_t len) const
 {
-  const FString s(string);
-
   // handle NULL and empty string
   if ( ! (string && *string) )
-    return s;
+    return FString(string);
 
   if ( pos == 0 )
     pos = 1;
@@ -736,10 +775,9 @@ FString FString::mid (std::size_t pos, std::size_t len) const
   if ( pos > length || pos + len - 1 > length || len == 0 )
     return FString(L"");
 
-  wchar_t* p = s.string;
-  wchar_t* first = p + pos - 1;
-  *(first + len) = '\0';
-  return FString(first);
+  FString sub(len);
+  std::wmemcpy (sub.string, string + pos - 1, len);
+  return sub;
 }
 
 //----------------------------------------------------------------------
@@ -1357,7 +1395,8 @@ void FString::_insert ( std::size_t pos
 //----------------------------------------------------------------------
 void FString::_remove (std::size_t pos, std::size_t len)
 {
-  if ( capacity() - length + len <= FWDBUFFER )
+  // Shrinks the buffer only when a lot of unused space would remain
+  if ( capacity() - length + len <= 2 * FWDBUFFER )
   {
     // shifting left side to pos
     for (std::size_t i = pos; i + len < length + 1; i++)
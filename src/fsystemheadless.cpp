@@ -0,0 +1,796 @@
+/***********************************************************************
+* fsystemheadless.cpp - FSystem with an in-memory terminal             *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__CYGWIN__)
+  #include "final/fconfig.h"  // need for getpwuid_r and realpath
+#endif
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <cstring>
+
+#include "final/fsystemheadless.h"
+#include "final/fterm.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FSystemHeadless
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FSystemHeadless::FSystemHeadless ( std::size_t w, std::size_t h
+                                 , const char* termtype )
+{
+  // Replaces the terminal with an in-memory screen grid.
+  // The object has to be passed to FTerm::setFSystem() before
+  // the application object is created (FTerm takes the ownership):
+  //
+  //   finalcut::FTerm::setFSystem(new finalcut::FSystemHeadless(120, 40));
+  //   finalcut::FApplication app(argc, argv);
+  //
+  // The terminal type selects the terminal capabilities
+
+  if ( termtype )
+    setenv ("TERM", termtype, 1);
+
+  cfsetispeed (&tty_settings, B38400);
+  cfsetospeed (&tty_settings, B38400);
+  setSize (w, h);
+}
+
+//----------------------------------------------------------------------
+FSystemHeadless::~FSystemHeadless()  // destructor
+{ }
+
+
+// public methods of FSystemHeadless
+//----------------------------------------------------------------------
+wchar_t FSystemHeadless::getCharacter (const FPoint& pos) const
+{
+  // Returns the character at the screen position pos
+  // (L'\0' for the second column of a full-width character)
+
+  const int x = pos.getX();
+  const int y = pos.getY();
+
+  if ( x < 0 || y < 0 || x >= int(width) || y >= int(height) )
+    return L'\0';
+
+  return screen[std::size_t(y) * width + std::size_t(x)];
+}
+
+//----------------------------------------------------------------------
+const FString FSystemHeadless::getLine (int y) const
+{
+  if ( y < 0 || y >= int(height) )
+    return FString{};
+
+  std::wstring line{};
+  const auto first = screen.begin() + std::ptrdiff_t(std::size_t(y) * width);
+
+  for (auto iter = first; iter != first + std::ptrdiff_t(width); ++iter)
+    if ( *iter != L'\0' )
+      line += *iter;
+
+  return FString{line};
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::setSize (std::size_t w, std::size_t h)
+{
+  // Resizing clears the screen like a terminal reset
+
+  width = std::max(w, std::size_t(1));
+  height = std::max(h, std::size_t(1));
+  screen.assign (width * height, L' ');
+  cursor.setPoint (0, 0);
+  saved_cursor.setPoint (0, 0);
+  scroll_top = 0;
+  scroll_bottom = int(height) - 1;
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+uChar FSystemHeadless::inPortByte (uShort)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::outPortByte (uChar, uShort)
+{ }
+
+//----------------------------------------------------------------------
+int FSystemHeadless::isTTY (int)
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::ioctl (int, uLong request, ...)
+{
+  // Only the window size is known
+
+  va_list args{};
+  va_start (args, request);
+  void* argp = va_arg (args, void*);
+  int ret_val{-1};
+
+  if ( request == TIOCGWINSZ && argp )
+  {
+    auto win_size = static_cast<struct winsize*>(argp);
+    win_size->ws_row = uShort(height);
+    win_size->ws_col = uShort(width);
+    win_size->ws_xpixel = 0;
+    win_size->ws_ypixel = 0;
+    ret_val = 0;
+  }
+  else
+    errno = EINVAL;
+
+  va_end (args);
+  return ret_val;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::open (const char*, int, ...)
+{
+  // There are no devices
+  errno = ENOENT;
+  return -1;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::close (int)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+FILE* FSystemHeadless::fopen (const char*, const char*)
+{
+  errno = ENOENT;
+  return nullptr;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::fclose (FILE*)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::putchar (int c)
+{
+  output.push_back(char(c));
+  parse (char(c));
+  return c;
+}
+
+//----------------------------------------------------------------------
+ssize_t FSystemHeadless::write (int, const void* buf, std::size_t count)
+{
+  const auto data = static_cast<const char*>(buf);
+  output.append (data, count);
+
+  for (std::size_t i{0}; i < count; i++)
+    parse (data[i]);
+
+  return ssize_t(count);
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::tputs (const char* str, int, int (*putc)(int))
+{
+  // Outputs the string without padding
+
+  if ( ! str )
+    return -1;
+
+  while ( *str )
+  {
+    if ( str[0] == '$' && str[1] == '<' )
+    {
+      const char* end = std::strchr(str, '>');
+
+      if ( end )
+      {
+        str = end + 1;
+        continue;
+      }
+    }
+
+    putc (*str);
+    str++;
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::tcgetattr (int, struct termios* t)
+{
+  *t = tty_settings;
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::tcsetattr (int, int, const struct termios* t)
+{
+  tty_settings = *t;
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::poll (struct pollfd* fds, nfds_t nfds, int timeout)
+{
+  // The in-memory terminal can always take more data
+
+  int ready{0};
+
+  for (nfds_t i{0}; i < nfds; i++)
+  {
+    fds[i].revents = fds[i].events & POLLOUT;
+
+    if ( fds[i].revents != 0 )
+      ready++;
+  }
+
+  if ( ready > 0 )
+    return ready;
+
+  return ::poll (fds, nfds, timeout);
+}
+
+//----------------------------------------------------------------------
+uid_t FSystemHeadless::getuid()
+{
+  return ::getuid();
+}
+
+//----------------------------------------------------------------------
+uid_t FSystemHeadless::geteuid()
+{
+  return ::geteuid();
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::getpwuid_r ( uid_t uid, struct passwd* pwd
+                                , char* buf, size_t buflen
+                                , struct passwd** result )
+{
+  return ::getpwuid_r (uid, pwd, buf, buflen, result);
+}
+
+//----------------------------------------------------------------------
+char* FSystemHeadless::realpath (const char* path, char* resolved_path)
+{
+  return ::realpath(path, resolved_path);
+}
+
+
+// private methods of FSystemHeadless
+//----------------------------------------------------------------------
+void FSystemHeadless::parse (char c)
+{
+  // Interprets the output byte by byte
+
+  const auto ch = uChar(c);
+
+  switch ( state )
+  {
+    case ground:
+      if ( ch >= 0x80 )
+      {
+        parseUTF8 (ch);
+        break;
+      }
+
+      utf8_remaining = 0;
+
+      if ( ch == 0x1b )
+        state = escape;
+      else if ( ch == '\r' )
+        setCursor (0, cursor.getY());
+      else if ( ch == '\n' || ch == '\v' || ch == '\f' )
+        lineFeed();
+      else if ( ch == '\b' )
+        setCursor (cursor.getX() - 1, cursor.getY());
+      else if ( ch == '\t' )
+        setCursor ((cursor.getX() / 8 + 1) * 8, cursor.getY());
+      else if ( ch >= 0x20 && ch != 0x7f )
+        printCharacter (wchar_t(ch));
+      break;
+
+    case escape:
+      parseEscape (c);
+      break;
+
+    case charset:
+      state = ground;
+      break;
+
+    case control_sequence:
+      if ( ch == 0x1b )
+      {
+        state = escape;
+        break;
+      }
+
+      sequence.push_back(c);
+
+      if ( ch >= 0x40 && ch <= 0x7e )  // Final byte
+      {
+        state = ground;
+        parseControlSequence();
+      }
+      break;
+
+    case string_sequence:
+      if ( ch == 0x07 )  // BEL terminates the string
+        state = ground;
+      else if ( ch == 0x1b )
+        state = string_escape;
+      break;
+
+    case string_escape:
+      state = ( ch == '\\' ) ? ground : string_sequence;
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::parseEscape (char c)
+{
+  state = ground;
+
+  switch ( c )
+  {
+    case '[':  // Control sequence introducer
+      sequence.clear();
+      state = control_sequence;
+      break;
+
+    case ']':  // Operating system command
+    case 'P':  // Device control string
+    case '^':  // Privacy message
+    case '_':  // Application program command
+      state = string_sequence;
+      break;
+
+    case '(':  // Character set designation
+    case ')':
+    case '*':
+    case '+':
+      state = charset;
+      break;
+
+    case '7':  // Save cursor
+      saved_cursor = cursor;
+      break;
+
+    case '8':  // Restore cursor
+      setCursor (saved_cursor.getX(), saved_cursor.getY());
+      break;
+
+    case 'D':  // Index
+      lineFeed();
+      break;
+
+    case 'E':  // Next line
+      setCursor (0, cursor.getY());
+      lineFeed();
+      break;
+
+    case 'M':  // Reverse index
+      reverseLineFeed();
+      break;
+
+    case 'c':  // Full reset
+      setSize (width, height);
+      break;
+
+    default:
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::parseControlSequence()
+{
+  const char final_byte = sequence.back();
+
+  // Private modes and sequences with intermediate bytes
+  // do not change the screen content
+  if ( sequence.find_first_of("?<=> !\"#$%&'*+,-./") != std::string::npos )
+    return;
+
+  parameter.clear();
+  int value{-1};
+
+  for (std::size_t i{0}; i + 1 < sequence.length(); i++)
+  {
+    const char c = sequence[i];
+
+    if ( c >= '0' && c <= '9' )
+      value = ( value < 0 ) ? c - '0' : value * 10 + c - '0';
+    else
+    {
+      parameter.push_back(value);
+      value = -1;
+    }
+  }
+
+  parameter.push_back(value);
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+  const int n = getParameter(0);
+
+  switch ( final_byte )
+  {
+    case 'A':  // Cursor up
+      setCursor (x, y - n);
+      break;
+
+    case 'B':  // Cursor down
+    case 'e':
+      setCursor (x, y + n);
+      break;
+
+    case 'C':  // Cursor forward
+    case 'a':
+      setCursor (x + n, y);
+      break;
+
+    case 'D':  // Cursor backward
+      setCursor (x - n, y);
+      break;
+
+    case 'E':  // Cursor next line
+      setCursor (0, y + n);
+      break;
+
+    case 'F':  // Cursor previous line
+      setCursor (0, y - n);
+      break;
+
+    case 'I':  // Cursor forward tabulation
+      setCursor ((x / 8 + n) * 8, y);
+      break;
+
+    case 'Z':  // Cursor backward tabulation
+      setCursor (( x > 0 ) ? ((x - 1) / 8 - n + 1) * 8 : 0, y);
+      break;
+
+    case 'G':  // Cursor horizontal absolute
+    case '`':
+      setCursor (n - 1, y);
+      break;
+
+    case 'd':  // Line position absolute
+      setCursor (x, n - 1);
+      break;
+
+    case 'H':  // Cursor position
+    case 'f':
+      setCursor (getParameter(1) - 1, n - 1);
+      break;
+
+    case 'J':  // Erase in display
+      eraseInDisplay (getParameter(0, 0));
+      break;
+
+    case 'K':  // Erase in line
+      eraseInLine (getParameter(0, 0));
+      break;
+
+    case 'X':  // Erase characters
+      clearCells (y, x, x + n - 1);
+      break;
+
+    case '@':  // Insert characters
+      insertCharacters (n);
+      break;
+
+    case 'P':  // Delete characters
+      deleteCharacters (n);
+      break;
+
+    case 'L':  // Insert lines
+      if ( y >= scroll_top && y <= scroll_bottom )
+        scrollDown (y, scroll_bottom, n);
+      break;
+
+    case 'M':  // Delete lines
+      if ( y >= scroll_top && y <= scroll_bottom )
+        scrollUp (y, scroll_bottom, n);
+      break;
+
+    case 'S':  // Scroll up
+      scrollUp (scroll_top, scroll_bottom, n);
+      break;
+
+    case 'T':  // Scroll down
+      scrollDown (scroll_top, scroll_bottom, n);
+      break;
+
+    case 'b':  // Repeat the preceding character
+      for (int i{0}; i < n; i++)
+        printCharacter (last_character);
+      break;
+
+    case 'r':  // Set scrolling region
+    {
+      const int top = n - 1;
+      const int bottom = getParameter(1, int(height)) - 1;
+
+      if ( top < bottom && bottom < int(height) )
+      {
+        scroll_top = top;
+        scroll_bottom = bottom;
+      }
+
+      setCursor (0, 0);
+      break;
+    }
+
+    case 's':  // Save cursor
+      saved_cursor = cursor;
+      break;
+
+    case 'u':  // Restore cursor
+      setCursor (saved_cursor.getX(), saved_cursor.getY());
+      break;
+
+    default:  // Attributes and modes do not change the content
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::parseUTF8 (uChar ch)
+{
+  if ( utf8_remaining > 0 && (ch & 0xc0) == 0x80 )
+  {
+    utf8_value = (utf8_value << 6) | (ch & 0x3f);
+    utf8_remaining--;
+
+    if ( utf8_remaining == 0 )
+      printCharacter (wchar_t(utf8_value));
+
+    return;
+  }
+
+  if ( (ch & 0xe0) == 0xc0 )
+  {
+    utf8_value = ch & 0x1f;
+    utf8_remaining = 1;
+  }
+  else if ( (ch & 0xf0) == 0xe0 )
+  {
+    utf8_value = ch & 0x0f;
+    utf8_remaining = 2;
+  }
+  else if ( (ch & 0xf8) == 0xf0 )
+  {
+    utf8_value = ch & 0x07;
+    utf8_remaining = 3;
+  }
+  else  // Invalid sequence
+    utf8_remaining = 0;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::printCharacter (wchar_t ch)
+{
+  const int char_width = ( getColumnWidth(ch) == 2 ) ? 2 : 1;
+
+  if ( wrap_pending
+    || (char_width == 2 && cursor.getX() == int(width) - 1) )
+  {
+    // Automatic margin
+    cursor.setX(0);
+    lineFeed();
+  }
+
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+  cell(x, y) = ch;
+
+  if ( char_width == 2 )
+    cell(x + 1, y) = L'\0';
+
+  last_character = ch;
+
+  if ( x + char_width >= int(width) )
+  {
+    cursor.setX(int(width) - 1);
+    wrap_pending = true;
+  }
+  else
+    cursor.setX(x + char_width);
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::lineFeed()
+{
+  const int y = cursor.getY();
+
+  if ( y == scroll_bottom )
+    scrollUp (scroll_top, scroll_bottom, 1);
+  else if ( y < int(height) - 1 )
+    cursor.setY(y + 1);
+
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::reverseLineFeed()
+{
+  const int y = cursor.getY();
+
+  if ( y == scroll_top )
+    scrollDown (scroll_top, scroll_bottom, 1);
+  else if ( y > 0 )
+    cursor.setY(y - 1);
+
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::scrollUp (int top, int bottom, int n)
+{
+  // Moves the lines top to bottom n lines up
+
+  n = std::min(n, bottom - top + 1);
+  const auto first = screen.begin() + std::ptrdiff_t(std::size_t(top) * width);
+  const auto last = screen.begin() + std::ptrdiff_t(std::size_t(bottom + 1) * width);
+  std::copy (first + std::ptrdiff_t(std::size_t(n) * width), last, first);
+
+  for (int y = bottom - n + 1; y <= bottom; y++)
+    clearCells (y, 0, int(width) - 1);
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::scrollDown (int top, int bottom, int n)
+{
+  // Moves the lines top to bottom n lines down
+
+  n = std::min(n, bottom - top + 1);
+  const auto first = screen.begin() + std::ptrdiff_t(std::size_t(top) * width);
+  const auto last = screen.begin() + std::ptrdiff_t(std::size_t(bottom + 1) * width);
+  std::copy_backward (first, last - std::ptrdiff_t(std::size_t(n) * width), last);
+
+  for (int y = top; y < top + n; y++)
+    clearCells (y, 0, int(width) - 1);
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::clearCells (int y, int x1, int x2)
+{
+  x1 = std::max(x1, 0);
+  x2 = std::min(x2, int(width) - 1);
+
+  for (int x = x1; x <= x2; x++)
+    cell(x, y) = L' ';
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::eraseInDisplay (int mode)
+{
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+
+  if ( mode == 0 )  // From the cursor to the end of the screen
+  {
+    clearCells (y, x, int(width) - 1);
+
+    for (int i = y + 1; i < int(height); i++)
+      clearCells (i, 0, int(width) - 1);
+  }
+  else if ( mode == 1 )  // From the beginning of the screen to the cursor
+  {
+    for (int i{0}; i < y; i++)
+      clearCells (i, 0, int(width) - 1);
+
+    clearCells (y, 0, x);
+  }
+  else  // Entire screen
+  {
+    std::fill (screen.begin(), screen.end(), L' ');
+  }
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::eraseInLine (int mode)
+{
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+
+  if ( mode == 0 )  // From the cursor to the end of the line
+    clearCells (y, x, int(width) - 1);
+  else if ( mode == 1 )  // From the beginning of the line to the cursor
+    clearCells (y, 0, x);
+  else  // Entire line
+    clearCells (y, 0, int(width) - 1);
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::insertCharacters (int n)
+{
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+  n = std::min(n, int(width) - x);
+  const auto line = screen.begin() + std::ptrdiff_t(std::size_t(y) * width);
+  std::copy_backward (line + x, line + int(width) - n, line + int(width));
+  clearCells (y, x, x + n - 1);
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::deleteCharacters (int n)
+{
+  const int x = cursor.getX();
+  const int y = cursor.getY();
+  n = std::min(n, int(width) - x);
+  const auto line = screen.begin() + std::ptrdiff_t(std::size_t(y) * width);
+  std::copy (line + x + n, line + int(width), line + x);
+  clearCells (y, int(width) - n, int(width) - 1);
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadless::setCursor (int x, int y)
+{
+  x = std::max(0, std::min(x, int(width) - 1));
+  y = std::max(0, std::min(y, int(height) - 1));
+  cursor.setPoint (x, y);
+  wrap_pending = false;
+}
+
+//----------------------------------------------------------------------
+int FSystemHeadless::getParameter (std::size_t index, int default_value) const
+{
+  // Returns the numeric parameter or the default value
+  // for missing or zero parameters
+
+  if ( index >= parameter.size() || parameter[index] <= 0 )
+    return default_value;
+
+  return parameter[index];
+}
+
+//----------------------------------------------------------------------
+inline wchar_t& FSystemHeadless::cell (int x, int y)
+{
+  return screen[std::size_t(y) * width + std::size_t(x)];
+}
+
+}  // namespace finalcut
@@ -34,6 +34,7 @@
 #include "final/fmouse.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/fpoll.h"
 #include "final/fstartoptions.h"
 #include "final/fstring.h"
 #include "final/fsystemimpl.h"
@@ -46,6 +47,7 @@
 #include "final/ftermdetection.h"
 #include "final/ftermios.h"
 #include "final/ftermxterminal.h"
+#include "final/ftrace.h"
 
 #if defined(UNIT_TEST)
   #include "final/ftermlinux.h"
@@ -587,6 +589,12 @@ bool FTerm::hasAlternateScreen()
   return data->hasAlternateScreen();
 }
 
+//----------------------------------------------------------------------
+bool FTerm::hasSynchronizedOutput()
+{
+  return term_detection->hasSynchronizedOutput();
+}
+
 //----------------------------------------------------------------------
 bool FTerm::canChangeColorPalette()
 {
@@ -1194,6 +1202,11 @@ FTerm::defaultPutChar& FTerm::putchar()
 //----------------------------------------------------------------------
 void FTerm::putstring (const char str[], int affcnt)
 {
+  // The frames of the output writer thread must be written
+  // completely before the direct terminal output
+  if ( FVTerm::isAsyncOutput() )
+    FVTerm::completeOutput();
+
   if ( ! fsys )
     getFSystem();
 
@@ -1322,7 +1335,8 @@ void FTerm::init_global_values (bool disable_alt_screen)
   // Initialize xterm object
   xterm->init();
 
-  if ( ! getStartOptions().terminal_detection )
+  if ( ! getStartOptions().terminal_detection
+    || ! fsys->canQueryTerminal() )
     term_detection->setTerminalDetection (false);
 
 #if DEBUG
@@ -1590,6 +1604,8 @@ void FTerm::init_optiMove()
     TCAP(fc::t_repeat_char),
     TCAP(fc::t_clr_bol),
     TCAP(fc::t_clr_eol),
+    TCAP(fc::t_parm_ich),
+    TCAP(fc::t_parm_dch),
     FTermcap::tabstop,
     FTermcap::automatic_left_margin,
     FTermcap::eat_nl_glitch
@@ -1846,7 +1862,8 @@ void FTerm::init_captureFontAndTitle()
 {
   // Save the used xterm font and window title
 
-  if ( ! FStartOptions::getFStartOptions().terminal_data_request )
+  if ( ! FStartOptions::getFStartOptions().terminal_data_request
+    || ! fsys->canQueryTerminal() )
     return;
 
   xterm->captureFontAndTitle();
@@ -2540,6 +2557,7 @@ void FTerm::signal_handler (int signum)
 
       // initialize a resize event to the root element
       data->setTermResized(true);
+      FPoll::wakeUp();  // Ends the event loop wait
       break;
 
     case SIGTERM:
@@ -2548,6 +2566,8 @@ void FTerm::signal_handler (int signum)
     case SIGABRT:
     case SIGILL:
     case SIGSEGV:
+      // The trace dump only uses open() and write()
+      FTrace::dump();
       init_term_object->finish();
       std::fflush (stderr);
       std::fflush (stdout);
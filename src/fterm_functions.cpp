@@ -351,16 +351,16 @@ FString getHalfWidth (const FString& str)
 FString getColumnSubString ( const FString& str
                            , std::size_t col_pos, std::size_t col_len )
 {
-  FString s(str);
   std::size_t col_first{1}, col_num{0}, first{1}, num{0};
+  bool cut_left{false}, cut_right{false};
 
-  if ( col_len == 0 || s.isEmpty() )
+  if ( col_len == 0 || str.isEmpty() )
     return FString(L"");
 
   if ( col_pos == 0 )
     col_pos = 1;
 
-  for (auto&& ch : s)
+  for (auto&& ch : str)
   {
     std::size_t width = getColumnWidth(ch);
 
@@ -373,7 +373,7 @@ FString getColumnSubString ( const FString& str
       }
       else
       {
-        ch = fc::SingleLeftAngleQuotationMark;  // ‹
+        cut_left = true;
         num = col_num = 1;
         col_pos = col_first;
       }
@@ -387,7 +387,7 @@ FString getColumnSubString ( const FString& str
       }
       else if ( col_num < col_len )
       {
-        ch = fc::SingleRightAngleQuotationMark;  // ›
+        cut_right = true;
         num++;
         break;
       }
@@ -397,7 +397,16 @@ FString getColumnSubString ( const FString& str
   if ( col_first < col_pos )  // String length < col_pos
     return FString(L"");
 
-  return s.mid(first, num);
+  FString s(str.mid(first, num));
+
+  // Mark the cut full-width characters
+  if ( cut_left )
+    s[0] = fc::SingleLeftAngleQuotationMark;  // ‹
+
+  if ( cut_right )
+    s[num - 1] = fc::SingleRightAngleQuotationMark;  // ›
+
+  return s;
 }
 
 //----------------------------------------------------------------------
@@ -342,6 +342,8 @@ FTermcap::tcap_map FTermcap::strings[] =
   { nullptr, "ip" },  // insert_padding         -> insert padding after inserted character
   { nullptr, "ic" },  // insert_character       -> insert character (P)
   { nullptr, "IC" },  // parm_ich               -> insert #1 characters (P*)
+  { nullptr, "dc" },  // delete_character       -> delete character (P*)
+  { nullptr, "DC" },  // parm_dch               -> delete #1 characters (P*)
   { nullptr, "rp" },  // repeat_char            -> repeat char #1 #2 times (P*)
   { nullptr, "Ic" },  // initialize_color       -> initialize color #1 to (#2,#3,#4)
   { nullptr, "Ip" },  // initialize_pair        -> Initialize color pair #1 to
@@ -374,6 +376,13 @@ FTermcap::tcap_map FTermcap::strings[] =
   { nullptr, "Ss" },  // set cursor style       -> Select the DECSCUSR cursor style
   { nullptr, "sf" },  // scroll_forward         -> scroll text up (P)
   { nullptr, "sr" },  // scroll_reverse         -> scroll text down (P)
+  { nullptr, "SF" },  // parm_index             -> scroll forward #1 lines (P)
+  { nullptr, "SR" },  // parm_rindex            -> scroll back #1 lines (P)
+  { nullptr, "cs" },  // change_scroll_region   -> change region to line #1 to line #2 (P)
+  { nullptr, "al" },  // insert_line            -> insert line (P*)
+  { nullptr, "dl" },  // delete_line            -> delete line (P*)
+  { nullptr, "AL" },  // parm_insert_line       -> insert #1 lines (P*)
+  { nullptr, "DL" },  // parm_delete_line       -> delete #1 lines (P*)
   { nullptr, "ti" },  // enter_ca_mode          -> string to start programs using cup
   { nullptr, "te" },  // exit_ca_mode           -> strings to end programs using cup
   { nullptr, "eA" },  // enable_acs             -> enable alternate char set
@@ -53,6 +53,7 @@ FSystem*       FTermDetection::fsystem{nullptr};
 char           FTermDetection::termtype[256]{};
 char           FTermDetection::ttytypename[256]{};
 bool           FTermDetection::decscusr_support{};
+bool           FTermDetection::sync_output_support{};
 bool           FTermDetection::terminal_detection{};
 bool           FTermDetection::color256{};
 const FString* FTermDetection::answer_back{nullptr};
@@ -79,6 +80,7 @@ FTermDetection::FTermDetection()
 
   // Preset to false
   decscusr_support = false;
+  sync_output_support = false;
 
   // Gnome terminal id from SecDA
   // Example: vte version 0.40.0 = 0 * 100 + 40 * 100 + 0 = 4000
@@ -355,6 +357,9 @@ void FTermDetection::detectTerminal()
     // Identify the terminal via the secondary device attributes (SEC_DA)
     new_termtype = parseSecDA (new_termtype);
 
+    // Query the support of the synchronized output mode
+    parseSynchronizedOutput();
+
     // Determines the maximum number of colors
     new_termtype = determineMaxColor(new_termtype);
 
@@ -1016,4 +1021,61 @@ inline char* FTermDetection::secDA_Analysis_vte (char current_termtype[])
   return new_termtype;
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::parseSynchronizedOutput()
+{
+  // The Linux console and older cygwin terminals knows no DECRQM
+  if ( isLinuxTerm() || isCygwinTerminal() )
+    return;
+
+  // Mode 2026 is recognized if it is set (1) or reset (2)
+  const int mode = getSynchronizedOutputMode();
+  sync_output_support = ( mode == 1 || mode == 2 );
+}
+
+//----------------------------------------------------------------------
+int FTermDetection::getSynchronizedOutputMode()
+{
+  // Requests the DEC private mode 2026 (DECRQM) followed by the
+  // primary device attributes. Every terminal answers the device
+  // attributes, so there is no timeout if DECRQM is unknown.
+
+  static constexpr char request[] = CSI "?2026$p" CSI "c";
+  int mode{0};
+  const int stdin_no{FTermios::getStdIn()};
+  const int stdout_no{FTermios::getStdOut()};
+  fd_set ifds{};
+  struct timeval tv{};
+
+  if ( ! fsystem )
+    return 0;
+
+  // The buffered output must reach the terminal before the request
+  std::fflush(stdout);
+
+  const ssize_t ret = fsystem->write ( stdout_no, request
+                                     , std::strlen(request) );
+
+  if ( ret == -1 )
+    return 0;
+
+  FD_ZERO(&ifds);
+  FD_SET(stdin_no, &ifds);
+  tv.tv_sec  = 0;
+  tv.tv_usec = 150000;  // 150 ms
+
+  // Read the mode report (CSI ? 2026 ; Ps $ y) and
+  // skip the device attributes that follow it
+  if ( select (stdin_no + 1, &ifds, nullptr, nullptr, &tv) == 1 )
+  {
+    if ( std::scanf("\033[?2026;%1d$y", &mode) != 1 )
+      mode = 0;
+
+    if ( std::scanf("%*[^c]") == EOF || std::getchar() == EOF )
+      mode = 0;
+  }
+
+  return mode;
+}
+
 }  // namespace finalcut
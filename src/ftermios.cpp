@@ -73,7 +73,7 @@ termios FTermios::getTTY()
 {
   struct termios t{};
 
-  if ( tcgetattr(stdin_no, &t) == -1 )
+  if ( FTerm::getFSystem()->tcgetattr(stdin_no, &t) == -1 )
     throw std::runtime_error("Cannot find tty");
 
   return t;
@@ -82,7 +82,7 @@ termios FTermios::getTTY()
 //----------------------------------------------------------------------
 void FTermios::setTTY (const termios& t)
 {
-  tcsetattr (stdin_no, TCSADRAIN, &t);
+  FTerm::getFSystem()->tcsetattr (stdin_no, TCSADRAIN, &t);
 }
 
 //----------------------------------------------------------------------
@@ -111,7 +111,7 @@ void FTermios::setHardwareEcho()
 {
   // Info under: man 3 termios
   struct termios t{};
-  tcgetattr (stdin_no, &t);
+  FTerm::getFSystem()->tcgetattr (stdin_no, &t);
 
   // local mode
   t.c_lflag &= uInt(ECHO | ECHONL);
@@ -131,7 +131,7 @@ void FTermios::unsetHardwareEcho()
 {
   // Info under: man 3 termios
   struct termios t{};
-  tcgetattr (stdin_no, &t);
+  FTerm::getFSystem()->tcgetattr (stdin_no, &t);
 
   // local mode
   t.c_lflag &= uInt(~(ECHO | ECHONL));
@@ -150,18 +150,18 @@ void FTermios::unsetHardwareEcho()
 void FTermios::setCaptureSendCharacters()
 {
   struct termios t{};
-  tcgetattr (stdin_no, &t);
+  FTerm::getFSystem()->tcgetattr (stdin_no, &t);
   t.c_lflag &= uInt(~(ICANON | ECHO));
   t.c_cc[VTIME] = 1;  // Timeout in deciseconds
   t.c_cc[VMIN]  = 0;  // Minimum number of characters
-  tcsetattr (stdin_no, TCSANOW, &t);
+  FTerm::getFSystem()->tcsetattr (stdin_no, TCSANOW, &t);
 }
 
 //----------------------------------------------------------------------
 void FTermios::unsetCaptureSendCharacters()
 {
   struct termios t{};
-  tcgetattr (stdin_no, &t);
+  FTerm::getFSystem()->tcgetattr (stdin_no, &t);
   t.c_lflag |= uInt(ICANON | ECHO);
   t.c_cc[VTIME] = 0;  // Timeout in deciseconds
   t.c_cc[VMIN]  = 1;  // Minimum number of characters
@@ -177,7 +177,7 @@ bool FTermios::setRawMode (bool enable)
 
   // Info under: man 3 termios
   struct termios t{};
-  tcgetattr (stdin_no, &t);
+  FTerm::getFSystem()->tcgetattr (stdin_no, &t);
 
   if ( enable )
   {
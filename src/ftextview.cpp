@@ -156,6 +156,8 @@ void FTextView::scrollTo (int x, int y)
     }
   }
 
+  const int xoffset_before = xoffset;
+
   if ( changeY && isVerticallyScrollable() )
   {
     const int yoffset_end = int(getRows() - getTextHeight());
@@ -174,8 +176,26 @@ void FTextView::scrollTo (int x, int y)
     }
   }
 
-  drawText();
-  updateTerminal();
+  const int text_height = int(getTextHeight());
+  const int dy = yoffset - last_yoffset;
+
+  if ( last_yoffset >= 0 && xoffset == xoffset_before
+    && dy != 0 && std::abs(dy) < text_height )
+  {
+    // speed up: scroll the text and draw only the exposed lines
+    const FRect box ( getTermX() + 1, getTermY() + 1 - nf_offset
+                    , getTextWidth(), getTextHeight() );
+    scrollArea (box, dy);
+
+    if ( dy > 0 )
+      drawText (std::size_t(text_height - dy), std::size_t(dy));
+    else
+      drawText (0, std::size_t(-dy));
+  }
+  else
+    drawText();
+
+  requestTerminalUpdate();
 }
 
 //----------------------------------------------------------------------
@@ -236,6 +256,7 @@ void FTextView::insert (const FString& str, int pos)
 
   auto iter = data.begin();
   data.insert (iter + pos, text_split.begin(), text_split.end());
+  last_yoffset = -1;  // The drawn text is no longer valid
   const int vmax = ( getRows() > getTextHeight() )
                    ? int(getRows()) - int(getTextHeight())
                    : 0;
@@ -260,6 +281,7 @@ void FTextView::replaceRange (const FString& str, int from, int to)
 
   auto iter = data.begin();
   data.erase (iter + from, iter + to + 1);
+  last_yoffset = -1;
 
   if ( ! str.isNull() )
     insert(str, from);
@@ -272,6 +294,7 @@ void FTextView::clear()
   data.shrink_to_fit();
   xoffset = 0;
   yoffset = 0;
+  last_yoffset = -1;
   maxLineWidth = 0;
 
   vbar->setMinimum(0);
@@ -484,6 +507,7 @@ void FTextView::adjustSize()
   const std::size_t width = getWidth();
   const std::size_t height = getHeight();
   const int last_line = int(getRows());
+  last_yoffset = -1;
   const int max_width = int(maxLineWidth);
 
   if ( xoffset >= max_width - int(width) - nf_offset )
@@ -639,10 +663,18 @@ void FTextView::drawScrollbars()
 //----------------------------------------------------------------------
 void FTextView::drawText()
 {
+  drawText (0, getTextHeight());
+}
+
+//----------------------------------------------------------------------
+void FTextView::drawText (std::size_t start, std::size_t count)
+{
+  // Draws count visible text lines from the line start
+
   if ( data.empty() || getHeight() <= 2 || getWidth() <= 2 )
     return;
 
-  auto num = getTextHeight();
+  auto num = std::min(start + count, getTextHeight());
 
   if ( num > getRows() )
     num = getRows();
@@ -652,7 +684,7 @@ void FTextView::drawText()
   if ( isMonochron() )
     setReverse(true);
 
-  for (std::size_t y{0}; y < num; y++)  // Line loop
+  for (std::size_t y = start; y < num; y++)  // Line loop
   {
     const std::size_t n = std::size_t(yoffset) + y;
     const std::size_t pos = std::size_t(xoffset) + 1;
@@ -675,11 +707,13 @@ void FTextView::drawText()
     if ( column_width <= text_width )
       trailing_whitespace = text_width - column_width;
 
-    print() << FString(trailing_whitespace, L' ');
+    printRepeated (this, L' ', trailing_whitespace);
   }
 
   if ( isMonochron() )
     setReverse(false);
+
+  last_yoffset = yoffset;
 }
 
 //----------------------------------------------------------------------
@@ -0,0 +1,292 @@
+/***********************************************************************
+* fthreadpool.cpp - Runs jobs in background threads                    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <utility>
+
+#include "final/fapplication.h"
+#include "final/fthreadpool.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr std::size_t FThreadPool::MAX_THREADS;
+thread_local FThreadPool*           FThreadPool::current_pool{nullptr};
+thread_local std::size_t            FThreadPool::current_worker{0};
+thread_local FThreadPool::FJobState* FThreadPool::current_job{nullptr};
+
+
+//----------------------------------------------------------------------
+// class FThreadPool
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FThreadPool::FThreadPool (std::size_t thread_count)
+{
+  // A thread count of 0 uses one thread per processor (at most 4)
+
+  if ( thread_count == 0 )
+  {
+    thread_count = std::thread::hardware_concurrency();
+    thread_count = std::max(std::min(thread_count, MAX_THREADS), std::size_t(1));
+  }
+
+  for (std::size_t i{0}; i < thread_count; i++)
+    workers.emplace_back(new FWorker);
+
+  for (std::size_t i{0}; i < thread_count; i++)
+    workers[i]->thread = std::thread(&FThreadPool::run, this, i);
+}
+
+//----------------------------------------------------------------------
+FThreadPool::~FThreadPool()  // destructor
+{
+  // Running jobs should end soon after isCanceled() returns true
+
+  cancelAll();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    terminate = true;
+  }
+
+  job_available.notify_all();
+
+  for (auto&& worker : workers)
+    if ( worker->thread.joinable() )
+      worker->thread.join();
+}
+
+
+// public methods of FThreadPool
+//----------------------------------------------------------------------
+std::size_t FThreadPool::getJobCount()
+{
+  // Returns the number of submitted jobs that are not finished
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return job_list.size();
+}
+
+//----------------------------------------------------------------------
+bool FThreadPool::isCanceled()
+{
+  // Called by a running job to check whether it should stop early
+
+  return current_job && current_job->canceled.load();
+}
+
+//----------------------------------------------------------------------
+bool FThreadPool::submit ( const FObject* owner
+                         , FJobFunction work
+                         , FJobFunction done )
+{
+  // Runs work in a worker thread and then done in the event loop.
+  // A job submitted by another job stays in the queue of its worker.
+
+  if ( ! work || workers.empty() )
+    return false;
+
+  auto state = std::make_shared<FJobState>();
+  state->owner = owner;
+  const std::size_t index = ( current_pool == this )
+                          ? current_worker
+                          : next_worker++ % workers.size();
+
+  FJob job{};
+  job.state = state;
+  job.work = std::move(work);
+  job.done = std::move(done);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if ( terminate )
+      return false;
+
+    job_list.push_back(state);
+    workers[index]->job_queue.push_back(std::move(job));
+  }
+
+  job_available.notify_one();
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FThreadPool::cancel (const FObject* owner)
+{
+  // Cancels all jobs of owner; their done functions are not called.
+  // Waits until the running work functions of owner have returned,
+  // so that owner can be destroyed afterwards. A long work function
+  // should therefore check isCanceled() regularly.
+  // (must be called in the event loop thread)
+
+  std::unique_lock<std::mutex> lock(mutex);
+  std::vector<FJobStatePtr> canceled_jobs{};
+  auto iter = std::remove_if ( job_list.begin()
+                             , job_list.end()
+                             , [owner, &canceled_jobs] (const FJobStatePtr& state)
+                               {
+                                 if ( state->owner != owner )
+                                   return false;
+
+                                 state->canceled = true;
+                                 canceled_jobs.push_back(state);
+                                 return true;
+                               } );
+  job_list.erase(iter, job_list.end());
+
+  // A job that cancels its own owner does not wait for itself
+  job_finished.wait ( lock, [&canceled_jobs] ()
+                            {
+                              return std::none_of ( canceled_jobs.begin()
+                                                  , canceled_jobs.end()
+                                                  , [] (const FJobStatePtr& state)
+                                                    {
+                                                      return state->running
+                                                          && state.get() != current_job;
+                                                    } );
+                            } );
+  return ! canceled_jobs.empty();
+}
+
+//----------------------------------------------------------------------
+void FThreadPool::cancelAll()
+{
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for (auto&& state : job_list)
+    state->canceled = true;
+
+  job_list.clear();
+}
+
+
+// private methods of FThreadPool
+//----------------------------------------------------------------------
+void FThreadPool::run (std::size_t index)
+{
+  current_pool = this;
+  current_worker = index;
+
+  while ( true )
+  {
+    FJob job{};
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      job_available.wait ( lock, [this, index, &job] ()
+                                 {
+                                   return terminate || takeJob(index, job);
+                                 } );
+
+      if ( terminate )
+        return;
+
+      job.state->running = ! job.state->canceled;
+    }
+
+    runJob (job);
+  }
+}
+
+//----------------------------------------------------------------------
+bool FThreadPool::takeJob (std::size_t index, FJob& job)
+{
+  // Must be called with the locked pool mutex
+
+  // The oldest job of the own queue
+  auto& worker = *workers[index];
+
+  if ( ! worker.job_queue.empty() )
+  {
+    job = std::move(worker.job_queue.front());
+    worker.job_queue.pop_front();
+    return true;
+  }
+
+  for (std::size_t n{1}; n < workers.size(); n++)
+  {
+    // Steals the newest job of another queue
+    auto& victim = *workers[(index + n) % workers.size()];
+
+    if ( ! victim.job_queue.empty() )
+    {
+      job = std::move(victim.job_queue.back());
+      victim.job_queue.pop_back();
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FThreadPool::runJob (FJob& job)
+{
+  if ( job.state->running )  // Only written by this worker
+  {
+    current_job = job.state.get();
+    job.work();
+    current_job = nullptr;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      job.state->running = false;
+    }
+
+    job_finished.notify_all();
+  }
+
+  if ( ! job.done || job.state->canceled )
+  {
+    finishJob (job.state);
+    return;
+  }
+
+  // The job stays in the job list until done is called,
+  // because its owner can be destroyed in the meantime
+  const auto state = job.state;
+  auto done = std::move(job.done);
+  FApplication::postTask ( [this, state, done] ()
+                           {
+                             if ( state->canceled )
+                               return;
+
+                             finishJob (state);
+                             done();
+                           } );
+}
+
+//----------------------------------------------------------------------
+void FThreadPool::finishJob (const FJobStatePtr& state)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  auto iter = std::find(job_list.begin(), job_list.end(), state);
+
+  if ( iter != job_list.end() )
+    job_list.erase(iter);
+}
+
+}  // namespace finalcut
@@ -20,12 +20,12 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#include <utility>
-
 #include "final/fapplication.h"
 #include "final/fbuttongroup.h"
+#include "final/fcheckbox.h"
 #include "final/fevent.h"
 #include "final/fpoint.h"
+#include "final/fradiobutton.h"
 #include "final/fstatusbar.h"
 #include "final/ftogglebutton.h"
 #include "final/fwidget.h"
@@ -373,13 +373,14 @@ void FToggleButton::setHotkeyAccelerator()
 //----------------------------------------------------------------------
 bool FToggleButton::isRadioButton() const
 {
-  return isInstanceOf("FRadioButton");
+  // A type check is cheaper than a class name comparison
+  return bool( dynamic_cast<const FRadioButton*>(this) );
 }
 
 //----------------------------------------------------------------------
 bool FToggleButton::isCheckboxButton() const
 {
-  return isInstanceOf("FCheckBox");
+  return bool( dynamic_cast<const FCheckBox*>(this) );
 }
 
 //----------------------------------------------------------------------
@@ -411,11 +412,9 @@ void FToggleButton::drawLabel()
   if ( text.isNull() || text.isEmpty() )
     return;
 
-  const FString txt(text);
-  FString label_text{};
-  auto hotkeypos = finalcut::getHotkeyPos(txt, label_text);
+  auto hotkeypos = finalcut::getHotkeyPos(text, label_text);
   print() << FPoint(1 + int(label_offset_pos), 1);
-  drawText (std::move(label_text), hotkeypos);
+  drawText (label_text, hotkeypos);
 }
 
 //----------------------------------------------------------------------
@@ -520,7 +519,7 @@ void FToggleButton::init()
 }
 
 //----------------------------------------------------------------------
-void FToggleButton::drawText (FString&& label_text, std::size_t hotkeypos)
+void FToggleButton::drawText (const FString& label_text, std::size_t hotkeypos)
 {
   if ( isMonochron() )
     setReverse(true);
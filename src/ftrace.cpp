@@ -0,0 +1,348 @@
+/***********************************************************************
+* ftrace.cpp - Records a timeline of the event loop                    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+
+#include "final/emptyfstring.h"
+#include "final/fobject.h"
+#include "final/fpoll.h"
+#include "final/ftrace.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr std::size_t            FTrace::BUFFER_SIZE;
+std::vector<FTrace::FTraceEvent> FTrace::ring{};
+std::size_t                      FTrace::next{0};
+std::size_t                      FTrace::count{0};
+FString                          FTrace::filename{};
+std::string                      FTrace::file_path{};
+uInt64                           FTrace::start_time{0};
+bool                             FTrace::enabled{false};
+volatile std::sig_atomic_t       FTrace::dump_requested{0};
+struct sigaction                 FTrace::previous_action{};
+
+
+//----------------------------------------------------------------------
+// class FTrace
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTrace::FTrace()
+{ }
+
+//----------------------------------------------------------------------
+FTrace::~FTrace()  // destructor
+{ }
+
+
+// public methods of FTrace
+//----------------------------------------------------------------------
+uInt64 FTrace::getTimeStamp()
+{
+  // Monotonic time in nanoseconds (also for the frame statistics)
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return uInt64(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+}
+
+//----------------------------------------------------------------------
+void FTrace::start (const FString& file, std::size_t capacity)
+{
+  // Records the spans in a ring buffer with capacity entries.
+  // The oldest spans are overwritten when the buffer is full.
+
+  if ( capacity == 0 )
+    capacity = DEFAULT_CAPACITY;
+
+  try
+  {
+    ring.resize(capacity);
+  }
+  catch (const std::bad_alloc& ex)
+  {
+    std::cerr << bad_alloc_str << ex.what() << std::endl;
+    return;
+  }
+
+  try
+  {
+    // The dump must not convert the file name in a signal handler
+    file_path = ( file.isEmpty() ) ? std::string{} : file.c_str();
+  }
+  catch (const std::bad_alloc& ex)
+  {
+    std::cerr << bad_alloc_str << ex.what() << std::endl;
+    return;
+  }
+
+  // Dumps the spans on SIGUSR1. The handler of the application
+  // is kept for stop(), also when the trace is restarted.
+  struct sigaction action{};
+  action.sa_handler = FTrace::signal_handler;
+  sigemptyset (&action.sa_mask);
+  sigaction (SIGUSR1, &action, ( enabled ) ? nullptr : &previous_action);
+
+  filename = file;
+  next = 0;
+  count = 0;
+  start_time = getTimeStamp();
+  dump_requested = 0;
+  enabled = true;
+}
+
+//----------------------------------------------------------------------
+void FTrace::stop()
+{
+  if ( ! enabled )
+    return;
+
+  sigaction (SIGUSR1, &previous_action, nullptr);
+  enabled = false;
+  dump_requested = 0;
+  std::vector<FTraceEvent>().swap(ring);
+  next = 0;
+  count = 0;
+}
+
+//----------------------------------------------------------------------
+void FTrace::addEvent ( const char* name, const char* category
+                      , const void* object, uInt64 begin, uInt64 end )
+{
+  if ( ! enabled || ring.empty() )
+    return;
+
+  auto& event = ring[next];
+  std::strncpy (event.name, name, MAX_NAME_LENGTH);
+  event.name[MAX_NAME_LENGTH] = '\0';
+  event.category = category;
+  event.object = object;
+  event.start = ( begin > start_time ) ? begin - start_time : 0;
+  event.duration = ( end > begin ) ? end - begin : 0;
+  next++;
+
+  if ( next == ring.size() )
+    next = 0;
+
+  if ( count < ring.size() )
+    count++;
+}
+
+//----------------------------------------------------------------------
+bool FTrace::dump()
+{
+  // Writes the recorded spans in the Chrome trace event format
+  // (open it with chrome://tracing or https://ui.perfetto.dev).
+  // Only async-signal-safe functions are used, so that the spans
+  // can also be written from the handler of a fatal signal.
+
+  dump_requested = 0;
+
+  if ( ! enabled || file_path.empty() )
+    return false;
+
+  FTraceOutput out;
+  out.fd = ::open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  out.length = 0;
+  out.error = false;
+
+  if ( out.fd < 0 )
+    return false;
+
+  const int pid = int(getpid());
+  write (out, "{\"traceEvents\":[\n"
+              "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":");
+  writeNumber (out, uInt64(pid));
+  write (out, ",\"tid\":1,\"args\":{\"name\":\"event loop\"}}");
+
+  // The oldest span is at the next write position of a full ring
+  const std::size_t first = ( count < ring.size() ) ? 0 : next;
+
+  for (std::size_t i{0}; i < count; i++)
+    writeEvent (out, ring[(first + i) % ring.size()], pid);
+
+  write (out, "\n],\"displayTimeUnit\":\"ns\"}\n");
+  flushOutput (out);
+  const bool closed = ( ::close(out.fd) == 0 );
+  return ! out.error && closed;
+}
+
+
+// private methods of FTrace
+//----------------------------------------------------------------------
+void FTrace::writeEvent (FTraceOutput& out, const FTraceEvent& event, int pid)
+{
+  write (out, ",\n{\"name\":\"");
+
+  // JSON string escaping
+  for (const char* p = event.name; *p; p++)
+  {
+    const auto ch = uChar(*p);
+
+    if ( ch == '"' || ch == '\\' )
+    {
+      write (out, '\\');
+      write (out, char(ch));
+    }
+    else if ( ch < 0x20 )
+    {
+      write (out, "\\u");
+      writeNumber (out, ch, 16, 4);
+    }
+    else
+      write (out, char(ch));
+  }
+
+  write (out, "\",\"cat\":\"");
+  write (out, event.category ? event.category : "");
+  write (out, "\",\"ph\":\"X\",\"pid\":");
+  writeNumber (out, uInt64(pid));
+
+  // Timestamps in microseconds
+  write (out, ",\"tid\":1,\"ts\":");
+  writeNumber (out, event.start / 1000);
+  write (out, '.');
+  writeNumber (out, event.start % 1000, 10, 3);
+  write (out, ",\"dur\":");
+  writeNumber (out, event.duration / 1000);
+  write (out, '.');
+  writeNumber (out, event.duration % 1000, 10, 3);
+
+  if ( event.object )
+  {
+    write (out, ",\"args\":{\"object\":\"0x");
+    writeNumber (out, uInt64(reinterpret_cast<uintptr_t>(event.object)), 16);
+    write (out, "\"}");
+  }
+
+  write (out, '}');
+}
+
+//----------------------------------------------------------------------
+void FTrace::write (FTraceOutput& out, const char* string)
+{
+  while ( *string )
+    write (out, *string++);
+}
+
+//----------------------------------------------------------------------
+void FTrace::write (FTraceOutput& out, char ch)
+{
+  if ( out.length == BUFFER_SIZE )
+    flushOutput (out);
+
+  out.data[out.length] = ch;
+  out.length++;
+}
+
+//----------------------------------------------------------------------
+void FTrace::writeNumber ( FTraceOutput& out, uInt64 number
+                         , uInt base, std::size_t min_digits )
+{
+  // Writes the number without the locale-dependent printf family
+  static constexpr char digit_char[] = "0123456789abcdef";
+  char digits[24]{};
+  std::size_t n{0};
+
+  do
+  {
+    digits[n] = digit_char[number % base];
+    number /= base;
+    n++;
+  }
+  while ( number > 0 || n < min_digits );
+
+  while ( n > 0 )
+  {
+    n--;
+    write (out, digits[n]);
+  }
+}
+
+//----------------------------------------------------------------------
+void FTrace::flushOutput (FTraceOutput& out)
+{
+  const char* data = out.data;
+
+  while ( out.length > 0 && ! out.error )
+  {
+    const ssize_t bytes = ::write(out.fd, data, out.length);
+
+    if ( bytes < 0 && errno == EINTR )
+      continue;
+
+    if ( bytes <= 0 )
+    {
+      out.error = true;
+      break;
+    }
+
+    data += bytes;
+    out.length -= std::size_t(bytes);
+  }
+
+  out.length = 0;
+}
+
+//----------------------------------------------------------------------
+void FTrace::signal_handler (int)
+{
+  // The event loop dumps the spans at the next opportunity,
+  // so that a dump does not interrupt a span update
+  dump_requested = 1;
+  FPoll::wakeUp();
+}
+
+
+//----------------------------------------------------------------------
+// class FTraceScope
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTraceScope::FTraceScope (const FObject* obj, const char* c)
+{
+  // Records the span of an object method under the class name
+
+  if ( ! FTrace::isEnabled() || ! obj )
+    return;
+
+  const FString class_name(obj->getClassName());
+  std::strncpy (object_name, class_name.c_str(), FTrace::MAX_NAME_LENGTH);
+  object_name[FTrace::MAX_NAME_LENGTH] = '\0';
+  name = object_name;
+  category = c;
+  object = obj;
+  start = FTrace::getTimeStamp();
+}
+
+}  // namespace finalcut
@@ -20,8 +20,11 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#include <queue>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include "final/fapplication.h"
@@ -31,12 +34,17 @@
 #include "final/fkeyboard.h"
 #include "final/foptiattr.h"
 #include "final/foptimove.h"
+#include "final/foutputmonitor.h"
+#include "final/foutputwriter.h"
+#include "final/fpoll.h"
 #include "final/fstyle.h"
 #include "final/fsystem.h"
 #include "final/fterm.h"
 #include "final/ftermdata.h"
 #include "final/ftermbuffer.h"
 #include "final/ftermcap.h"
+#include "final/ftermios.h"
+#include "final/ftrace.h"
 #include "final/ftypes.h"
 #include "final/fvterm.h"
 #include "final/fwidget.h"
@@ -53,13 +61,31 @@ bool                 FVTerm::terminal_update_complete{false};
 bool                 FVTerm::terminal_update_pending{false};
 bool                 FVTerm::force_terminal_update{false};
 bool                 FVTerm::stop_terminal_updates{false};
+bool                 FVTerm::window_map_changed{true};
 int                  FVTerm::skipped_terminal_update{};
 uInt                 FVTerm::erase_char_length{};
 uInt                 FVTerm::repeat_char_length{};
 uInt                 FVTerm::clr_bol_length{};
 uInt                 FVTerm::clr_eol_length{};
+uInt                 FVTerm::insert_char_length{};
+uInt                 FVTerm::delete_char_length{};
 uInt                 FVTerm::cursor_address_length{};
-std::queue<int>*     FVTerm::output_buffer{nullptr};
+std::string*         FVTerm::output_buffer{nullptr};
+FOutputWriter*       FVTerm::output_writer{nullptr};
+FOutputMonitor*      FVTerm::output_monitor{nullptr};
+std::size_t          FVTerm::output_buffer_size{DEFAULT_OUTPUT_BUFFER_SIZE};
+uInt64               FVTerm::frame_interval{0};
+uInt64               FVTerm::move_throughput{0};
+timeval              FVTerm::last_frame_time{};
+FVTerm::FFrameStatistics FVTerm::frame_statistics{};
+FVTerm::FFrameStatistics FVTerm::last_frame_statistics{};
+FVTerm::output_flush FVTerm::flush_policy{FVTerm::flush_on_overflow};
+std::vector<FVTerm::FTermArea*>* FVTerm::window_map{nullptr};
+FVTerm::FWindowStateList* FVTerm::window_map_state{nullptr};
+std::vector<FVTerm::FLineHash>* FVTerm::line_hash{nullptr};
+std::vector<FVTerm::FLineHashCount>* FVTerm::line_hash_count{nullptr};
+std::vector<FChar>*  FVTerm::terminal_data{nullptr};
+FVTerm::FScrollRegion FVTerm::scroll_hint{-1, -1, 0};
 FPoint*              FVTerm::term_pos{nullptr};
 FSystem*             FVTerm::fsystem{nullptr};
 FTerm*               FVTerm::fterm{nullptr};
@@ -73,6 +99,18 @@ FChar                FVTerm::s_ch{};
 FChar                FVTerm::i_ch{};
 
 
+//----------------------------------------------------------------------
+// struct FVTerm::FWindowState
+//----------------------------------------------------------------------
+
+struct FVTerm::FWindowState  // window state of the window map
+{
+  FTermArea* area;
+  FRect geometry;  // Window geometry including the shadow
+  bool visible;
+};
+
+
 //----------------------------------------------------------------------
 // class FVTerm
 //----------------------------------------------------------------------
@@ -101,6 +139,53 @@ FVTerm& FVTerm::operator << (const FTermBuffer& term_buffer)
   return *this;
 }
 
+//----------------------------------------------------------------------
+FVTerm& FVTerm::operator << (wchar_t c)
+{
+  auto area = getPrintArea();
+
+  if ( area )
+    printNextCharacter (area, getNextCharacter(c));
+
+  return *this;
+}
+
+//----------------------------------------------------------------------
+FVTerm& FVTerm::operator << (const wchar_t* string)
+{
+  auto area = getPrintArea();
+
+  if ( string && area )
+    printString (area, string);
+
+  return *this;
+}
+
+//----------------------------------------------------------------------
+FVTerm& FVTerm::operator << (const char* string)
+{
+  if ( ! string )
+    return *this;
+
+  const char* p = string;
+
+  while ( *p && uChar(*p) < 0x80 )
+    p++;
+
+  if ( *p )  // Multibyte string
+  {
+    print (FString{string});
+    return *this;
+  }
+
+  auto area = getPrintArea();
+
+  if ( area )
+    printString (area, string);
+
+  return *this;
+}
+
 // public methods of FVTerm
 //----------------------------------------------------------------------
 FPoint FVTerm::getPrintCursor()
@@ -114,11 +199,35 @@ FPoint FVTerm::getPrintCursor()
   return FPoint(0, 0);
 }
 
+//----------------------------------------------------------------------
+uInt64 FVTerm::getOutputThroughput()
+{
+  // Returns the measured terminal output rate
+  // in bytes per second (0 = unknown)
+
+  if ( ! output_monitor )
+    return 0;
+
+  return output_monitor->getThroughput();
+}
+
 //----------------------------------------------------------------------
 void FVTerm::setTermXY (int x, int y)
 {
   // Sets the hardware cursor to the given (x,y) position
 
+  if ( term_pos->getX() == x && term_pos->getY() == y )
+    return;
+
+  appendCursorMove (x, y);
+  flush();
+}
+
+//----------------------------------------------------------------------
+void FVTerm::appendCursorMove (int x, int y)
+{
+  // Appends the cursor movement to (x,y) to the output buffer
+
   if ( term_pos->getX() == x && term_pos->getY() == y )
     return;
 
@@ -142,9 +251,12 @@ void FVTerm::setTermXY (int x, int y)
   const char* move_str = FTerm::moveCursorString (term_x, term_y, x, y);
 
   if ( move_str )
+  {
     appendOutputBuffer(move_str);
+    frame_statistics.cursor_moves++;
+    frame_statistics.cursor_move_bytes += std::strlen(move_str);
+  }
 
-  flush();
   term_pos->setPoint(x, y);
 }
 
@@ -171,6 +283,62 @@ void FVTerm::setPrintCursor (const FPoint& pos)
   }
 }
 
+//----------------------------------------------------------------------
+void FVTerm::setOutputBufferSize (std::size_t size)
+{
+  // Sets the number of bytes after which the output
+  // buffer is written out (with the flush_on_overflow policy)
+
+  if ( size == 0 )
+    size = DEFAULT_OUTPUT_BUFFER_SIZE;
+
+  output_buffer_size = size;
+
+  if ( ! output_buffer )
+    return;
+
+  if ( output_buffer->size() >= output_buffer_size )
+    flush();
+
+  output_buffer->reserve (output_buffer_size);
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::setAsyncOutput (bool enable)
+{
+  // With asynchronous output, a writer thread writes the frames
+  // to the terminal while the event loop continues
+
+  if ( enable == isAsyncOutput() )
+    return isAsyncOutput();
+
+  flush();
+
+  if ( enable )
+  {
+    try
+    {
+      output_writer = new FOutputWriter (fsystem, FTermios::getStdOut());
+    }
+    catch (const std::bad_alloc& ex)
+    {
+      std::cerr << bad_alloc_str << ex.what() << std::endl;
+      return false;
+    }
+    catch (const std::system_error&)
+    {
+      return false;  // No thread available - write synchronously
+    }
+  }
+  else
+  {
+    delete output_writer;  // Waits until all data has been written
+    output_writer = nullptr;
+  }
+
+  return isAsyncOutput();
+}
+
 //----------------------------------------------------------------------
 FColor FVTerm::rgb2ColorIndex (uInt8 r, uInt8 g, uInt8 b)
 {
@@ -206,6 +374,18 @@ void FVTerm::resizeVTerm (const FSize& size)
   const FRect box(0, 0, size.getWidth(), size.getHeight());
   const FSize shadow(0, 0);
   resizeArea (box, shadow, vterm);
+
+  // Rebuild the window map for the new terminal size
+  if ( window_map )
+    window_map->clear();
+
+  if ( line_hash )
+    line_hash->clear();
+
+  if ( terminal_data )
+    terminal_data->clear();
+
+  invalidateWindowMap();
 }
 
 //----------------------------------------------------------------------
@@ -213,8 +393,8 @@ void FVTerm::putVTerm()
 {
   for (int i{0}; i < vterm->height; i++)
   {
-    vterm->changes[i].xmin = 0;
-    vterm->changes[i].xmax = uInt(vterm->width - 1);
+    addLineChanges (vterm->changes[i], 0, uInt(vterm->width - 1));
+    markAsUnprinted (0, uInt(vterm->width - 1), uInt(i));
   }
 
   updateTerminal();
@@ -252,7 +432,12 @@ void FVTerm::updateTerminal()
     if ( ! terminal_update_complete )
       return;
 
-    if ( keyboard->isInputDataPending() )
+    // Combine the changes until the input is processed, the next
+    // frame is due and the previous frames have been written out
+    if ( keyboard->isInputDataPending()
+      || ! isFrameDue()
+      || isOutputPending()
+      || isOutputBacklogged() )
     {
       terminal_update_pending = true;
       return;
@@ -279,13 +464,50 @@ void FVTerm::updateTerminal()
   if ( ! vterm->has_changes )
     return;
 
+  // The terminal shows the frame after its completion
+  const bool sync_output = FTerm::hasSynchronizedOutput();
+
+  if ( sync_output )
+    appendOutputBuffer (CSI "?2026h");  // Begin synchronized update
+
+  // Move shifted lines with scroll sequences
+  scrollTerminalLines();
+
+  const uInt64 flush_time = frame_statistics.flush_time;
+  const uInt64 start = FTrace::getTimeStamp();
+
   for (uInt y{0}; y < uInt(vterm->height); y++)
     updateTerminalLine (y);
 
+  // Without the time of intermediate buffer flushes
+  frame_statistics.update_line_time += FTrace::getTimeStamp() - start
+                                     - (frame_statistics.flush_time - flush_time);
   vterm->has_changes = false;
 
+  // The terminal shows now the content of the virtual terminal
+  if ( line_hash )
+    for (auto&& line : *line_hash)
+      line.terminal = line.vterm;
+
   // sets the new input cursor position
   updateTerminalCursor();
+
+  if ( sync_output )
+    appendOutputBuffer (CSI "?2026l");  // End synchronized update
+
+  // Write the frame to the terminal
+  flush();
+  FObject::getMonotonicTime (&last_frame_time);
+  finishFrameStatistics();
+}
+
+//----------------------------------------------------------------------
+void FVTerm::requestTerminalUpdate()
+{
+  // Marks the virtual terminal as changed. The event loop
+  // writes the changes with the next frame.
+
+  terminal_update_pending = true;
 }
 
 //----------------------------------------------------------------------
@@ -343,28 +565,7 @@ int FVTerm::print (FTermArea* area, const FString& s)
   if ( s.isNull() || ! area )
     return -1;
 
-  std::vector<FChar> term_string{};
-  const wchar_t* p = s.wc_str();
-
-  if ( p )
-  {
-    while ( *p )
-    {
-      FChar nc{};  // next character
-      nc.ch           = *p;
-      nc.fg_color     = next_attribute.fg_color;
-      nc.bg_color     = next_attribute.bg_color;
-      nc.attr.byte[0] = next_attribute.attr.byte[0];
-      nc.attr.byte[1] = next_attribute.attr.byte[1];
-      nc.attr.byte[2] = 0;
-      term_string.push_back(nc);
-      p++;
-    }  // end of while
-
-    return print (area, term_string);
-  }
-
-  return 0;
+  return printString (area, s.wc_str());
 }
 
 //----------------------------------------------------------------------
@@ -406,7 +607,6 @@ int FVTerm::print (const std::vector<FChar>& term_string)
 int FVTerm::print (FTermArea* area, const std::vector<FChar>& term_string)
 {
   int len{0};
-  const uInt tabstop = uInt(getTabstop());
 
   if ( ! area )
     return -1;
@@ -416,42 +616,7 @@ int FVTerm::print (FTermArea* area, const std::vector<FChar>& term_string)
 
   for (auto&& fchar : term_string)
   {
-    bool printable_character{false};
-
-    switch ( fchar.ch )
-    {
-      case '\n':
-        area->cursor_y++;
-        // fall through
-      case '\r':
-        area->cursor_x = 1;
-        break;
-
-      case '\t':
-        area->cursor_x = int ( uInt(area->cursor_x)
-                             + tabstop
-                             - uInt(area->cursor_x)
-                             + 1
-                             % tabstop );
-        break;
-
-      case '\b':
-        area->cursor_x--;
-        break;
-
-      case '\a':
-        beep();
-        break;
-
-      default:
-      {
-        auto nc = fchar;  // next character
-        print (area, nc);
-        printable_character = true;
-      }
-    }
-
-    if ( ! printable_character && printWrap(area) )
+    if ( printNextCharacter(area, fchar) )
       break;  // end of area reached
 
     len++;
@@ -474,18 +639,10 @@ int FVTerm::print (wchar_t c)
 //----------------------------------------------------------------------
 int FVTerm::print (FTermArea* area, wchar_t c)
 {
-  FChar nc{};  // next character
-
   if ( ! area )
     return -1;
 
-  nc.ch           = wchar_t(c);
-  nc.fg_color     = next_attribute.fg_color;
-  nc.bg_color     = next_attribute.bg_color;
-  nc.attr.byte[0] = next_attribute.attr.byte[0];
-  nc.attr.byte[1] = next_attribute.attr.byte[1];
-  nc.attr.byte[2] = 0;
-
+  FChar nc = getNextCharacter(c);  // next character
   return print (area, nc);
 }
 
@@ -548,11 +705,7 @@ int FVTerm::print (FTermArea* area, FChar& term_char)
       // copy character to area
       std::memcpy (ac, &nc, sizeof(*ac));
 
-      if ( ax < int(area->changes[ay].xmin) )
-        area->changes[ay].xmin = uInt(ax);
-
-      if ( ax > int(area->changes[ay].xmax) )
-        area->changes[ay].xmax = uInt(ax);
+      addLineChanges (area->changes[ay], uInt(ax), uInt(ax));
     }
   }
 
@@ -627,19 +780,200 @@ void FVTerm::print (const FColorPair& pair)
   setColor (pair.getForegroundColor(), pair.getBackgroundColor());
 }
 
+//----------------------------------------------------------------------
+void FVTerm::scrollArea (const FRect& box, int n)
+{
+  // Scrolls the rectangle box of the print area n lines
+
+  scrollArea (getPrintArea(), box, n);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::scrollArea (FTermArea* area, const FRect& box, int n)
+{
+  // Scrolls the content of the terminal rectangle box inside the
+  // area n lines up (n > 0) or down (n < 0). The exposed lines are
+  // cleared and must be redrawn. If the rectangle is visible and
+  // uncovered, the next terminal update moves the lines with a
+  // scrolling region instead of a repaint.
+
+  if ( ! area || n == 0 )
+    return;
+
+  const int total_width = area->width + area->right_shadow;
+  const int ax = std::max(box.getX() - area->offset_left - 1, 0);
+  const int ay = std::max(box.getY() - area->offset_top - 1, 0);
+  const int ax_end = std::min ( box.getX() - area->offset_left - 1
+                                + int(box.getWidth())
+                              , area->width );
+  const int ay_end = std::min ( box.getY() - area->offset_top - 1
+                                + int(box.getHeight())
+                              , area->height );
+  const int length = ax_end - ax;
+  const int height = ay_end - ay;
+
+  if ( length <= 0 || height <= 0 )
+    return;
+
+  const int count = std::min(std::abs(n), height);
+  const int exposed_y = ( n > 0 ) ? ay_end - count : ay;
+
+  if ( n > 0 )
+  {
+    for (int y = ay; y < ay_end - count; y++)
+    {
+      auto sc = &area->data[(y + count) * total_width + ax];  // source character
+      auto dc = &area->data[y * total_width + ax];  // destination character
+      std::memcpy (dc, sc, sizeof(*dc) * unsigned(length));
+    }
+  }
+  else
+  {
+    for (int y = ay_end - 1; y >= ay + count; y--)
+    {
+      auto sc = &area->data[(y - count) * total_width + ax];  // source character
+      auto dc = &area->data[y * total_width + ax];  // destination character
+      std::memcpy (dc, sc, sizeof(*dc) * unsigned(length));
+    }
+  }
+
+  // Clear the exposed lines
+  FChar nc{area->data[exposed_y * total_width + ax]};  // next character
+  nc.ch = ' ';
+
+  for (int y = exposed_y; y < exposed_y + count; y++)
+    std::fill_n (&area->data[y * total_width + ax], length, nc);
+
+  for (int y = ay; y < ay_end; y++)
+  {
+    auto& line_changes = area->changes[y];
+    const auto line = &area->data[y * total_width];
+    line_changes.trans_count = 0;
+
+    for (int x{0}; x < total_width; x++)
+    {
+      const auto& ch = line[x].attr.bit;
+
+      if ( ch.transparent || ch.color_overlay || ch.inherit_background )
+        line_changes.trans_count++;
+    }
+
+    addLineChanges (line_changes, uInt(ax), uInt(ax_end - 1));
+  }
+
+  area->has_changes = true;
+
+  // Remember the region for the terminal update
+  const int top = area->offset_top + ay;
+  const int bottom = area->offset_top + ay_end - 1;
+
+  if ( count >= height
+    || (area != vdesktop && ! area->visible)
+    || top < 0 || bottom >= vterm->height )
+    return;
+
+  for (int y = top; y <= bottom; y++)
+  {
+    for (int x = area->offset_left + ax; x < area->offset_left + ax_end; x++)
+    {
+      if ( x < 0 || x >= vterm->width
+        || isCovered(FPoint(x, y), area) != non_covered )
+        return;
+    }
+  }
+
+  if ( scroll_hint.count != 0
+    && scroll_hint.top == top && scroll_hint.bottom == bottom )
+  {
+    scroll_hint.count += ( n > 0 ) ? count : -count;
+
+    if ( std::abs(scroll_hint.count) > bottom - top )
+      scroll_hint.count = 0;
+  }
+  else
+    scroll_hint = {top, bottom, ( n > 0 ) ? count : -count};
+}
+
 //----------------------------------------------------------------------
 void FVTerm::flush()
 {
   // Flush the output buffer
 
-  while ( ! output_buffer->empty() )
+  // Direct terminal output through stdio must come first
+  std::fflush(stdout);
+
+  if ( ! output_buffer || output_buffer->empty() )
+    return;
+
+  const uInt64 flush_start = FTrace::getTimeStamp();
+  frame_statistics.written_bytes += output_buffer->length();
+
+  if ( output_monitor )
+    output_monitor->addWrittenBytes (output_buffer->length());
+
+  // Hand over the buffer to the writer thread
+  if ( output_writer )
   {
-    static FTerm::defaultPutChar& FTermPutchar = FTerm::putchar();
-    FTermPutchar (output_buffer->front());
-    output_buffer->pop();
+    output_writer->write (*output_buffer);
+    frame_statistics.flush_time += FTrace::getTimeStamp() - flush_start;
+    return;
   }
 
-  std::fflush(stdout);
+  const int stdout_no = FTermios::getStdOut();
+  const char* data = output_buffer->data();
+  std::size_t length = output_buffer->length();
+  timeval start{};
+  FObject::getMonotonicTime (&start);
+
+  // Write the whole buffer with as few system calls as possible
+  while ( length > 0 )
+  {
+    const ssize_t bytes = fsystem->write (stdout_no, data, length);
+
+    if ( bytes < 0 )
+    {
+      if ( errno == EINTR )
+        continue;
+
+      // The non-blocking terminal cannot take more data yet
+      if ( (errno == EAGAIN || errno == EWOULDBLOCK)
+        && FPoll::waitForOutput(fsystem, stdout_no) )
+        continue;
+
+      break;  // Output error - discard the rest
+    }
+
+    data += bytes;
+    length -= std::size_t(bytes);
+  }
+
+  // A slow terminal shows up in the write time
+  if ( output_monitor )
+  {
+    timeval now{};
+    FObject::getMonotonicTime (&now);
+    const timeval elapsed = now - start;
+    const uInt64 usec = uInt64(elapsed.tv_sec) * 1000000
+                      + uInt64(elapsed.tv_usec);
+
+    if ( output_monitor->addWriteTime(output_buffer->length(), usec) )
+      updateMoveCosts();
+  }
+
+  output_buffer->clear();
+  frame_statistics.flush_time += FTrace::getTimeStamp() - flush_start;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::completeOutput()
+{
+  // Writes out the output buffer and waits until all data has
+  // reached the terminal. Required before direct terminal output.
+
+  flush();
+
+  if ( output_writer )
+    output_writer->waitForCompletion();
 }
 
 
@@ -668,6 +1002,41 @@ FVTerm::FTermArea* FVTerm::getPrintArea()
   return vdesktop;
 }
 
+//----------------------------------------------------------------------
+uInt64 FVTerm::getFrameWaitTime()
+{
+  // Returns the time in microseconds that the event loop
+  // can wait for input without delaying the next frame
+
+  static constexpr uInt64 no_frame_pending = static_cast<uInt64>(-1);
+
+  if ( ! terminal_update_pending )
+    return no_frame_pending;
+
+  // The writer thread wakes up the event loop after the write
+  if ( isOutputPending() )
+    return no_frame_pending;
+
+  const uInt64 drain_time = getOutputDrainTime();
+
+  if ( drain_time > 0 )
+    return drain_time;
+
+  if ( isFrameDue() )
+    return 0;
+
+  timeval now{};
+  FObject::getMonotonicTime (&now);
+  const timeval elapsed = now - last_frame_time;
+  const uInt64 elapsed_usec = uInt64(elapsed.tv_sec) * 1000000
+                            + uInt64(elapsed.tv_usec);
+
+  if ( elapsed_usec >= frame_interval )
+    return 0;
+
+  return frame_interval - elapsed_usec;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::createArea ( const FRect& box
                         , const FSize& shadow
@@ -712,6 +1081,8 @@ void FVTerm::resizeArea ( const FRect& box
   if ( ! area )
     return;
 
+  invalidateWindowMap();
+
   if ( width == area->width
     && height == area->height
     && rsw == area->right_shadow
@@ -766,6 +1137,8 @@ void FVTerm::removeArea (FTermArea*& area)
 
   if ( area != nullptr )
   {
+    invalidateWindowMap();
+
     if ( area->changes != nullptr )
     {
       delete[] area->changes;
@@ -818,14 +1191,10 @@ void FVTerm::restoreVTerm (const FRect& box)
       const int xpos = x + tx;
       auto tc = &vterm->data[ypos * vterm->width + xpos];  // terminal character
       auto sc = generateCharacter(FPoint(xpos, ypos));  // shown character
-      std::memcpy (tc, &sc, sizeof(*tc));
+      setVTermCharacter (tc, sc);
     }
 
-    if ( int(vterm->changes[ypos].xmin) > x )
-      vterm->changes[ypos].xmin = uInt(x);
-
-    if ( int(vterm->changes[ypos].xmax) < x + w - 1 )
-      vterm->changes[ypos].xmax = uInt(x + w - 1);
+    addLineChanges (vterm->changes[ypos], uInt(x), uInt(x + w - 1));
   }
 
   vterm->has_changes = true;
@@ -912,11 +1281,7 @@ void FVTerm::getArea (const FPoint& pos, FTermArea* area)
     auto ac = &area->data[y * area->width];  // area character
     std::memcpy (ac, tc, sizeof(*ac) * unsigned(length));
 
-    if ( int(area->changes[y].xmin) > 0 )
-      area->changes[y].xmin = 0;
-
-    if ( int(area->changes[y].xmax) < length - 1 )
-      area->changes[y].xmax = uInt(length - 1);
+    addLineChanges (area->changes[y], 0, uInt(length - 1));
   }
 }
 
@@ -959,11 +1324,8 @@ void FVTerm::getArea (const FRect& box, FTermArea* area)
     auto ac = &area->data[(dy + _y) * line_len + dx];  // area character
     std::memcpy (ac, tc, sizeof(*ac) * unsigned(length));
 
-    if ( int(area->changes[dy + _y].xmin) > dx )
-      area->changes[dy + _y].xmin = uInt(dx);
-
-    if ( int(area->changes[dy + _y].xmax) < dx + length - 1 )
-      area->changes[dy + _y].xmax = uInt(dx + length - 1);
+    addLineChanges ( area->changes[dy + _y]
+                   , uInt(dx), uInt(dx + length - 1) );
   }
 }
 
@@ -975,21 +1337,14 @@ void FVTerm::putArea (FTermArea* area)
   if ( ! area || ! area->visible )
     return;
 
-  int ax  = area->offset_left;
   const int ay  = area->offset_top;
   const int width = area->width + area->right_shadow;
   const int height = area->height + area->bottom_shadow;
-  int ol{0};  // Outside left
   int y_end{};
 
   // Call the preprocessing handler methods
   callPreprocessingHandler(area);
-
-  if ( ax < 0 )
-  {
-    ol = std::abs(ax);
-    ax = 0;
-  }
+  const uInt64 start = FTrace::getTimeStamp();
 
   if ( height + ay > vterm->height )
     y_end = vterm->height - ay;
@@ -998,58 +1353,25 @@ void FVTerm::putArea (FTermArea* area)
 
   for (int y{0}; y < y_end; y++)  // Line loop
   {
-    bool modified{false};
-    int line_xmin = int(area->changes[y].xmin);
-    int line_xmax = int(area->changes[y].xmax);
+    auto& line_changes = area->changes[y];
 
-    if ( line_xmin > line_xmax )
+    if ( line_changes.xmin > line_changes.xmax )
       continue;
 
-    if ( ax == 0 )
-      line_xmin = ol;
-
-    if ( width + ax - ol >= vterm->width )
-      line_xmax = vterm->width + ol - ax - 1;
-
-    if ( ax + line_xmin >= vterm->width )
-      continue;
-
-    for (int x = line_xmin; x <= line_xmax; x++)  // Column loop
+    if ( ay + y >= 0 )
     {
-      // Global terminal positions
-      int tx = ax + x;
-      const int ty = ay + y;
-
-      if ( tx < 0 || ty < 0 )
-        continue;
-
-      tx -= ol;
-
-      if ( updateVTermCharacter(area, FPoint(x, y), FPoint(tx, ty)) )
-        modified = true;
-
-      if ( ! modified )
-        line_xmin++;  // Don't update covered character
+      // Process only the changed ranges of the line
+      for (uInt i{0}; i < line_changes.range_count; i++)
+        putAreaRange (area, y, line_changes.range[i]);
     }
 
-    int _xmin = ax + line_xmin - ol;
-    int _xmax = ax + line_xmax;
-
-    if ( _xmin < int(vterm->changes[ay + y].xmin) )
-      vterm->changes[ay + y].xmin = uInt(_xmin);
-
-    if ( _xmax >= vterm->width )
-      _xmax = vterm->width - 1;
-
-    if ( _xmax > int(vterm->changes[ay + y].xmax) )
-      vterm->changes[ay + y].xmax = uInt(_xmax);
-
-    area->changes[y].xmin = uInt(width);
-    area->changes[y].xmax = 0;
+    resetLineChanges (line_changes, uInt(width));
   }
 
   vterm->has_changes = true;
   updateVTermCursor(area);
+  frame_statistics.composited_areas++;
+  frame_statistics.put_area_time += FTrace::getTimeStamp() - start;
 }
 
 //----------------------------------------------------------------------
@@ -1089,14 +1411,18 @@ void FVTerm::putArea (const FPoint& pos, FTermArea* area)
   if ( length < 1 )
     return;
 
+  const uInt64 start = FTrace::getTimeStamp();
+
   for (int y{0}; y < y_end; y++)  // line loop
   {
+    auto& line_changes = vterm->changes[ay + y];
+
     if ( area->changes[y].trans_count == 0 )
     {
       // Line has only covered characters
       ac = &area->data[y * width + ol];
       tc = &vterm->data[(ay + y) * vterm->width + ax];
-      putAreaLine (ac, tc, length);
+      putAreaLine (ac, tc, std::size_t(length), line_changes, uInt(ax));
     }
     else
     {
@@ -1109,16 +1435,14 @@ void FVTerm::putArea (const FPoint& pos, FTermArea* area)
         tc = &vterm->data[cy * vterm->width + cx];
         putAreaCharacter (FPoint(cx + 1, cy + 1), area->widget, ac, tc);
       }
-    }
 
-    if ( ax < int(vterm->changes[ay + y].xmin) )
-      vterm->changes[ay + y].xmin = uInt(ax);
-
-    if ( ax + length - 1 > int(vterm->changes[ay + y].xmax) )
-      vterm->changes[ay + y].xmax = uInt(ax + length - 1);
+      addLineChanges (line_changes, uInt(ax), uInt(ax + length - 1));
+    }
   }
 
   vterm->has_changes = true;
+  frame_statistics.composited_areas++;
+  frame_statistics.put_area_time += FTrace::getTimeStamp() - start;
 }
 
 //----------------------------------------------------------------------
@@ -1146,8 +1470,7 @@ void FVTerm::scrollAreaForward (FTermArea* area)
     auto sc = &area->data[pos2];  // source character
     dc = &area->data[pos1];
     std::memcpy (dc, sc, sizeof(*dc) * unsigned(length));
-    area->changes[y].xmin = 0;
-    area->changes[y].xmax = uInt(area->width - 1);
+    addLineChanges (area->changes[y], 0, uInt(area->width - 1));
   }
 
   // insert a new line below
@@ -1156,8 +1479,7 @@ void FVTerm::scrollAreaForward (FTermArea* area)
   nc.ch = ' ';
   dc = &area->data[y_max * total_width];
   std::fill_n (dc, area->width, nc);
-  area->changes[y_max].xmin = 0;
-  area->changes[y_max].xmax = uInt(area->width - 1);
+  addLineChanges (area->changes[y_max], 0, uInt(area->width - 1));
   area->has_changes = true;
 
   if ( area == vdesktop )
@@ -1165,15 +1487,15 @@ void FVTerm::scrollAreaForward (FTermArea* area)
     if ( TCAP(fc::t_scroll_forward)  )
     {
       setTermXY (0, vdesktop->height);
+      completeOutput();
       FTerm::scrollTermForward();
+      invalidateLineHashes();
+      markAsUnprinted (0, uInt(vterm->width - 1), uInt(y_max));
       putArea (FPoint(1, 1), vdesktop);
 
       // avoid update lines from 0 to (y_max - 1)
       for (int y{0}; y < y_max; y++)
-      {
-        area->changes[y].xmin = uInt(area->width - 1);
-        area->changes[y].xmax = 0;
-      }
+        resetLineChanges (area->changes[y], uInt(area->width));
     }
   }
 }
@@ -1204,8 +1526,7 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
     auto sc = &area->data[pos1];  // source character
     dc = &area->data[pos2];
     std::memcpy (dc, sc, sizeof(*dc) * unsigned(length));
-    area->changes[y].xmin = 0;
-    area->changes[y].xmax = uInt(area->width - 1);
+    addLineChanges (area->changes[y], 0, uInt(area->width - 1));
   }
 
   // insert a new line above
@@ -1214,8 +1535,7 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
   nc.ch = ' ';
   dc = &area->data[0];
   std::fill_n (dc, area->width, nc);
-  area->changes[0].xmin = 0;
-  area->changes[0].xmax = uInt(area->width - 1);
+  addLineChanges (area->changes[0], 0, uInt(area->width - 1));
   area->has_changes = true;
 
   if ( area == vdesktop )
@@ -1223,15 +1543,15 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
     if ( TCAP(fc::t_scroll_reverse)  )
     {
       setTermXY (0, 0);
+      completeOutput();
       FTerm::scrollTermReverse();
+      invalidateLineHashes();
+      markAsUnprinted (0, uInt(vterm->width - 1), 0);
       putArea (FPoint(1, 1), vdesktop);
 
       // avoid update lines from 1 to y_max
       for (int y{1}; y <= y_max; y++)
-      {
-        area->changes[y].xmin = uInt(area->width - 1);
-        area->changes[y].xmax = 0;
-      }
+        resetLineChanges (area->changes[y], uInt(area->width));
     }
   }
 }
@@ -1265,8 +1585,7 @@ void FVTerm::clearArea (FTermArea* area, int fillchar)
 
   for (int i{0}; i < area->height; i++)
   {
-    area->changes[i].xmin = 0;
-    area->changes[i].xmax = w - 1;
+    addLineChanges (area->changes[i], 0, w - 1);
 
     if ( nc.attr.bit.transparent
       || nc.attr.bit.color_overlay
@@ -1281,21 +1600,133 @@ void FVTerm::clearArea (FTermArea* area, int fillchar)
   for (int i{0}; i < area->bottom_shadow; i++)
   {
     const int y = area->height + i;
-    area->changes[y].xmin = 0;
-    area->changes[y].xmax = w - 1;
+    addLineChanges (area->changes[y], 0, w - 1);
     area->changes[y].trans_count = w;
   }
 
   area->has_changes = true;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::addLineChanges (FLineChanges& changes, uInt xmin, uInt xmax)
+{
+  // Adds the range [xmin .. xmax] to the line changes. Overlapping
+  // and adjacent ranges are combined. If there are more ranges than
+  // MAX_LINE_RANGES, the two ranges with the smallest gap are merged.
+
+  if ( xmin > xmax )
+    return;
+
+  if ( changes.xmin > changes.xmax )  // No changes yet
+    changes.range_count = 0;
+
+  auto& range = changes.range;
+  auto& count = changes.range_count;
+  changes.xmin = std::min(changes.xmin, xmin);
+  changes.xmax = std::max(changes.xmax, xmax);
+
+  // Fast path for consecutive changes from left to right
+  if ( count > 0 && xmin >= range[count - 1].xmin
+    && xmin <= range[count - 1].xmax + 1 )
+  {
+    range[count - 1].xmax = std::max(range[count - 1].xmax, xmax);
+    return;
+  }
+
+  // Skip all ranges on the left side
+  uInt first{0};
+
+  while ( first < count && range[first].xmax + 1 < xmin )
+    first++;
+
+  // Combine all ranges that touch [xmin .. xmax]
+  uInt last{first};
+
+  while ( last < count && range[last].xmin <= xmax + 1 )
+  {
+    xmin = std::min(xmin, range[last].xmin);
+    xmax = std::max(xmax, range[last].xmax);
+    last++;
+  }
+
+  if ( last > first )
+  {
+    range[first] = {xmin, xmax};
+    std::copy (range + last, range + count, range + first + 1);
+    count -= last - first - 1;
+    return;
+  }
+
+  if ( count == MAX_LINE_RANGES )
+  {
+    // Search for the smallest gap, including the gaps
+    // on both sides of the new range
+    uInt gap = UINT_MAX;
+    uInt pos{0};
+
+    for (uInt i{0}; i + 1 < count; i++)
+    {
+      if ( i + 1 != first && range[i + 1].xmin - range[i].xmax < gap )
+      {
+        gap = range[i + 1].xmin - range[i].xmax;
+        pos = i;
+      }
+    }
+
+    if ( first > 0 && xmin - range[first - 1].xmax <= gap )
+    {
+      gap = xmin - range[first - 1].xmax;
+      pos = count;  // Extend the left neighbor
+    }
+
+    if ( first < count && range[first].xmin - xmax <= gap )
+    {
+      range[first].xmin = xmin;  // Extend the right neighbor
+      return;
+    }
+
+    if ( pos == count )
+    {
+      range[first - 1].xmax = xmax;
+      return;
+    }
+
+    // Merge two existing ranges
+    range[pos].xmax = range[pos + 1].xmax;
+    std::copy (range + pos + 2, range + count, range + pos + 1);
+    count--;
+
+    if ( first > pos )
+      first--;
+  }
+
+  // Insert the new range
+  std::copy_backward (range + first, range + count, range + count + 1);
+  range[first] = {xmin, xmax};
+  count++;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::resetLineChanges (FLineChanges& changes, uInt width)
+{
+  // Marks the line as unchanged
+
+  changes.xmin = width;
+  changes.xmax = 0;
+  changes.range_count = 0;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::processTerminalUpdate()
 {
   // Retains terminal updates if there are unprocessed inputs
+  // or if the next frame is not yet due
   static constexpr int max_skip = 8;
 
-  if ( ! terminal_update_pending )
+  if ( ! terminal_update_pending
+    || ! isFrameDue()
+    || isOutputPending()
+    || isOutputBacklogged() )
     return;
 
   if ( ! keyboard->isInputDataPending() )
@@ -1348,8 +1779,7 @@ inline void FVTerm::setTextToDefault ( FTermArea* area
 
   std::fill_n (area->data, size.getArea(), default_char);
 
-  unchanged.xmin = uInt(size.getWidth());
-  unchanged.xmax = 0;
+  resetLineChanges (unchanged, uInt(size.getWidth()));
   unchanged.trans_count = 0;
 
   std::fill_n (area->changes, size.getHeight(), unchanged);
@@ -1413,6 +1843,30 @@ FVTerm::covered_state FVTerm::isCovered ( const FPoint& pos
   if ( ! area )
     return non_covered;
 
+  FTermArea* owner{nullptr};
+
+  if ( getWindowMapOwner(pos, owner) )
+  {
+    // No window or no other window on top of this position
+    if ( ! owner || owner == area )
+      return non_covered;
+
+    if ( area == vdesktop || (area->visible && area->layer > 0) )
+    {
+      if ( owner->layer < area->layer )
+        return non_covered;
+
+      const int width = owner->width + owner->right_shadow;
+      const int x = pos.getX() - owner->offset_left;
+      const int y = pos.getY() - owner->offset_top;
+      const auto tmp = &owner->data[y * width + x];
+
+      if ( ! tmp->attr.bit.transparent && ! tmp->attr.bit.color_overlay )
+        return fully_covered;
+    }
+  }
+
+  // Walk through all windows above the area
   auto is_covered = non_covered;
 
   if ( FWidget::getWindowList() && ! FWidget::getWindowList()->empty() )
@@ -1461,6 +1915,215 @@ FVTerm::covered_state FVTerm::isCovered ( const FPoint& pos
   return is_covered;
 }
 
+//----------------------------------------------------------------------
+void FVTerm::updateWindowMap()
+{
+  // Updates the topmost window of each virtual terminal cell
+  // in all screen regions that have changed since the last call
+
+  if ( ! window_map_changed || ! vterm || ! window_map || ! window_map_state )
+    return;
+
+  window_map_changed = false;
+  const auto& window_list = FWidget::getWindowList();
+  FWindowStateList state{};
+  int layer{0};
+
+  if ( window_list )
+  {
+    state.reserve(window_list->size());
+
+    for (auto&& win_obj : *window_list)
+    {
+      layer++;
+      const auto& win = win_obj->getVWin();
+
+      if ( ! win )
+        continue;
+
+      win->layer = layer;
+      const bool visible = win->visible && win->width > 0 && win->height > 0;
+      const std::size_t w = ( visible ) ? std::size_t(win->width)
+                                        + std::size_t(win->right_shadow) : 0;
+      const std::size_t h = ( visible ) ? std::size_t(win->height)
+                                        + std::size_t(win->bottom_shadow) : 0;
+      const FRect geometry (win->offset_left, win->offset_top, w, h);
+      state.push_back({win, geometry, visible});
+    }
+  }
+
+  const auto map_size = std::size_t(vterm->width * vterm->height);
+
+  if ( window_map->size() != map_size )
+  {
+    // Rebuild the complete map
+    window_map->assign(map_size, nullptr);
+    const FRect box ( 0, 0, std::size_t(vterm->width)
+                    , std::size_t(vterm->height) );
+    updateWindowMapArea (box, state);
+    window_map_state->swap(state);
+    return;
+  }
+
+  const auto& old_state = *window_map_state;
+  std::vector<int> old_position(state.size(), -1);
+
+  for (std::size_t n{0}; n < state.size(); n++)
+  {
+    const auto& current = state[n];
+    const auto iter = std::find_if ( old_state.begin(), old_state.end()
+                                   , [&current] (const FWindowState& ws)
+                                     {
+                                       return ws.area == current.area;
+                                     }
+                                   );
+
+    if ( iter == old_state.end() )  // New window
+    {
+      if ( current.visible )
+        updateWindowMapArea (current.geometry, state);
+
+      continue;
+    }
+
+    if ( iter->visible != current.visible
+      || iter->geometry != current.geometry )
+    {
+      // Window was moved, resized, shown or hidden
+      if ( iter->visible )
+        updateWindowMapArea (iter->geometry, state);
+
+      if ( current.visible )
+        updateWindowMapArea (current.geometry, state);
+
+      continue;
+    }
+
+    old_position[n] = int(std::distance(old_state.begin(), iter));
+  }
+
+  for (auto&& old : old_state)
+  {
+    const bool removed = std::none_of ( state.begin(), state.end()
+                                      , [&old] (const FWindowState& ws)
+                                        {
+                                          return ws.area == old.area;
+                                        }
+                                      );
+
+    if ( removed && old.visible )  // Deleted window
+      updateWindowMapArea (old.geometry, state);
+  }
+
+  // The stacking order of two overlapping windows has changed
+  // (raised or lowered window)
+  for (std::size_t a{0}; a < state.size(); a++)
+  {
+    for (std::size_t b{a + 1}; b < state.size(); b++)
+    {
+      if ( old_position[a] > old_position[b] && old_position[b] >= 0
+        && state[a].visible && state[b].visible
+        && state[a].geometry.overlap(state[b].geometry) )
+      {
+        const auto& box = state[a].geometry.intersect(state[b].geometry);
+        updateWindowMapArea (box, state);
+      }
+    }
+  }
+
+  window_map_state->swap(state);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::updateWindowMapArea ( const FRect& box
+                                 , const FWindowStateList& state )
+{
+  // Determines the topmost visible window for each cell of the box
+
+  const int x1 = std::max(box.getX1(), 0);
+  const int y1 = std::max(box.getY1(), 0);
+  const int x2 = std::min(box.getX2(), vterm->width - 1);
+  const int y2 = std::min(box.getY2(), vterm->height - 1);
+
+  for (int y{y1}; y <= y2; y++)
+  {
+    for (int x{x1}; x <= x2; x++)
+    {
+      FTermArea* owner{nullptr};
+      auto iter = state.rbegin();
+
+      while ( iter != state.rend() )
+      {
+        if ( iter->visible && iter->geometry.contains(x, y) )
+        {
+          owner = iter->area;
+          break;
+        }
+
+        ++iter;
+      }
+
+      (*window_map)[std::size_t(y * vterm->width + x)] = owner;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::getWindowMapOwner (const FPoint& pos, FTermArea*& owner)
+{
+  // Gets the topmost visible window at the terminal position pos.
+  // Returns false if the position is not covered by the map.
+
+  updateWindowMap();
+  const int x = pos.getX();
+  const int y = pos.getY();
+
+  if ( ! window_map || window_map->empty()
+    || x < 0 || y < 0 || x >= vterm->width || y >= vterm->height )
+    return false;
+
+  owner = (*window_map)[std::size_t(y * vterm->width + x)];
+  return true;
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::isNonCoveredLine ( const FPoint& pos, int length
+                              , FTermArea* area )
+{
+  // Checks whether no other window covers the terminal line
+  // segment with the given length from the position pos
+
+  FTermArea* owner{nullptr};
+
+  if ( length < 1 || ! getWindowMapOwner(pos, owner)
+    || pos.getX() + length > vterm->width )
+    return false;
+
+  const auto map_line = &(*window_map)[std::size_t(pos.getY() * vterm->width)];
+
+  for (int x = pos.getX(); x < pos.getX() + length; x++)
+  {
+    owner = map_line[x];
+
+    if ( owner && owner != area )
+      return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::setVTermCharacter (FChar* tc, const FChar& nc)
+{
+  // Puts the new character on the virtual terminal. A character
+  // remains printed as long as the terminal already shows it.
+
+  const bool is_printed = tc->attr.bit.printed && *tc == nc;
+  std::memcpy (tc, &nc, sizeof(*tc));
+  tc->attr.bit.no_changes = is_printed;
+  tc->attr.bit.printed = is_printed;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::updateOverlappedColor ( FTermArea* area
                                    , const FPoint& area_pos
@@ -1495,8 +2158,7 @@ void FVTerm::updateOverlappedColor ( FTermArea* area
     || nc.ch == fc::FullBlock )
     nc.ch = ' ';
 
-  nc.attr.bit.no_changes = bool(tc->attr.bit.printed && *tc == nc);
-  std::memcpy (tc, &nc, sizeof(*tc));
+  setVTermCharacter (tc, nc);
 }
 
 //----------------------------------------------------------------------
@@ -1511,8 +2173,7 @@ void FVTerm::updateOverlappedCharacter ( FTermArea* area
   auto tc = &vterm->data[ty * vterm->width + tx];
   // Overlapped character
   auto oc = getCoveredCharacter (terminal_pos + FPoint(1, 1), area->widget);
-  oc.attr.bit.no_changes = bool(tc->attr.bit.printed && *tc == oc);
-  std::memcpy (tc, &oc, sizeof(*tc));
+  setVTermCharacter (tc, oc);
 }
 
 //----------------------------------------------------------------------
@@ -1546,8 +2207,7 @@ void FVTerm::updateShadedCharacter ( FTermArea* area
     || oc.ch == fc::FullBlock )
     oc.ch = ' ';
 
-  oc.attr.bit.no_changes = bool(tc->attr.bit.printed && *tc == oc);
-  std::memcpy (tc, &oc, sizeof(*tc));
+  setVTermCharacter (tc, oc);
 }
 
 //----------------------------------------------------------------------
@@ -1572,8 +2232,7 @@ void FVTerm::updateInheritBackground ( FTermArea* area
   // Covered character
   auto cc = getCoveredCharacter (terminal_pos + FPoint(1, 1), area->widget);
   nc.bg_color = cc.bg_color;
-  nc.attr.bit.no_changes = bool(tc->attr.bit.printed && *tc == nc);
-  std::memcpy (tc, &nc, sizeof(*tc));
+  setVTermCharacter (tc, nc);
 }
 
 //----------------------------------------------------------------------
@@ -1592,12 +2251,7 @@ void FVTerm::updateCharacter ( FTermArea* area
   const auto ac = &area->data[y * width + x];
   // Terminal character
   auto tc = &vterm->data[ty * vterm->width + tx];
-  std::memcpy (tc, ac, sizeof(*tc));
-
-  if ( tc->attr.bit.printed && *tc == *ac )
-    tc->attr.bit.no_changes = true;
-  else
-    tc->attr.bit.no_changes = false;
+  setVTermCharacter (tc, *ac);
 }
 
 //----------------------------------------------------------------------
@@ -1688,12 +2342,15 @@ void FVTerm::callPreprocessingHandler (FTermArea* area)
   if ( area->preproc_list.empty() )
     return;
 
+  const uInt64 start = FTrace::getTimeStamp();
+
   for (auto&& pcall : area->preproc_list)
   {
-    // call the preprocessing handler
-    auto preprocessingHandler = pcall.function;
-    preprocessingHandler();
+    // call the preprocessing handler (without copying the std::function)
+    pcall.function();
   }
+
+  frame_statistics.preprocessing_time += FTrace::getTimeStamp() - start;
 }
 
 //----------------------------------------------------------------------
@@ -1754,6 +2411,24 @@ FChar FVTerm::generateCharacter (const FPoint& pos)
   if ( ! FWidget::getWindowList() || FWidget::getWindowList()->empty() )
     return *sc;
 
+  FTermArea* owner{nullptr};
+
+  if ( getWindowMapOwner(pos, owner) )
+  {
+    if ( ! owner )  // No window at this position
+      return *sc;
+
+    const int line_len = owner->width + owner->right_shadow;
+    const auto tmp = &owner->data[ (y - owner->offset_top) * line_len
+                                 + (x - owner->offset_left) ];
+
+    // An opaque character of the topmost window hides all others
+    if ( ! tmp->attr.bit.transparent
+      && ! tmp->attr.bit.color_overlay
+      && ! tmp->attr.bit.inherit_background )
+      return *tmp;
+  }
+
   for (auto& win_obj : *FWidget::getWindowList())
   {
     const auto& win = win_obj->getVWin();
@@ -1838,17 +2513,39 @@ FChar FVTerm::getCharacter ( character_type char_type
   // Get the window layer of this object
   const auto& w = static_cast<FWidget*>(obj);
   const int layer = FWindow::getWindowLayer(w);
+  FTermArea* owner{nullptr};
+
+  if ( char_type == overlapped_character
+    && getWindowMapOwner(FPoint(x, y), owner) )
+  {
+    // No window above this object at this position
+    if ( ! owner || owner->layer <= layer )
+      return *cc;
+
+    const int line_len = owner->width + owner->right_shadow;
+    const auto tmp = &owner->data[ (y - owner->offset_top) * line_len
+                                 + (x - owner->offset_left) ];
+
+    // The topmost window has an opaque character here
+    if ( ! tmp->attr.bit.transparent
+      && ! tmp->attr.bit.color_overlay
+      && ! tmp->attr.bit.inherit_background )
+      return *tmp;
+  }
+
+  int win_layer{0};
 
   for (auto&& win_obj : *FWidget::getWindowList())
   {
     bool significant_char{false};
+    win_layer++;  // Position in the window list
 
     // char_type can be "overlapped_character"
     // or "covered_character"
     if ( char_type == covered_character )
-      significant_char = bool(layer >= FWindow::getWindowLayer(win_obj));
+      significant_char = bool(layer >= win_layer);
     else
-      significant_char = bool(layer < FWindow::getWindowLayer(win_obj));
+      significant_char = bool(layer < win_layer);
 
     if ( obj && win_obj != obj && significant_char )
     {
@@ -1898,7 +2595,13 @@ void FVTerm::init (bool disable_alt_screen)
   {
     fterm         = new FTerm (disable_alt_screen);
     term_pos      = new FPoint(-1, -1);
-    output_buffer = new std::queue<int>;
+    output_buffer = new std::string;
+    output_monitor = new FOutputMonitor (fsystem, FTermios::getStdOut());
+    window_map    = new std::vector<FTermArea*>;
+    window_map_state = new FWindowStateList;
+    line_hash     = new std::vector<FLineHash>;
+    line_hash_count = new std::vector<FLineHashCount>;
+    terminal_data = new std::vector<FChar>;
   }
   catch (const std::bad_alloc& ex)
   {
@@ -1906,6 +2609,8 @@ void FVTerm::init (bool disable_alt_screen)
     std::abort();
   }
 
+  output_buffer->reserve (output_buffer_size);
+
   // term_attribute stores the current state of the terminal
   term_attribute.ch           = '\0';
   term_attribute.fg_color     = fc::Default;
@@ -1925,6 +2630,7 @@ void FVTerm::init (bool disable_alt_screen)
   FSize shadow_size(0, 0);
   createArea (term_geometry, shadow_size, vdesktop);
   vdesktop->visible = true;
+  vdesktop->layer = 0;
   active_area = vdesktop;
 
   // Get FKeyboard object
@@ -1947,6 +2653,8 @@ void FVTerm::init_characterLengths (FOptiMove* optimove)
     repeat_char_length    = optimove->getRepeatCharLength();
     clr_bol_length        = optimove->getClrBolLength();
     clr_eol_length        = optimove->getClrEolLength();
+    insert_char_length    = optimove->getInsertCharsLength();
+    delete_char_length    = optimove->getDeleteCharsLength();
   }
   else
   {
@@ -1955,6 +2663,8 @@ void FVTerm::init_characterLengths (FOptiMove* optimove)
     repeat_char_length    = INT_MAX;
     clr_bol_length        = INT_MAX;
     clr_eol_length        = INT_MAX;
+    insert_char_length    = INT_MAX;
+    delete_char_length    = INT_MAX;
   }
 }
 
@@ -1972,9 +2682,33 @@ void FVTerm::finish()
 
   flush();
 
+  if ( output_writer )
+  {
+    delete output_writer;
+    output_writer = nullptr;
+  }
+
   if ( output_buffer )
     delete output_buffer;
 
+  if ( output_monitor )
+    delete output_monitor;
+
+  if ( window_map )
+    delete window_map;
+
+  if ( window_map_state )
+    delete window_map_state;
+
+  if ( line_hash )
+    delete line_hash;
+
+  if ( line_hash_count )
+    delete line_hash_count;
+
+  if ( terminal_data )
+    delete terminal_data;
+
   // remove virtual terminal + virtual desktop area
   removeArea (vdesktop);
   removeArea (vterm);
@@ -1987,11 +2721,93 @@ void FVTerm::finish()
 }
 
 //----------------------------------------------------------------------
-void FVTerm::putAreaLine (FChar* ac, FChar* tc, int length)
+bool FVTerm::putAreaLine ( const FChar* ac, FChar* tc, std::size_t length
+                         , FLineChanges& changes, uInt offset )
+{
+  // Copies the changed characters of a line from area to terminal.
+  // Each run of changed characters is added as a separate range
+  // at the terminal position offset + x to the line changes.
+  // Returns false if there are no changes.
+
+  std::size_t x = getChangedCharacterPos (ac, tc, length);
+
+  if ( x == length )
+    return false;
+
+  while ( x < length )
+  {
+    // Copy a run of changed characters
+    const std::size_t count = \
+        getUnchangedCharacterPos (&ac[x], &tc[x], length - x);
+    std::memcpy (&tc[x], &ac[x], sizeof(*tc) * count);
+
+    for (std::size_t n{x}; n < x + count; n++)
+    {
+      tc[n].attr.bit.no_changes = false;
+      tc[n].attr.bit.printed = false;
+    }
+
+    addLineChanges (changes, offset + uInt(x), offset + uInt(x + count - 1));
+    x += count;
+
+    if ( x < length )
+      x += getChangedCharacterPos (&ac[x], &tc[x], length - x);
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::putAreaRange ( FTermArea* area, int y
+                          , const FChangeRange& range )
 {
-  // copy "length" characters from area to terminal
+  // Adds the changed characters of a range
+  // in the area line y to the virtual terminal
+
+  const int width = area->width + area->right_shadow;
+  const int ol = std::max(0, -area->offset_left);  // Outside left
+  const int ax = std::max(0, area->offset_left);
+  const int ty = area->offset_top + y;
+  const int line_xmin = std::max(int(range.xmin), ol);
+  const int line_xmax = std::min(int(range.xmax), vterm->width + ol - ax - 1);
+
+  if ( line_xmin > line_xmax )
+    return;
 
-  std::memcpy (tc, ac, sizeof(*tc) * unsigned(length));
+  const int line_tx = ax + line_xmin - ol;
+  const int length = line_xmax - line_xmin + 1;
+  auto& changes = vterm->changes[ty];
+
+  if ( area->changes[y].trans_count == 0
+    && isNonCoveredLine(FPoint(line_tx, ty), length, area) )
+  {
+    // Copy only the changed characters of an uncovered line
+    const auto ac = &area->data[y * width + line_xmin];
+    const auto tc = &vterm->data[ty * vterm->width + line_tx];
+    putAreaLine (ac, tc, std::size_t(length), changes, uInt(line_tx));
+    return;
+  }
+
+  int first{-1};
+  int last{-1};
+
+  for (int x = line_xmin; x <= line_xmax; x++)  // Column loop
+  {
+    // Global terminal position
+    const int tx = ax + x - ol;
+
+    // Don't update covered characters
+    if ( updateVTermCharacter(area, FPoint(x, y), FPoint(tx, ty)) )
+    {
+      if ( first < 0 )
+        first = tx;
+
+      last = tx;
+    }
+  }
+
+  if ( first >= 0 )
+    addLineChanges (changes, uInt(first), uInt(last));
 }
 
 //----------------------------------------------------------------------
@@ -2003,7 +2819,7 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, FVTerm* obj
   {
     // Restore one character on vterm
     FChar ch = getCoveredCharacter (pos, obj);
-    std::memcpy (tc, &ch, sizeof(*tc));
+    setVTermCharacter (tc, ch);
   }
   else  // Mot transparent
   {
@@ -2024,7 +2840,7 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, FVTerm* obj
         || ch.ch == fc::FullBlock )
         ch.ch = ' ';
 
-      std::memcpy (tc, &ch, sizeof(*tc));
+      setVTermCharacter (tc, ch);
     }
     else if ( ac->attr.bit.inherit_background )
     {
@@ -2033,10 +2849,10 @@ void FVTerm::putAreaCharacter ( const FPoint& pos, FVTerm* obj
       std::memcpy (&ch, ac, sizeof(ch));
       FChar cc = getCoveredCharacter (pos, obj);
       ch.bg_color = cc.bg_color;
-      std::memcpy (tc, &ch, sizeof(*tc));
+      setVTermCharacter (tc, ch);
     }
     else  // Default
-      std::memcpy (tc, ac, sizeof(*tc));
+      setVTermCharacter (tc, *ac);
   }
 }
 
@@ -2095,6 +2911,8 @@ bool FVTerm::clearTerm (int fillchar)
     return false;
   }
 
+  invalidateLineHashes();
+
   if ( cl )  // Clear screen
   {
     appendOutputBuffer (cl);
@@ -2119,6 +2937,10 @@ bool FVTerm::clearTerm (int fillchar)
     setTermXY (0, 0);
   }
 
+  // The terminal no longer shows the virtual terminal characters
+  for (int y{0}; vterm && y < vterm->height; y++)
+    markAsUnprinted (0, uInt(vterm->width - 1), uInt(y));
+
   flush();
   return true;
 }
@@ -2143,8 +2965,7 @@ bool FVTerm::clearFullArea (FTermArea* area, FChar& nc)
   {
     for (int i{0}; i < vdesktop->height; i++)
     {
-      vdesktop->changes[i].xmin = 0;
-      vdesktop->changes[i].xmax = uInt(vdesktop->width) - 1;
+      addLineChanges (vdesktop->changes[i], 0, uInt(vdesktop->width) - 1);
       vdesktop->changes[i].trans_count = 0;
     }
 
@@ -2294,30 +3115,20 @@ bool FVTerm::skipUnchangedCharacters(uInt& x, uInt xmax, uInt y)
 {
   // Skip characters without changes if it is faster than redrawing
 
-  FTermArea*& vt = vterm;
-  auto print_char = &vt->data[y * uInt(vt->width) + x];
-  print_char->attr.bit.printed = true;
-
-  if ( print_char->attr.bit.no_changes )
-  {
-    uInt count{1};
+  const auto line = &vterm->data[y * uInt(vterm->width)];
 
-    for (uInt i = x + 1; i <= xmax; i++)
-    {
-      auto ch = &vt->data[y * uInt(vt->width) + i];
+  if ( ! line[x].attr.bit.printed )
+    return false;
 
-      if ( ch->attr.bit.no_changes )
-        count++;
-      else
-        break;
-    }
+  // Number of characters that are already shown on the terminal
+  const auto count = \
+      uInt(getChangedCharacterPos(&line[x], &line[x], xmax - x + 1));
 
-    if ( count > cursor_address_length )
-    {
-      setTermXY (int(x + count), int(y));
-      x = x + count - 1;
-      return true;
-    }
+  if ( count > cursor_address_length )
+  {
+    appendCursorMove (int(x + count), int(y));
+    x = x + count - 1;
+    return true;
   }
 
   return false;
@@ -2333,13 +3144,14 @@ void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
     const auto& ec = TCAP(fc::t_erase_chars);
     const auto& rp = TCAP(fc::t_repeat_char);
     auto print_char = &vt->data[y * uInt(vt->width) + x];
-    print_char->attr.bit.printed = true;
-    replaceNonPrintableFullwidth (x, print_char);
 
     // skip character with no changes
     if ( skipUnchangedCharacters(x, xmax, y) )
       continue;
 
+    print_char->attr.bit.printed = true;
+    replaceNonPrintableFullwidth (x, print_char);
+
     // Erase character
     if ( ec && print_char->ch == ' ' )
     {
@@ -2362,22 +3174,65 @@ void FVTerm::printRange ( uInt xmin, uInt xmax, uInt y
 }
 
 //----------------------------------------------------------------------
-inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
-                                                 , FChar*& print_char )
+void FVTerm::printChangedRanges ( uInt xmin, uInt xmax, uInt y
+                                , bool draw_trailing_ws )
 {
-  // Replace non-printable full-width characters that are truncated
-  // from the right or left terminal side
+  // Prints only the change ranges of line y between xmin and xmax.
+  // A small gap between two ranges is printed along if this
+  // is cheaper than a cursor movement.
 
-  if ( x == 0 && isFullWidthPaddingChar(print_char) )
-  {
-    print_char->ch = fc::SingleLeftAngleQuotationMark;  // ‹
-    print_char->attr.bit.fullwidth_padding = false;
-  }
-  else if ( x == uInt(vterm->width - 1)
-         && isFullWidthChar(print_char) )
+  const auto& changes = vterm->changes[y];
+  uInt start{1};
+  uInt end{0};
+
+  for (uInt i{0}; i < changes.range_count; i++)
   {
-    print_char->ch = fc::SingleRightAngleQuotationMark;  // ›
-    print_char->attr.bit.char_width = 1;
+    const uInt from = std::max(changes.range[i].xmin, xmin);
+    const uInt to = std::min(changes.range[i].xmax, xmax);
+
+    if ( from > to )
+      continue;
+
+    if ( start <= end && from <= end + cursor_address_length + 1 )
+    {
+      end = to;
+      continue;
+    }
+
+    if ( start <= end )
+    {
+      appendCursorMove (int(start), int(y));
+      printRange (start, end, y, false);
+    }
+
+    start = from;
+    end = to;
+  }
+
+  if ( start <= end )
+  {
+    appendCursorMove (int(start), int(y));
+    printRange (start, end, y, draw_trailing_ws);
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::replaceNonPrintableFullwidth ( uInt x
+                                                 , FChar*& print_char )
+{
+  // Replace non-printable full-width characters that are truncated
+  // from the right or left terminal side
+
+  if ( x == 0 && isFullWidthPaddingChar(print_char) )
+  {
+    print_char->ch = fc::SingleLeftAngleQuotationMark;  // ‹
+    print_char->attr.bit.fullwidth_padding = false;
+  }
+  else if ( x == uInt(vterm->width - 1)
+         && isFullWidthChar(print_char) )
+  {
+    print_char->ch = fc::SingleRightAngleQuotationMark;  // ›
+    print_char->attr.bit.char_width = 1;
   }
 }
 
@@ -2583,7 +3438,7 @@ FVTerm::exit_state FVTerm::eraseCharacters ( uInt& x, uInt xmax, uInt y
       appendOutputBuffer (tparm(ec, whitespace, 0, 0, 0, 0, 0, 0, 0, 0));
 
       if ( x + whitespace - 1 < xmax || draw_trailing_ws )
-        setTermXY (int(x + whitespace), int(y));
+        appendCursorMove (int(x + whitespace), int(y));
       else
         return line_completely_printed;
 
@@ -2753,14 +3608,233 @@ void FVTerm::printPaddingCharacter (FTermArea* area, FChar& term_char)
   print (area, pc);
 }
 
+//----------------------------------------------------------------------
+int FVTerm::printString (FTermArea* area, const wchar_t* string)
+{
+  // Prints the string without a temporary character buffer
+
+  int len{0};
+
+  for (const wchar_t* p = string; *p; p++)
+  {
+    if ( printNextCharacter(area, getNextCharacter(*p)) )
+      break;  // end of area reached
+
+    len++;
+  }
+
+  return len;
+}
+
+//----------------------------------------------------------------------
+int FVTerm::printString (FTermArea* area, const char* string)
+{
+  // Prints an ASCII string
+
+  int len{0};
+
+  for (const char* p = string; *p; p++)
+  {
+    if ( printNextCharacter(area, getNextCharacter(wchar_t(uChar(*p)))) )
+      break;  // end of area reached
+
+    len++;
+  }
+
+  return len;
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::printNextCharacter (FTermArea* area, const FChar& fchar)
+{
+  // Prints a character or executes a control character.
+  // Returns true when the end of the area is reached.
+
+  switch ( fchar.ch )
+  {
+    case '\n':
+      area->cursor_y++;
+      // fall through
+    case '\r':
+      area->cursor_x = 1;
+      break;
+
+    case '\t':
+    {
+      const uInt tabstop = uInt(getTabstop());
+      area->cursor_x = int ( uInt(area->cursor_x)
+                           + tabstop
+                           - uInt(area->cursor_x)
+                           + 1
+                           % tabstop );
+      break;
+    }
+
+    case '\b':
+      area->cursor_x--;
+      break;
+
+    case '\a':
+      beep();
+      break;
+
+    default:
+    {
+      auto nc = fchar;  // next character
+      print (area, nc);
+      return false;
+    }
+  }
+
+  return printWrap(area);
+}
+
+//----------------------------------------------------------------------
+inline FChar FVTerm::getNextCharacter (wchar_t c)
+{
+  // Returns the character c with the next print attributes
+
+  FChar nc{};
+  nc.ch           = c;
+  nc.fg_color     = next_attribute.fg_color;
+  nc.bg_color     = next_attribute.bg_color;
+  nc.attr.byte[0] = next_attribute.attr.byte[0];
+  nc.attr.byte[1] = next_attribute.attr.byte[1];
+  nc.attr.byte[2] = 0;
+  return nc;
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::shiftTerminalLine (uInt& xmin, uInt& xmax, uInt y)
+{
+  // Shifts the rest of the terminal line with an insert or delete
+  // characters sequence if this is cheaper than overwriting it.
+  // Returns true if the line was shifted.
+
+  const auto& IC = TCAP(fc::t_parm_ich);
+  const auto& DC = TCAP(fc::t_parm_dch);
+  const auto width = uInt(vterm->width);
+  const auto size = std::size_t(width) * std::size_t(vterm->height);
+
+  if ( ! (IC || DC) || ! terminal_data || terminal_data->size() != size )
+    return false;
+
+  const auto line = &vterm->data[y * width];
+  const auto term_line = &(*terminal_data)[y * width];
+
+  // Full-width characters must not be split
+  for (uInt x = xmin; x < width; x++)
+  {
+    const FChar* const ch = &line[x];
+    const FChar* const term_ch = &term_line[x];
+
+    if ( isFullWidthChar(ch) || isFullWidthPaddingChar(ch)
+      || isFullWidthChar(term_ch) || isFullWidthPaddingChar(term_ch) )
+      return false;
+  }
+
+  const FUpdateCosts costs =
+  {
+    cursor_address_length,
+    erase_char_length,
+    repeat_char_length,
+    ( IC ) ? insert_char_length : uInt(INT_MAX),
+    ( DC ) ? delete_char_length : uInt(INT_MAX)
+  };
+  const auto length = std::size_t(width - xmin);
+  const int shift = getCharacterShift ( &term_line[xmin], &line[xmin]
+                                      , length, costs );
+
+  if ( shift == 0 )
+    return false;
+
+  const auto count = std::size_t(std::abs(shift));
+  auto first = &term_line[xmin];
+  appendCursorMove (int(xmin), int(y));
+
+  if ( shift > 0 )
+  {
+    appendOutputBuffer (tparm(IC, shift, 0, 0, 0, 0, 0, 0, 0, 0));
+    std::memmove (first + count, first, sizeof(*first) * (length - count));
+  }
+  else
+  {
+    const auto& dc = TCAP(fc::t_delete_character);
+
+    if ( shift == -1 && dc )
+      appendOutputBuffer (dc);  // Shorter than the parameterized form
+    else
+      appendOutputBuffer (tparm(DC, -shift, 0, 0, 0, 0, 0, 0, 0, 0));
+
+    std::memmove (first, first + count, sizeof(*first) * (length - count));
+    first = &term_line[width - count];
+  }
+
+  // The content of the inserted or vacated columns is unknown
+  for (std::size_t i{0}; i < count; i++)
+    first[i].attr.bit.printed = false;
+
+  // Characters that match after the shift are already printed
+  for (uInt x = xmin; x < width; x++)
+    line[x].attr.bit.printed = term_line[x].attr.bit.printed
+                            && term_line[x] == line[x];
+
+  xmax = width - 1;
+
+  while ( xmax > xmin && line[xmax].attr.bit.printed )
+    xmax--;
+
+  while ( xmin < xmax && line[xmin].attr.bit.printed )
+    xmin++;
+
+  if ( xmin == xmax && line[xmin].attr.bit.printed )
+  {
+    xmin = width;
+    xmax = 0;
+  }
+
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::updateTerminalLine (uInt y)
 {
   // Updates pending changes from line y to the terminal
 
   const auto& vt = vterm;
-  uInt& xmin = vt->changes[y].xmin;
-  uInt& xmax = vt->changes[y].xmax;
+  auto& changes = vt->changes[y];
+  uInt xmin = changes.xmin;
+  uInt xmax = changes.xmax;
+
+  if ( xmin <= xmax )
+  {
+    // Narrow the range to the characters that are not yet printed
+    const auto line = &vt->data[y * uInt(vt->width)];
+    const auto count = std::size_t(xmax - xmin + 1);
+    frame_statistics.compared_cells += count;
+    const auto pos = getChangedCharacterPos (&line[xmin], &line[xmin], count);
+
+    if ( pos < count )
+    {
+      xmin += uInt(pos);
+
+      while ( xmax > xmin && line[xmax].attr.bit.printed )
+        xmax--;
+    }
+    else  // The terminal already shows the entire range
+    {
+      resetLineChanges (changes, uInt(vt->width));
+      xmin = changes.xmin;
+      xmax = changes.xmax;
+    }
+  }
+
+  if ( xmin <= xmax && shiftTerminalLine(xmin, xmax, y) )
+  {
+    // The shifted line is printed as a whole
+    resetLineChanges (changes, uInt(vt->width));
+    addLineChanges (changes, xmin, xmax);
+  }
 
   if ( xmin <= xmax )  // Line has changes
   {
@@ -2783,7 +3857,7 @@ void FVTerm::updateTerminalLine (uInt y)
       draw_trailing_ws = canClearTrailingWS (xmax, y);
     }
 
-    setTermXY (int(xmin), int(y));
+    appendCursorMove (int(xmin), int(y));
 
     if ( is_eol_clean )
     {
@@ -2801,7 +3875,7 @@ void FVTerm::updateTerminalLine (uInt y)
         markAsPrinted (0, xmin, y);
       }
 
-      printRange (xmin, xmax, y, draw_trailing_ws);
+      printChangedRanges (xmin, xmax, y, draw_trailing_ws);
 
       if ( draw_trailing_ws )
       {
@@ -2811,14 +3885,474 @@ void FVTerm::updateTerminalLine (uInt y)
       }
     }
 
+    // Keep a copy of the terminal content for the next update
+    if ( terminal_data && ! terminal_data->empty() )
+      std::memcpy ( &(*terminal_data)[y * uInt(vt->width)], first_char
+                  , sizeof(*first_char) * uInt(vt->width) );
+
     // Reset line changes
-    xmin = uInt(vt->width);
-    xmax = 0;
+    resetLineChanges (changes, uInt(vt->width));
   }
 
   cursorWrap();
 }
 
+//----------------------------------------------------------------------
+uInt64 FVTerm::getLineHash (uInt y)
+{
+  // Calculates a FNV-1a hash value over the visible
+  // character properties of the virtual terminal line y
+
+  constexpr uInt64 fnv_prime = 0x100000001b3;
+  uInt64 hash = 0xcbf29ce484222325;
+  const auto width = uInt(vterm->width);
+  const auto line = &vterm->data[y * width];
+
+  for (uInt x{0}; x < width; x++)
+  {
+    const auto& ch = line[x];
+    const uInt64 color = uInt64(ch.fg_color) | uInt64(ch.bg_color) << 16;
+    const uInt64 attr = uInt64(ch.attr.byte[0])
+                      | uInt64(ch.attr.byte[1]) << 8
+                      | uInt64(ch.attr.bit.fullwidth_padding) << 16;
+    hash = (hash ^ uInt64(uInt32(ch.ch))) * fnv_prime;
+    hash = (hash ^ (color | attr << 32)) * fnv_prime;
+  }
+
+  return ( hash != 0 ) ? hash : 1;  // 0 is reserved for unknown lines
+}
+
+//----------------------------------------------------------------------
+void FVTerm::invalidateLineHashes()
+{
+  // The terminal content is no longer known
+
+  if ( ! line_hash )
+    return;
+
+  for (auto&& line : *line_hash)
+  {
+    line.terminal = 0;
+    line.vterm = 0;
+  }
+
+  if ( terminal_data )
+    for (auto&& ch : *terminal_data)
+      ch.attr.bit.printed = false;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::scrollTerminalLines()
+{
+  // Detects vertically shifted lines between the terminal and the
+  // virtual terminal by comparing line hashes (like the hashmap
+  // scrolling optimization of ncurses). Shifted lines are moved
+  // with scroll sequences, only the exposed lines must be repainted.
+
+  static constexpr int max_scroll_operations = 4;
+
+  // The region scrolled by scrollArea() since the last update
+  FScrollRegion hint = scroll_hint;
+  scroll_hint = {-1, -1, 0};
+
+  if ( ! line_hash )
+    return;
+
+  const int height = vterm->height;
+  const int width = vterm->width;
+  auto& hash = *line_hash;
+
+  if ( int(hash.size()) != height )
+    hash.assign(std::size_t(height), FLineHash{0, 0, -1});
+
+  if ( terminal_data
+    && terminal_data->size() != std::size_t(width) * std::size_t(height) )
+  {
+    FChar unknown{};  // Character with an unprinted state
+    terminal_data->assign(std::size_t(width) * std::size_t(height), unknown);
+  }
+
+  bool has_changes{false};
+
+  for (int y{0}; y < height; y++)
+  {
+    const auto& changes = vterm->changes[y];
+
+    if ( changes.xmin <= changes.xmax )
+    {
+      hash[y].vterm = getLineHash(uInt(y));
+
+      if ( hash[y].vterm != hash[y].terminal )
+        has_changes = true;
+    }
+    else
+      hash[y].vterm = hash[y].terminal;
+  }
+
+  if ( ! has_changes )
+    return;
+
+  const auto address_length = std::min(cursor_address_length, uInt(width));
+  const int sequence_cost = 4 * int(address_length);
+
+  for (int n{0}; n < max_scroll_operations; n++)
+  {
+    if ( matchShiftedLines(hint) == 0 )
+      return;
+
+    hint.count = 0;  // The line numbers are no longer valid
+
+    // Search for the block of shifted lines with the highest gain
+    int best_top{-1};
+    int best_bottom{-1};
+    int best_gain{0};
+    int y{0};
+
+    while ( y < height )
+    {
+      if ( hash[y].old_line < 0 || hash[y].old_line == y )
+      {
+        y++;
+        continue;
+      }
+
+      const int top = y;
+      const int shift = y - hash[y].old_line;
+      const auto& top_changes = vterm->changes[y];
+      int gain = int(top_changes.xmax) - int(top_changes.xmin) + 1;
+
+      while ( y + 1 < height
+           && hash[y + 1].old_line == hash[y].old_line + 1 )
+      {
+        y++;
+        const auto& changes = vterm->changes[y];
+
+        if ( changes.xmin <= changes.xmax )
+          gain += int(changes.xmax) - int(changes.xmin) + 1;
+      }
+
+      // Costs for the repainting of the exposed lines
+      // and the scroll control sequences
+      gain -= std::abs(shift) * width + sequence_cost;
+
+      if ( gain > best_gain )
+      {
+        best_top = top;
+        best_bottom = y;
+        best_gain = gain;
+      }
+
+      y++;
+    }
+
+    if ( best_top < 0 )
+      return;
+
+    // Scroll up (count > 0) or down (count < 0) the lines
+    const int count = hash[best_top].old_line - best_top;
+    const int top = ( count > 0 ) ? best_top : hash[best_top].old_line;
+    const int bottom = ( count > 0 ) ? best_bottom + count : best_bottom;
+
+    if ( ! scrollTerminalRegion(top, bottom, count) )
+      return;
+
+    markScrolledLines (top, bottom, count);
+  }
+}
+
+//----------------------------------------------------------------------
+int FVTerm::matchShiftedLines (const FScrollRegion& hint)
+{
+  // Finds the previous terminal line for each changed line.
+  // Returns the number of shifted lines.
+
+  const int height = vterm->height;
+  auto& hash = *line_hash;
+  int matched{0};
+  countLineHashes();
+
+  // Lines with a unique content
+  for (int y{0}; y < height; y++)
+  {
+    auto& line = hash[y];
+    line.old_line = -1;
+
+    if ( line.vterm == line.terminal )
+      continue;
+
+    const auto& count = getLineHashCount(line.vterm);
+
+    if ( count.old_count == 1 && count.new_count == 1 )
+    {
+      line.old_line = count.old_line;
+      matched++;
+    }
+  }
+
+  // Lines of a region that was scrolled with scrollArea()
+  for (int y = std::max(hint.top, 0); y <= hint.bottom && y < height; y++)
+  {
+    auto& line = hash[y];
+    const int old_line = y + hint.count;
+
+    if ( hint.count == 0 || line.old_line >= 0
+      || old_line < hint.top || old_line > hint.bottom
+      || old_line >= height || line.vterm == line.terminal )
+      continue;
+
+    if ( hash[old_line].terminal == line.vterm )
+    {
+      line.old_line = old_line;
+      matched++;
+    }
+  }
+
+  if ( matched == 0 )
+    return 0;
+
+  // Extend the blocks of shifted lines to equal neighbor lines
+  for (int y{0}; y < height - 1; y++)
+  {
+    auto& next = hash[y + 1];
+    const int old_line = hash[y].old_line + 1;
+
+    if ( hash[y].old_line >= 0 && next.old_line < 0
+      && old_line < height && next.vterm != next.terminal
+      && hash[old_line].terminal == next.vterm )
+    {
+      next.old_line = old_line;
+      matched++;
+    }
+  }
+
+  for (int y = height - 1; y > 0; y--)
+  {
+    auto& prev = hash[y - 1];
+    const int old_line = hash[y].old_line - 1;
+
+    if ( hash[y].old_line > 0 && prev.old_line < 0
+      && prev.vterm != prev.terminal
+      && hash[old_line].terminal == prev.vterm )
+    {
+      prev.old_line = old_line;
+      matched++;
+    }
+  }
+
+  return matched;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::countLineHashes()
+{
+  // Counts the terminal lines and the virtual terminal lines
+  // per hash value in an open addressing hash table
+
+  const auto height = std::size_t(vterm->height);
+  auto& table = *line_hash_count;
+  std::size_t table_size{1};
+
+  // At least twice as many entries as hash values
+  while ( table_size < 4 * height )
+    table_size <<= 1;
+
+  if ( table.size() != table_size )
+    table.resize(table_size);
+
+  std::fill (table.begin(), table.end(), FLineHashCount{0, -1, 0, 0});
+
+  for (std::size_t y{0}; y < height; y++)
+  {
+    const auto& line = (*line_hash)[y];
+
+    if ( line.terminal != 0 )
+    {
+      auto& count = getLineHashCount(line.terminal);
+      count.old_line = int(y);
+      count.old_count++;
+    }
+
+    if ( line.vterm != 0 )
+      getLineHashCount(line.vterm).new_count++;
+  }
+}
+
+//----------------------------------------------------------------------
+FVTerm::FLineHashCount& FVTerm::getLineHashCount (uInt64 hash)
+{
+  // Returns the hash table entry of a line hash. The table
+  // always has a free entry, so the linear probing terminates.
+
+  auto& table = *line_hash_count;
+  const std::size_t mask = table.size() - 1;
+  auto index = std::size_t(hash ^ (hash >> 32)) & mask;
+
+  while ( table[index].hash != 0 && table[index].hash != hash )
+    index = (index + 1) & mask;
+
+  table[index].hash = hash;
+  return table[index];
+}
+
+//----------------------------------------------------------------------
+bool FVTerm::scrollTerminalRegion (int top, int bottom, int n)
+{
+  // Scrolls the terminal lines from top to bottom n lines
+  // up (n > 0) or down (n < 0)
+
+  const auto& cs = TCAP(fc::t_change_scroll_region);
+  const auto& sf = TCAP(fc::t_scroll_forward);
+  const auto& sr = TCAP(fc::t_scroll_reverse);
+  const auto& SF = TCAP(fc::t_parm_index);
+  const auto& SR = TCAP(fc::t_parm_rindex);
+  const auto& al = TCAP(fc::t_insert_line);
+  const auto& dl = TCAP(fc::t_delete_line);
+  const auto& AL = TCAP(fc::t_parm_insert_line);
+  const auto& DL = TCAP(fc::t_parm_delete_line);
+  const int count = std::abs(n);
+
+  if ( n == 0 || top < 0 || bottom >= vterm->height || bottom - top < count )
+    return false;
+
+  if ( cs && ((n > 0 && (SF || sf)) || (n < 0 && (SR || sr))) )
+  {
+    // Scroll inside a scrolling region
+    appendOutputBuffer (tparm(cs, top, bottom, 0, 0, 0, 0, 0, 0, 0));
+    term_pos->setPoint(-1, -1);  // The cursor position is undefined now
+
+    if ( n > 0 )
+    {
+      appendCursorMove (0, bottom);
+
+      if ( SF && (count > 1 || ! sf) )
+        appendOutputBuffer (tparm(SF, count, 0, 0, 0, 0, 0, 0, 0, 0));
+      else
+        for (int i{0}; i < count; i++)
+          appendOutputBuffer (sf);
+    }
+    else
+    {
+      appendCursorMove (0, top);
+
+      if ( SR && (count > 1 || ! sr) )
+        appendOutputBuffer (tparm(SR, count, 0, 0, 0, 0, 0, 0, 0, 0));
+      else
+        for (int i{0}; i < count; i++)
+          appendOutputBuffer (sr);
+    }
+
+    // Restore the full screen scrolling region
+    const int max_y = vterm->height - 1;
+    appendOutputBuffer (tparm(cs, 0, max_y, 0, 0, 0, 0, 0, 0, 0));
+    term_pos->setPoint(-1, -1);
+    return true;
+  }
+
+  if ( (DL || dl) && (AL || al) )
+  {
+    // Delete and insert lines so that the lines
+    // below the bottom line keep their position
+    const int delete_y = ( n > 0 ) ? top : bottom - count + 1;
+    const int insert_y = ( n > 0 ) ? bottom - count + 1 : top;
+    appendCursorMove (0, delete_y);
+
+    if ( DL && (count > 1 || ! dl) )
+      appendOutputBuffer (tparm(DL, count, 0, 0, 0, 0, 0, 0, 0, 0));
+    else
+      for (int i{0}; i < count; i++)
+        appendOutputBuffer (dl);
+
+    appendCursorMove (0, insert_y);
+
+    if ( AL && (count > 1 || ! al) )
+      appendOutputBuffer (tparm(AL, count, 0, 0, 0, 0, 0, 0, 0, 0));
+    else
+      for (int i{0}; i < count; i++)
+        appendOutputBuffer (al);
+
+    return true;
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::moveTerminalLine (int from, int to)
+{
+  // Moves a line of the terminal content copy (from = -1 for
+  // an exposed line with unknown content)
+
+  const auto width = std::size_t(vterm->width);
+
+  if ( ! terminal_data
+    || terminal_data->size() != width * std::size_t(vterm->height) )
+    return;
+
+  const auto line = &(*terminal_data)[std::size_t(to) * width];
+
+  if ( from >= 0 )
+  {
+    std::memcpy ( line, &(*terminal_data)[std::size_t(from) * width]
+                , sizeof(*line) * width );
+  }
+  else
+  {
+    for (std::size_t x{0}; x < width; x++)
+      line[x].attr.bit.printed = false;
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::markScrolledLines (int top, int bottom, int n)
+{
+  // Updates the line hashes and the line changes after
+  // the terminal region from top to bottom was scrolled
+  // n lines up (n > 0) or down (n < 0)
+
+  const int width = vterm->width;
+  auto& hash = *line_hash;
+
+  if ( n > 0 )
+  {
+    for (int y = top; y <= bottom; y++)
+    {
+      hash[y].terminal = ( y + n <= bottom ) ? hash[y + n].terminal : 0;
+      moveTerminalLine (( y + n <= bottom ) ? y + n : -1, y);
+    }
+  }
+  else
+  {
+    for (int y = bottom; y >= top; y--)
+    {
+      hash[y].terminal = ( y + n >= top ) ? hash[y + n].terminal : 0;
+      moveTerminalLine (( y + n >= top ) ? y + n : -1, y);
+    }
+  }
+
+  for (int y = top; y <= bottom; y++)
+  {
+    auto& changes = vterm->changes[y];
+    auto line = &vterm->data[y * width];
+
+    if ( hash[y].terminal != 0 && hash[y].terminal == hash[y].vterm )
+    {
+      // The line is already on the terminal
+      resetLineChanges (changes, uInt(width));
+
+      for (int x{0}; x < width; x++)
+        line[x].attr.bit.printed = true;
+    }
+    else
+    {
+      // Repaint the exposed line
+      addLineChanges (changes, 0, uInt(width - 1));
+      hash[y].vterm = getLineHash(uInt(y));
+
+      markAsUnprinted (0, uInt(width - 1), uInt(y));
+    }
+  }
+}
+
 //----------------------------------------------------------------------
 bool FVTerm::updateTerminalCursor()
 {
@@ -2830,7 +4364,7 @@ bool FVTerm::updateTerminalCursor()
 
     if ( isInsideTerminal(FPoint(x, y)) )
     {
-      setTermXY (x, y);
+      appendCursorMove (x, y);
       showCursor();
       return true;
     }
@@ -2854,6 +4388,89 @@ bool FVTerm::isInsideTerminal (const FPoint& pos)
     return false;
 }
 
+//----------------------------------------------------------------------
+inline bool FVTerm::isFrameDue()
+{
+  // Limits the terminal updates to one frame per frame interval
+
+  if ( frame_interval == 0 )
+    return true;
+
+  return FObject::isMonotonicTimeout (&last_frame_time, frame_interval);
+}
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isOutputPending()
+{
+  // The writer thread has not yet written out the last frame
+  return output_writer && output_writer->isBusy();
+}
+
+//----------------------------------------------------------------------
+inline bool FVTerm::isOutputBacklogged()
+{
+  // If the terminal link falls behind, the changes
+  // are combined until the queue has drained
+  return getOutputDrainTime() > 0;
+}
+
+//----------------------------------------------------------------------
+uInt64 FVTerm::getOutputDrainTime()
+{
+  // Measures the terminal output queue and returns the time in
+  // microseconds until it has drained (0 = not backlogged)
+
+  static constexpr uInt64 min_interval = 16667;  // 60 fps
+
+  if ( ! output_monitor )
+    return 0;
+
+  timeval now{};
+  FObject::getMonotonicTime (&now);
+  bool updated = output_monitor->measure(now);
+  std::size_t length{};
+  uInt64 usec{};
+
+  if ( output_writer && output_writer->getWriteTime(length, usec) )
+    updated = output_monitor->addWriteTime(length, usec) || updated;
+
+  if ( updated )
+    updateMoveCosts();
+
+  return output_monitor->getDrainTime (std::max(frame_interval, min_interval));
+}
+
+//----------------------------------------------------------------------
+void FVTerm::updateMoveCosts()
+{
+  // The cursor move costs use the measured throughput.
+  // Only significant changes are taken over.
+
+  const uInt64 throughput = output_monitor->getThroughput();
+  const uInt64 tolerance = move_throughput / 4;
+  const auto& optimove = FTerm::getFOptiMove();
+
+  if ( ! optimove
+    || ( throughput >= move_throughput - tolerance
+      && throughput <= move_throughput + tolerance ) )
+    return;
+
+  optimove->setThroughput (throughput);
+  init_characterLengths (optimove);
+  move_throughput = throughput;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::finishFrameStatistics()
+{
+  // Makes the statistics of the written frame available
+  // and starts the counting for the next frame
+
+  frame_statistics.frame = last_frame_statistics.frame + 1;
+  last_frame_statistics = frame_statistics;
+  frame_statistics = FFrameStatistics{};
+}
+
 //----------------------------------------------------------------------
 inline bool FVTerm::isTermSizeChanged()
 {
@@ -2879,6 +4496,7 @@ inline void FVTerm::markAsPrinted (uInt pos, uInt line)
   // Marks a character as printed
 
   vterm->data[line * uInt(vterm->width) + pos].attr.bit.printed = true;
+  frame_statistics.emitted_cells++;
 }
 
 //----------------------------------------------------------------------
@@ -2888,6 +4506,23 @@ inline void FVTerm::markAsPrinted (uInt from, uInt to, uInt line)
 
   for (uInt x = from; x <= to; x++)
     vterm->data[line * uInt(vterm->width) + x].attr.bit.printed = true;
+
+  if ( from <= to )
+    frame_statistics.emitted_cells += to - from + 1;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::markAsUnprinted (uInt from, uInt to, uInt line)
+{
+  // Marks characters in the specified range [from .. to] as unprinted
+  // to force a redraw on the terminal
+
+  for (uInt x = from; x <= to; x++)
+  {
+    auto& ch = vterm->data[line * uInt(vterm->width) + x];
+    ch.attr.bit.no_changes = false;
+    ch.attr.bit.printed = false;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -2984,7 +4619,10 @@ inline void FVTerm::appendAttributes (FChar*& next_attr)
   const char* attr_str = FTerm::changeAttribute (term_attr, next_attr);
 
   if ( attr_str )
+  {
     appendOutputBuffer (attr_str);
+    frame_statistics.attribute_changes++;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -3013,11 +4651,11 @@ int FVTerm::appendLowerRight (FChar*& screen_char)
 
     const int x = int(getColumnNumber()) - 2;
     const int y = int(getLineNumber()) - 1;
-    setTermXY (x, y);
+    appendCursorMove (x, y);
     appendChar (screen_char);
     term_pos->x_ref()++;
 
-    setTermXY (x, y);
+    appendCursorMove (x, y);
     screen_char--;
 
     if ( IC )
@@ -3074,12 +4712,60 @@ inline void FVTerm::appendOutputBuffer (const char s[])
 int FVTerm::appendOutputBuffer (int ch)
 {
   // append method for unicode character
-  output_buffer->push(ch);
+  typedef int (*putcharFunction)(int);
+  static const FTerm::defaultPutChar& FTermPutchar = FTerm::putchar();
+  const auto putchar_func = FTermPutchar.target<putcharFunction>();
+
+  if ( putchar_func && *putchar_func == &FTerm::putchar_UTF8 )
+    appendOutputBufferUTF8 (ch);
+  else if ( putchar_func && *putchar_func == &FTerm::putchar_ASCII )
+    output_buffer->push_back (char(ch));
+  else
+  {
+    // User-defined putchar function
+    completeOutput();
+    FTermPutchar (ch);
+    return ch;
+  }
 
-  if ( output_buffer->size() >= TERMINAL_OUTPUT_BUFFER_SIZE )
+  if ( flush_policy == flush_on_overflow
+    && output_buffer->length() >= output_buffer_size )
     flush();
 
   return ch;
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::appendOutputBufferUTF8 (int ch)
+{
+  // Appends the UTF-8 byte sequence of a unicode character
+
+  if ( ch < 0x80 )
+  {
+    // 1 Byte (7-bit): 0xxxxxxx
+    output_buffer->push_back (char(ch));
+  }
+  else if ( ch < 0x800 )
+  {
+    // 2 byte (11-bit): 110xxxxx 10xxxxxx
+    output_buffer->push_back (char(0xc0 | (ch >> 6)));
+    output_buffer->push_back (char(0x80 | (ch & 0x3f)));
+  }
+  else if ( ch < 0x10000 )
+  {
+    // 3 byte (16-bit): 1110xxxx 10xxxxxx 10xxxxxx
+    output_buffer->push_back (char(0xe0 | (ch >> 12)));
+    output_buffer->push_back (char(0x80 | ((ch >> 6) & 0x3f)));
+    output_buffer->push_back (char(0x80 | (ch & 0x3f)));
+  }
+  else if ( ch < 0x200000 )
+  {
+    // 4 byte (21-bit): 11110xxx 10xxxxxx 10xxxxxx 10xxxxxx
+    output_buffer->push_back (char(0xf0 | (ch >> 18)));
+    output_buffer->push_back (char(0x80 | ((ch >> 12) & 0x3f)));
+    output_buffer->push_back (char(0x80 | ((ch >> 6) & 0x3f)));
+    output_buffer->push_back (char(0x80 | (ch & 0x3f)));
+  }
+}
+
 }  // namespace finalcut
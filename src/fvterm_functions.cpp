@@ -0,0 +1,415 @@
+/***********************************************************************
+* fvterm_functions.cpp - FVTerm helper functions                       *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+  #define USE_X86_CHAR_COMPARE
+  #include <immintrin.h>
+#endif
+
+#include "final/foptiattr.h"
+#include "final/fvterm.h"
+
+namespace finalcut
+{
+
+// Function prototypes
+template <bool>
+std::size_t findCharacterScalar (const FChar*, const FChar*, std::size_t);
+
+#if defined(USE_X86_CHAR_COMPARE)
+template <bool>
+__attribute__((target("sse2")))
+std::size_t findCharacterSSE2 (const FChar*, const FChar*, std::size_t);
+template <bool>
+__attribute__((target("avx2")))
+std::size_t findCharacterAVX2 (const FChar*, const FChar*, std::size_t);
+#endif
+
+// Type definition
+typedef std::size_t (*findCharacterFunc) ( const FChar*
+                                         , const FChar*
+                                         , std::size_t );
+
+typedef struct
+{
+  const char*       name;
+  findCharacterFunc find_changed;
+  findCharacterFunc find_unchanged;
+} FCharCompareKernel;
+
+// Data array
+const FCharCompareKernel char_compare_kernel[] =
+{
+#if defined(USE_X86_CHAR_COMPARE)
+  { "avx2",   findCharacterAVX2<true>,   findCharacterAVX2<false>   },
+  { "sse2",   findCharacterSSE2<true>,   findCharacterSSE2<false>   },
+#endif
+  { "scalar", findCharacterScalar<true>, findCharacterScalar<false> }
+};
+
+// global state
+static const FCharCompareKernel* current_kernel{nullptr};
+
+
+// non-member functions
+//----------------------------------------------------------------------
+inline bool isCharacterChanged (const FChar& new_char, const FChar& vt_char)
+{
+  // A character must be printed if it differs from the character
+  // on the virtual terminal or if that one was not printed yet
+
+  return ! ( vt_char.attr.bit.printed && vt_char == new_char );
+}
+
+//----------------------------------------------------------------------
+template <bool changed>
+std::size_t findCharacterScalar ( const FChar* new_char
+                                , const FChar* vt_char
+                                , std::size_t length )
+{
+  for (std::size_t i{0}; i < length; i++)
+    if ( isCharacterChanged(new_char[i], vt_char[i]) == changed )
+      return i;
+
+  return length;
+}
+
+#if defined(USE_X86_CHAR_COMPARE)
+//----------------------------------------------------------------------
+inline void getCompareMasks (FChar& compare_mask, FChar& printed_mask)
+{
+  // Byte masks with the FChar bits of operator == and the printed bit
+
+  std::memset (&compare_mask, 0, sizeof(compare_mask));
+  std::memset (&printed_mask, 0, sizeof(printed_mask));
+  compare_mask.ch = ~wchar_t(0);
+  compare_mask.fg_color = ~FColor(0);
+  compare_mask.bg_color = ~FColor(0);
+  compare_mask.attr.byte[0] = 0xff;
+  compare_mask.attr.byte[1] = 0xff;
+  compare_mask.attr.bit.fullwidth_padding = true;
+  printed_mask.attr.bit.printed = true;
+}
+
+//----------------------------------------------------------------------
+template <bool changed>
+__attribute__((target("sse2")))
+std::size_t findCharacterSSE2 ( const FChar* new_char
+                              , const FChar* vt_char
+                              , std::size_t length )
+{
+  // Compares four characters (one 64 byte cache line) per iteration
+
+  static_assert ( sizeof(FChar) == sizeof(__m128i)
+                , "FChar does not fit into a SSE2 register" );
+  FChar compare_mask, printed_mask;
+  getCompareMasks (compare_mask, printed_mask);
+  const auto cmask = _mm_loadu_si128(reinterpret_cast<__m128i*>(&compare_mask));
+  const auto pmask = _mm_loadu_si128(reinterpret_cast<__m128i*>(&printed_mask));
+  const auto zero = _mm_setzero_si128();
+  const auto a = reinterpret_cast<const __m128i*>(new_char);
+  const auto b = reinterpret_cast<const __m128i*>(vt_char);
+  std::size_t i{0};
+
+  for (; i + 4 <= length; i += 4)
+  {
+    uInt bits{0};
+
+    for (std::size_t n{0}; n < 4; n++)
+    {
+      const auto va = _mm_loadu_si128(a + i + n);
+      const auto vb = _mm_loadu_si128(b + i + n);
+      const auto diff = _mm_or_si128 ( _mm_and_si128(_mm_xor_si128(va, vb), cmask)
+                                     , _mm_andnot_si128(vb, pmask) );
+
+      if ( _mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) != 0xffff )
+        bits |= uInt(1) << n;  // character has changed
+    }
+
+    if ( ! changed )
+      bits = ~bits & 0x0f;
+
+    if ( bits )
+      return i + std::size_t(__builtin_ctz(bits));
+  }
+
+  return i + findCharacterScalar<changed>(new_char + i, vt_char + i, length - i);
+}
+
+//----------------------------------------------------------------------
+template <bool changed>
+__attribute__((target("avx2")))
+std::size_t findCharacterAVX2 ( const FChar* new_char
+                              , const FChar* vt_char
+                              , std::size_t length )
+{
+  // Compares four characters (one 64 byte cache line) per iteration
+
+  FChar compare_mask, printed_mask;
+  getCompareMasks (compare_mask, printed_mask);
+  const auto cmask = _mm256_broadcastsi128_si256 \
+      (_mm_loadu_si128(reinterpret_cast<__m128i*>(&compare_mask)));
+  const auto pmask = _mm256_broadcastsi128_si256 \
+      (_mm_loadu_si128(reinterpret_cast<__m128i*>(&printed_mask)));
+  const auto zero = _mm256_setzero_si256();
+  const auto a = reinterpret_cast<const __m256i*>(new_char);
+  const auto b = reinterpret_cast<const __m256i*>(vt_char);
+  std::size_t i{0};
+
+  for (; i + 4 <= length; i += 4)
+  {
+    uInt bits{0};
+
+    for (std::size_t n{0}; n < 2; n++)
+    {
+      const auto va = _mm256_loadu_si256(a + i / 2 + n);
+      const auto vb = _mm256_loadu_si256(b + i / 2 + n);
+      const auto diff = _mm256_or_si256 \
+      (
+        _mm256_and_si256(_mm256_xor_si256(va, vb), cmask),
+        _mm256_andnot_si256(vb, pmask)
+      );
+      const auto equal = uInt(_mm256_movemask_epi8(_mm256_cmpeq_epi8(diff, zero)));
+
+      if ( (equal & 0xffff) != 0xffff )
+        bits |= uInt(1) << (2 * n);  // first character has changed
+
+      if ( (equal >> 16) != 0xffff )
+        bits |= uInt(2) << (2 * n);  // second character has changed
+    }
+
+    if ( ! changed )
+      bits = ~bits & 0x0f;
+
+    if ( bits )
+      return i + std::size_t(__builtin_ctz(bits));
+  }
+
+  return i + findCharacterScalar<changed>(new_char + i, vt_char + i, length - i);
+}
+#endif  // defined(USE_X86_CHAR_COMPARE)
+
+//----------------------------------------------------------------------
+inline bool isPrintRequired ( const FChar* term_char
+                            , const FChar* new_char
+                            , std::size_t length
+                            , int shift, std::size_t x )
+{
+  // Checks whether the character at position x must be printed
+  // after the terminal line was shifted by shift columns
+
+  if ( shift == 0 )
+    return ! new_char[x].attr.bit.printed;
+
+  const auto from = std::ptrdiff_t(x) - shift;
+
+  if ( from < 0 || from >= std::ptrdiff_t(length) )
+    return true;  // Inserted or vacated column
+
+  return isCharacterChanged(new_char[x], term_char[from]);
+}
+
+//----------------------------------------------------------------------
+uInt64 getLineUpdateCost ( const FChar* term_char
+                         , const FChar* new_char
+                         , std::size_t length, int shift
+                         , const FVTerm::FUpdateCosts& costs )
+{
+  // Estimates the number of bytes for the line update. A gap of
+  // printed characters is skipped by overwriting or by a cursor
+  // movement, a run of equal characters is printed, erased (ECH)
+  // or repeated (REP).
+
+  const uInt64 move_length = costs.move_length;
+  uInt64 cost{0};
+  std::size_t gap{0};
+  std::size_t x{0};
+
+  while ( x < length )
+  {
+    if ( ! isPrintRequired(term_char, new_char, length, shift, x) )
+    {
+      gap++;
+      x++;
+      continue;
+    }
+
+    if ( gap > 0 )
+      cost += std::min(uInt64(gap), move_length);
+
+    gap = 0;
+    std::size_t run{1};
+
+    while ( x + run < length
+         && new_char[x + run] == new_char[x]
+         && isPrintRequired(term_char, new_char, length, shift, x + run) )
+      run++;
+
+    uInt64 run_cost = run;
+
+    if ( new_char[x].ch == ' ' )
+      run_cost = std::min(run_cost, costs.erase_length + move_length);
+
+    if ( new_char[x].ch < 128 )
+      run_cost = std::min(run_cost, uInt64(costs.repeat_length));
+
+    cost += run_cost;
+    x += run;
+  }
+
+  return cost;
+}
+
+//----------------------------------------------------------------------
+inline bool isKernelSupported (const FCharCompareKernel& kernel)
+{
+#if defined(USE_X86_CHAR_COMPARE)
+  if ( std::strcmp(kernel.name, "avx2") == 0 )
+    return __builtin_cpu_supports("avx2");
+
+  if ( std::strcmp(kernel.name, "sse2") == 0 )
+    return __builtin_cpu_supports("sse2");
+#endif
+
+  return std::strcmp(kernel.name, "scalar") == 0;
+}
+
+//----------------------------------------------------------------------
+inline const FCharCompareKernel* getKernel()
+{
+  if ( current_kernel )
+    return current_kernel;
+
+  // Select the fastest kernel supported by the processor
+  for (auto&& kernel : char_compare_kernel)
+  {
+    if ( isKernelSupported(kernel) )
+    {
+      current_kernel = &kernel;
+      break;
+    }
+  }
+
+  return current_kernel;
+}
+
+// FVTerm non-member functions
+//----------------------------------------------------------------------
+std::size_t getChangedCharacterPos ( const FChar* new_char
+                                   , const FChar* vt_char
+                                   , std::size_t length )
+{
+  // Returns the position of the first character that differs from
+  // the printed virtual terminal character (or length, if none)
+
+  return getKernel()->find_changed(new_char, vt_char, length);
+}
+
+//----------------------------------------------------------------------
+std::size_t getUnchangedCharacterPos ( const FChar* new_char
+                                     , const FChar* vt_char
+                                     , std::size_t length )
+{
+  // Returns the position of the first character that is equal to
+  // the printed virtual terminal character (or length, if none)
+
+  return getKernel()->find_unchanged(new_char, vt_char, length);
+}
+
+//----------------------------------------------------------------------
+const char* getCharacterCompareKernel()
+{
+  return getKernel()->name;
+}
+
+//----------------------------------------------------------------------
+bool setCharacterCompareKernel (const char name[])
+{
+  // Selects the compare kernel "avx2", "sse2" or "scalar"
+
+  for (auto&& kernel : char_compare_kernel)
+  {
+    if ( std::strcmp(kernel.name, name) == 0 && isKernelSupported(kernel) )
+    {
+      current_kernel = &kernel;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+int getCharacterShift ( const FChar* term_char
+                      , const FChar* new_char
+                      , std::size_t length
+                      , const FVTerm::FUpdateCosts& costs )
+{
+  // Returns the number of columns by which the terminal line should be
+  // shifted before the update (> 0 = insert, < 0 = delete characters),
+  // or 0 if overwriting the characters is cheaper. term_char contains
+  // the characters on the terminal, new_char the new line content.
+
+  static constexpr std::size_t max_shift = 16;
+  uInt64 best_cost = getLineUpdateCost(term_char, new_char, length, 0, costs);
+  int best_shift{0};
+
+  for (std::size_t k{1}; k <= max_shift && k < length; k++)
+  {
+    // Only shifts that bring the first character into place
+    if ( costs.insert_length < best_cost
+      && ! isCharacterChanged(new_char[k], term_char[0]) )
+    {
+      const uInt64 cost = costs.insert_length
+                        + getLineUpdateCost ( term_char, new_char
+                                            , length, int(k), costs );
+
+      if ( cost < best_cost )
+      {
+        best_cost = cost;
+        best_shift = int(k);
+      }
+    }
+
+    if ( costs.delete_length < best_cost
+      && ! isCharacterChanged(new_char[0], term_char[k]) )
+    {
+      const uInt64 cost = costs.delete_length
+                        + getLineUpdateCost ( term_char, new_char
+                                            , length, -int(k), costs );
+
+      if ( cost < best_cost )
+      {
+        best_cost = cost;
+        best_shift = -int(k);
+      }
+    }
+  }
+
+  return best_shift;
+}
+
+}  // namespace finalcut
@@ -28,6 +28,7 @@
 #include "final/fstatusbar.h"
 #include "final/fstring.h"
 #include "final/ftermdata.h"
+#include "final/ftrace.h"
 #include "final/fwidget.h"
 #include "final/fwidgetcolors.h"
 #include "final/fwindow.h"
@@ -106,6 +107,7 @@ FWidget::~FWidget()  // destructor
   processDestroy();
   delCallbacks();
   FApplication::removeQueuedEvent(this);
+  FApplication::cancelBackgroundJobs(this);
 
   // unset clicked widget
   if ( this == getClickedWidget() )
@@ -938,7 +940,10 @@ void FWidget::redraw()
   else if ( ! isShown() )
     return;
 
-  draw();
+  {
+    FTraceScope trace(this, "draw");
+    draw();
+  }
 
   if ( isRootWidget() )
     drawWindows();
@@ -950,8 +955,7 @@ void FWidget::redraw()
 
   if ( redraw_root_widget == this )
   {
-    updateTerminal();
-    flush();
+    requestTerminalUpdate();
     redraw_root_widget = nullptr;
   }
 }
@@ -1009,7 +1013,10 @@ void FWidget::show()
     show_root_widget = this;
   }
 
-  draw();
+  {
+    FTraceScope trace(this, "draw");
+    draw();
+  }
   flags.hidden = false;
   flags.shown = true;
 
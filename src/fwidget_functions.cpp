@@ -89,16 +89,23 @@ std::size_t getHotkeyPos (const FString& src, FString& dest)
 
   for (auto&& ch : src)
   {
-    if ( ch == L'&' && hotkeypos == NOT_SET && src.getLength() != i + 1 )
+    if ( ch == L'&' && src.getLength() != i + 1 )
+    {
       hotkeypos = i;
-    else
-      dest += ch;
+      break;
+    }
 
     i++;
   }
 
+  dest = src;  // Reuses the buffer of dest if it is large enough
+
+  if ( hotkeypos != NOT_SET )
+    dest.remove(hotkeypos, 1);
+
   return hotkeypos;
 }
+
 //----------------------------------------------------------------------
 void setHotkeyViaString (FWidget* w, const FString& text)
 {
@@ -128,6 +135,15 @@ void setHotkeyViaString (FWidget* w, const FString& text)
     w->delAccelerator();
 }
 
+//----------------------------------------------------------------------
+void printRepeated (FWidget* w, wchar_t c, std::size_t count)
+{
+  // Prints count times the character c without a temporary string
+
+  for (std::size_t i{0}; i < count; i++)
+    w->print (c);
+}
+
 //----------------------------------------------------------------------
 void drawShadow (FWidget* w)
 {
@@ -171,9 +187,9 @@ void drawTransparentShadow (FWidget* w)
              << "  "
              << FStyle (fc::Reset)
              << FColorPair (w->wcolors.shadow_bg, w->wcolors.shadow_fg)
-             << FStyle (fc::ColorOverlay)
-             << FString (width, L' ')
-             << FStyle (fc::Reset);
+             << FStyle (fc::ColorOverlay);
+  printRepeated (w, L' ', width);
+  w->print() << FStyle (fc::Reset);
 
   if ( w->isMonochron() )
     w->setReverse(false);
@@ -215,7 +231,7 @@ void drawBlockShadow (FWidget* w)
   if ( w->isWindowWidget() )
     w->print() << FStyle (fc::InheritBackground);
 
-  w->print() << FString(width, fc::UpperHalfBlock);  // ▀
+  printRepeated (w, fc::UpperHalfBlock, width);  // ▀
 
   if ( w->isWindowWidget() )
     w->print() << FStyle (fc::Reset);
@@ -249,8 +265,8 @@ void clearShadow (FWidget* w)
 
   if ( int(height) <= w->woffset.getY2() )
   {
-    w->print() << FPoint(2, int(height) + 1)
-               << FString(width, L' ');  // clear ▀
+    w->print() << FPoint(2, int(height) + 1);
+    printRepeated (w, L' ', width);  // clear ▀
   }
 
   if ( w->isWindowWidget() )
@@ -426,9 +442,9 @@ inline void drawBox (FWidget* w, const FRect& r)
     return;
 
   w->print() << r.getUpperLeftPos()
-             << fc::BoxDrawingsDownAndRight   // ┌
-             << FString(r.getWidth() - 2, fc::BoxDrawingsHorizontal)  // ─
-             << fc::BoxDrawingsDownAndLeft;   // ┐
+             << fc::BoxDrawingsDownAndRight;   // ┌
+  printRepeated (w, fc::BoxDrawingsHorizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::BoxDrawingsDownAndLeft;   // ┐
 
   for (int y = r.getY1() + 1; y < r.getY2(); y++)
   {
@@ -439,9 +455,9 @@ inline void drawBox (FWidget* w, const FRect& r)
   }
 
   w->print() << r.getLowerLeftPos()
-             << fc::BoxDrawingsUpAndRight     // └
-             << FString(r.getWidth() - 2, fc::BoxDrawingsHorizontal)  // ─
-             << fc::BoxDrawingsUpAndLeft;     // ┘
+             << fc::BoxDrawingsUpAndRight;     // └
+  printRepeated (w, fc::BoxDrawingsHorizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::BoxDrawingsUpAndLeft;     // ┘
 }
 
 //----------------------------------------------------------------------
@@ -450,9 +466,9 @@ inline void drawNewFontBox (FWidget* w, const FRect& r)
   // Use new graphical font characters to draw a border
 
   w->print() << r.getUpperLeftPos()
-             << fc::NF_border_corner_middle_upper_left    // ┌
-             << FString(r.getWidth() - 2, fc::NF_border_line_horizontal)  // ─
-             << fc::NF_border_corner_middle_upper_right;  // ┐
+             << fc::NF_border_corner_middle_upper_left;    // ┌
+  printRepeated (w, fc::NF_border_line_horizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::NF_border_corner_middle_upper_right;  // ┐
 
   for (int y = r.getY1() + 1; y < r.getY2(); y++)
   {
@@ -463,18 +479,18 @@ inline void drawNewFontBox (FWidget* w, const FRect& r)
   }
 
   w->print() << r.getLowerLeftPos()
-             << fc::NF_border_corner_middle_lower_left    // └
-             << FString(r.getWidth() - 2, fc::NF_border_line_horizontal)  // ─
-             << fc::NF_border_corner_middle_lower_right;  // ┘
+             << fc::NF_border_corner_middle_lower_left;    // └
+  printRepeated (w, fc::NF_border_line_horizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::NF_border_corner_middle_lower_right;  // ┘
 }
 
 //----------------------------------------------------------------------
 inline void drawNewFontListBox (FWidget* w, const FRect& r)
 {
   w->print() << r.getUpperLeftPos()
-             << fc::NF_border_line_middle_left_down  // ┌
-             << FString(r.getWidth() - 2, fc::NF_border_line_horizontal)  // ─
-             << fc::NF_border_line_left_down;        // ╷
+             << fc::NF_border_line_middle_left_down;  // ┌
+  printRepeated (w, fc::NF_border_line_horizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::NF_border_line_left_down;        // ╷
 
   for (int y = r.getY1() + 1; y < r.getY2(); y++)
   {
@@ -485,9 +501,9 @@ inline void drawNewFontListBox (FWidget* w, const FRect& r)
   }
 
   w->print() << r.getLowerLeftPos()
-             << fc::NF_border_line_middle_right_up  // └
-             << FString(r.getWidth() - 2, fc::NF_border_line_horizontal)  // ─
-             << fc::NF_border_line_left_up;         // ╵
+             << fc::NF_border_line_middle_right_up;  // └
+  printRepeated (w, fc::NF_border_line_horizontal, r.getWidth() - 2);  // ─
+  w->print() << fc::NF_border_line_left_up;         // ╵
 }
 
 }  // namespace finalcut
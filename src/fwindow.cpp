@@ -272,7 +272,10 @@ void FWindow::drawBorder()
 void FWindow::show()
 {
   if ( isVirtualWindow() )
+  {
     getVWin()->visible = true;
+    invalidateWindowMap();
+  }
 
   FWidget::show();
 }
@@ -281,7 +284,10 @@ void FWindow::show()
 void FWindow::hide()
 {
   if ( isVirtualWindow() )
+  {
     getVWin()->visible = false;
+    invalidateWindowMap();
+  }
 
   FWidget::hide();
 }
@@ -292,7 +298,10 @@ void FWindow::setX (int x, bool adjust)
   FWidget::setX (x, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->offset_left = getTermX() - 1;
+    invalidateWindowMap();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -304,7 +313,10 @@ void FWindow::setY (int y, bool adjust)
   FWidget::setY (y, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->offset_top = getTermY() - 1;
+    invalidateWindowMap();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -322,6 +334,7 @@ void FWindow::setPos (const FPoint& p, bool adjust)
     auto virtual_win = getVWin();
     virtual_win->offset_left = getTermX() - 1;
     virtual_win->offset_top = getTermY() - 1;
+    invalidateWindowMap();
   }
 }
 
@@ -400,6 +413,8 @@ void FWindow::setGeometry ( const FPoint& p, const FSize& size, bool adjust)
 
     if ( getY() != old_y )
       getVWin()->offset_top = getTermY() - 1;
+
+    invalidateWindowMap();
   }
 }
 
@@ -413,6 +428,7 @@ void FWindow::move (const FPoint& pos)
     auto virtual_win = getVWin();
     virtual_win->offset_left = getTermX() - 1;
     virtual_win->offset_top = getTermY() - 1;
+    invalidateWindowMap();
   }
 }
 
@@ -450,6 +466,7 @@ void FWindow::addWindow (FWidget* obj)
   if ( getWindowList() )
     getWindowList()->push_back(obj);
 
+  invalidateWindowMap();
   processAlwaysOnTop();
 }
 
@@ -467,6 +484,7 @@ void FWindow::delWindow (FWidget* obj)
     if ( (*iter) == obj )
     {
       getWindowList()->erase(iter);
+      invalidateWindowMap();
       return;
     }
 
@@ -592,6 +610,7 @@ bool FWindow::raiseWindow (FWidget* obj)
     {
       getWindowList()->erase (iter);
       getWindowList()->push_back (obj);
+      invalidateWindowMap();
       FEvent ev(fc::WindowRaised_Event);
       FApplication::sendEvent(obj, &ev);
       processAlwaysOnTop();
@@ -632,6 +651,7 @@ bool FWindow::lowerWindow (FWidget* obj)
     {
       getWindowList()->erase (iter);
       getWindowList()->insert (getWindowList()->begin(), obj);
+      invalidateWindowMap();
       FEvent ev(fc::WindowLowered_Event);
       FApplication::sendEvent(obj, &ev);
       return true;
@@ -783,6 +803,8 @@ void FWindow::adjustSize()
 
     if ( getTermY() != old_y )
       getVWin()->offset_top = getTermY() - 1;
+
+    invalidateWindowMap();
   }
 }
 
@@ -56,7 +56,8 @@
 #endif
 
 #include <getopt.h>
-#include <deque>
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -79,6 +80,9 @@ class FTimerEvent;
 class FWheelEvent;
 class FMouseControl;
 class FKeyboard;
+class FEventQueue;
+class FPostQueue;
+class FThreadPool;
 class FPoint;
 class FObject;
 
@@ -106,6 +110,7 @@ class FApplication : public FWidget
     int                   getArgc() const;
     char**                getArgv() const;
     static FApplication*  getApplicationObject();
+    static FThreadPool*   getThreadPool();
 
     // Inquiry
     static bool           isQuit();
@@ -121,6 +126,9 @@ class FApplication : public FWidget
     static void           sendQueuedEvents ();
     static bool           eventInQueue();
     static bool           removeQueuedEvent (const FObject*);
+    static bool           postEvent (const FObject*, std::unique_ptr<FEvent>);
+    static bool           postTask (std::function<void()>);
+    static bool           cancelBackgroundJobs (const FObject*);
     static FWidget*       processParameters (const int&, char*[]);
     static void           showParameterUsage ()
     #if defined(__clang__) || defined(__GNUC__)
@@ -133,16 +141,14 @@ class FApplication : public FWidget
     void cb_exitApp (FWidget*, FDataPtr);
 
   private:
-    // Typedefs
-    typedef std::pair<const FObject*, std::shared_ptr<const FEvent> > eventPair;
-    typedef std::deque<eventPair> eventQueue;
-
     // Methods
     void                  init (uInt64, uInt64);
     static void           cmd_options (const int&, char*[]);
     static FStartOptions& getStartOptions();
     void                  findKeyboardWidget();
     bool                  isKeyPressed();
+    uInt64                getEventWaitTime();
+    uInt64                getTimerWaitTime();
     void                  keyPressed();
     void                  keyReleased();
     void                  escapeKeyPressed();
@@ -177,6 +183,7 @@ class FApplication : public FWidget
     void                  processMouseEvent();
     void                  processResizeEvent();
     void                  processCloseWidget();
+    void                  processPostedEvents();
     bool                  processNextEvent();
     void                  performTimerAction ( const FObject*
                                              , const FEvent* ) override;
@@ -187,7 +194,10 @@ class FApplication : public FWidget
     uInt64                key_timeout{100000};        // 100 ms
     uInt64                dblclick_interval{500000};  // 500 ms
     static FMouseControl* mouse;
-    static eventQueue*    event_queue;
+    static FEventQueue*   event_queue;
+    static std::atomic<FPostQueue*> post_queue;
+    static std::atomic<int> active_posts;  // posts in progress
+    static FThreadPool*   thread_pool;
     static int            quit_code;
     static bool           quit_now;
     static int            loop_level;
@@ -152,6 +152,7 @@ class FButton : public FWidget
 
     // Data members
     FString      text{};
+    FString      button_text{};  // text without the hotkey marker
     bool         button_down{false};
     bool         active_focus{false};
     bool         click_animation{true};
@@ -1107,6 +1107,8 @@ enum termcaps
   t_insert_padding,
   t_insert_character,
   t_parm_ich,
+  t_delete_character,
+  t_parm_dch,
   t_repeat_char,
   t_initialize_color,
   t_initialize_pair,
@@ -1137,6 +1139,13 @@ enum termcaps
   t_cursor_style,
   t_scroll_forward,
   t_scroll_reverse,
+  t_parm_index,
+  t_parm_rindex,
+  t_change_scroll_region,
+  t_insert_line,
+  t_delete_line,
+  t_parm_insert_line,
+  t_parm_delete_line,
   t_enter_ca_mode,
   t_exit_ca_mode,
   t_enable_acs,
@@ -0,0 +1,110 @@
+/***********************************************************************
+* fcharstyletable.h - Interned character styles for packed cells       *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FCharStyleTable ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FCHARSTYLETABLE_H
+#define FCHARSTYLETABLE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FCharStyleTable
+//----------------------------------------------------------------------
+
+class FCharStyleTable final
+{
+  public:
+    // Constants
+    static constexpr std::size_t MAX_STYLES = 65536;
+
+    // Constructor
+    FCharStyleTable() = default;
+
+    // Accessors
+    const FString         getClassName() const;
+    std::size_t           getSize() const;
+
+    // Inquiry
+    bool                  isFull() const;
+
+    // Methods
+    bool                  pack (const FChar&, FCharCell&);
+    FChar                 unpack (const FCharCell&) const;
+    void                  clear();
+    static bool           isEqual (const FCharCell&, const FCharCell&);
+    static std::size_t    getChangedCellPos ( const FCharCell*
+                                            , const FCharCell*
+                                            , std::size_t );
+
+  private:
+    // Methods
+    static uInt64         getStyleKey (const FChar&);
+    static uInt64         getCompareMask();
+
+    // Data members
+    std::vector<uInt64>                 style_list{};
+    std::unordered_map<uInt64, uInt16>  style_index{};
+};
+
+// FCharStyleTable inline functions
+//----------------------------------------------------------------------
+inline const FString FCharStyleTable::getClassName() const
+{ return "FCharStyleTable"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FCharStyleTable::getSize() const
+{ return style_list.size(); }
+
+//----------------------------------------------------------------------
+inline bool FCharStyleTable::isFull() const
+{ return style_list.size() >= MAX_STYLES; }
+
+//----------------------------------------------------------------------
+inline bool FCharStyleTable::isEqual ( const FCharCell& c1
+                                     , const FCharCell& c2 )
+{
+  // Cells with the same character and the same style index
+  // look the same on the terminal
+  return c1.ch == c2.ch && c1.style == c2.style;
+}
+
+}  // namespace finalcut
+
+#endif  // FCHARSTYLETABLE_H
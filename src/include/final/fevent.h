@@ -99,6 +99,7 @@ class FEvent  // event base class
   public:
     FEvent() = default;
     explicit FEvent(fc::events);
+    virtual ~FEvent();
     fc::events type() const;
 
   private:
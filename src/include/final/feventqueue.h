@@ -0,0 +1,181 @@
+/***********************************************************************
+* feventqueue.h - Queue of events in preallocated slots                *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     *▕▔▔▔▔▔▔▔▔▏
+ * ▕ FEventQueue ▏- - - -▕ FEvent ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▏
+ */
+
+// Each queued event is copied with its concrete type into a slot
+// that is large enough for every FEvent subclass. Released slots are
+// reused, so the queue allocates only when it needs more slots.
+// The events of a removed receiver are marked by a tombstone and
+// are discarded when they reach the front of the queue.
+
+#ifndef FEVENTQUEUE_H
+#define FEVENTQUEUE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "final/fevent.h"
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FObject;
+
+//----------------------------------------------------------------------
+// class FEventQueue
+//----------------------------------------------------------------------
+
+class FEventQueue final
+{
+  public:
+    // Constants
+    static constexpr std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+    struct FEventItem
+    {
+      const FObject* receiver{nullptr};
+      FEvent*        event{nullptr};
+      std::size_t    slot{NO_SLOT};
+    };
+
+    // Constructor
+    FEventQueue();
+
+    // Disable copy constructor
+    FEventQueue (const FEventQueue&) = delete;
+
+    // Destructor
+    ~FEventQueue();
+
+    // Disable assignment operator (=)
+    FEventQueue& operator = (const FEventQueue&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    std::size_t           getSlotCount() const;
+
+    // Inquiry
+    bool                  isEmpty() const;
+
+    // Methods
+    bool                  push (const FObject*, const FEvent*);
+    bool                  pop (FEventItem&);
+    void                  release (FEventItem&);
+    bool                  removeReceiver (const FObject*);
+    void                  clear();
+
+  private:
+    // Constants
+    static constexpr std::size_t BLOCK_SIZE = 64;  // Slots per block
+
+    // Typedefs
+    union FAnyEvent  // Only used for the size and the alignment
+    {
+      FEvent       event;
+      FKeyEvent    key_event;
+      FMouseEvent  mouse_event;
+      FWheelEvent  wheel_event;
+      FFocusEvent  focus_event;
+      FAccelEvent  accel_event;
+      FResizeEvent resize_event;
+      FShowEvent   show_event;
+      FHideEvent   hide_event;
+      FCloseEvent  close_event;
+      FTimerEvent  timer_event;
+      FUserEvent   user_event;
+    };
+
+    typedef std::aligned_storage< sizeof(FAnyEvent)
+                                , alignof(FAnyEvent) >::type FEventStorage;
+
+    struct FSlot
+    {
+      FEventStorage  storage;
+      FEvent*        event{nullptr};
+      const FObject* receiver{nullptr};
+      uInt64         sequence{0};
+      std::size_t    next{NO_SLOT};
+    };
+
+    struct FTombstone
+    {
+      const FObject* receiver{nullptr};
+      uInt64         sequence{0};  // Events queued before are removed
+    };
+
+    // Accessor
+    FSlot&                getSlot (std::size_t);
+
+    // Inquiry
+    bool                  isRemoved (const FSlot&) const;
+
+    // Methods
+    std::size_t           getFreeSlot();
+    void                  freeSlot (std::size_t);
+    static FEvent*        copyEvent (void*, const FEvent*);
+    template <typename EventT>
+    static FEvent*        copyEventAs (void*, const FEvent*);
+
+    // Data members
+    std::vector<std::unique_ptr<FSlot[]> > blocks{};
+    std::vector<FTombstone> tombstones{};
+    std::size_t           first{NO_SLOT};  // Oldest queued slot
+    std::size_t           last{NO_SLOT};   // Newest queued slot
+    std::size_t           free_slot{NO_SLOT};
+    uInt64                next_sequence{0};
+};
+
+// FEventQueue inline functions
+//----------------------------------------------------------------------
+inline const FString FEventQueue::getClassName() const
+{ return "FEventQueue"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FEventQueue::getSlotCount() const
+{ return blocks.size() * BLOCK_SIZE; }
+
+//----------------------------------------------------------------------
+inline bool FEventQueue::isEmpty() const
+{ return first == NO_SLOT; }
+
+//----------------------------------------------------------------------
+inline FEventQueue::FSlot& FEventQueue::getSlot (std::size_t index)
+{ return blocks[index / BLOCK_SIZE][index % BLOCK_SIZE]; }
+
+}  // namespace finalcut
+
+#endif  // FEVENTQUEUE_H
@@ -38,11 +38,13 @@
 #include <final/fcolorpair.h>
 #include <final/fcombobox.h>
 #include <final/fcharmap.h>
+#include <final/fcharstyletable.h>
 #include <final/fcheckbox.h>
 #include <final/fcheckmenuitem.h>
 #include <final/fdialog.h>
 #include <final/fdialoglistmenu.h>
 #include <final/fevent.h>
+#include <final/feventqueue.h>
 #include <final/ffiledialog.h>
 #include <final/fkeyboard.h>
 #include <final/flabel.h>
@@ -56,7 +58,11 @@
 #include <final/fmouse.h>
 #include <final/foptiattr.h>
 #include <final/foptimove.h>
+#include <final/foutputmonitor.h>
+#include <final/foutputwriter.h>
 #include <final/fpoint.h>
+#include <final/fpoll.h>
+#include <final/fpostqueue.h>
 #include <final/fprogressbar.h>
 #include <final/fradiobutton.h>
 #include <final/fradiomenuitem.h>
@@ -71,6 +77,7 @@
 #include <final/fstyle.h>
 #include <final/fswitch.h>
 #include <final/fsystem.h>
+#include <final/fsystemheadless.h>
 #include <final/fterm.h>
 #include <final/ftermbuffer.h>
 #include <final/ftermcap.h>
@@ -81,8 +88,10 @@
 #include <final/ftermios.h>
 #include <final/ftermxterminal.h>
 #include <final/ftextview.h>
+#include <final/fthreadpool.h>
 #include <final/ftogglebutton.h>
 #include <final/ftooltip.h>
+#include <final/ftrace.h>
 #include <final/ftypes.h>
 #include <final/fvterm.h>
 #include <final/fwidgetcolors.h>
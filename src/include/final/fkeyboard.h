@@ -104,6 +104,7 @@ class FKeyboard final
     const FString         getKeyName (const FKey);
     keybuffer&            getKeyBuffer();
     timeval*              getKeyPressedTime();
+    uInt64                getKeypressWaitTime();
 
     // Mutators
     void                  setTermcapMap (fc::FKeyMap*);
@@ -135,11 +135,12 @@ class FLabel : public FWidget
     void                draw() override;
     void                drawMultiLine();
     void                drawSingleLine();
-    void                printLine (FString&&);
+    void                printLine (FString&);
 
     // Data members
     FStringList         multiline_text{};
     FString             text{};
+    FString             label_text{};  // text without the hotkey marker
     FWidget*            accel_widget{nullptr};
     fc::text_alignment  alignment{fc::alignLeft};
     std::size_t         align_offset{0};
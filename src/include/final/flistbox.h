@@ -262,6 +262,7 @@ class FListBox : public FWidget
     void                drawScrollbars();
     void                drawHeadline();
     void                drawList();
+    void                drawListRows (std::size_t, std::size_t);
     void                drawListLine (int, listBoxItems::iterator, bool);
     void                printLeftBracket (fc::brackets_type);
     void                printRightBracket (fc::brackets_type);
@@ -49,6 +49,7 @@
 
 #include <list>
 #include <stack>
+#include <string>
 #include <vector>
 
 #include "final/fscrollbar.h"
@@ -185,7 +186,7 @@ class FListViewIterator
     // Typedefs
     typedef std::list<FObject*>   FObjectList;
     typedef FObjectList::iterator iterator;
-    typedef std::stack<iterator>  iterator_stack;
+    typedef std::stack<iterator, std::vector<iterator> >  iterator_stack;
 
     // Constructor
     FListViewIterator () = default;
@@ -396,7 +397,8 @@ class FListView : public FWidget
     void                 clearList();
     void                 setLineAttributes (bool, bool);
     FString              getCheckBox (const FListViewItem* item);
-    FString              getLinePrefix (const FListViewItem*, std::size_t);
+    void                 appendLinePrefix ( std::wstring&, const FListViewItem*
+                                          , std::size_t );
     void                 drawSortIndicator (std::size_t&, std::size_t);
     void                 drawHeadlineLabel (const headerItems::const_iterator&);
     void                 drawHeaderBorder (std::size_t);
@@ -453,6 +455,7 @@ class FListView : public FWidget
     FListViewIterator    last_visible_line{};
     headerItems          header{};
     FTermBuffer          headerline{};
+    std::wstring         line_buffer{};  // reused for each drawn line
     FScrollbarPtr        vbar{nullptr};
     FScrollbarPtr        hbar{nullptr};
     sortTypes            sort_type{};
@@ -465,6 +468,7 @@ class FListView : public FWidget
     std::size_t          max_line_width{1};
     fc::dragScroll       drag_scroll{fc::noScroll};
     int                  first_line_position_before{-1};
+    int                  last_first_line_position{-1};
     int                  scroll_repeat{100};
     int                  scroll_distance{1};
     int                  xoffset{0};
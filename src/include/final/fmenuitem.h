@@ -93,7 +93,7 @@ class FMenuItem : public FWidget
     FMenu*              getMenu() const;
     std::size_t         getTextLength() const;
     std::size_t         getTextWidth() const;
-    FString             getText() const;
+    const FString&      getText() const;
 
     // Mutators
     bool                setEnable (bool) override;
@@ -214,7 +214,7 @@ inline std::size_t FMenuItem::getTextWidth() const
 { return text_width; }
 
 //----------------------------------------------------------------------
-inline FString FMenuItem::getText() const
+inline const FString& FMenuItem::getText() const
 { return text; }
 
 //----------------------------------------------------------------------
@@ -41,7 +41,7 @@
   #error "Your C++ compiler does not support the C++11 standard!"
 #endif
 
-#include <sys/time.h>  // need for gettimeofday
+#include <sys/time.h>  // need for timeval
 #include <cstdlib>
 #include <cstring>
 #include <list>
@@ -120,7 +120,10 @@ class FObject
 
     // Timer methods
     static void           getCurrentTime (timeval*);
+    static void           getMonotonicTime (timeval*);
     static bool           isTimeout (timeval*, uInt64);
+    static bool           isMonotonicTimeout (timeval*, uInt64);
+    static bool           getNextTimerTimeout (timeval*);
     int                   addTimer (int);
     bool                  delTimer (int);
     bool                  delOwnTimer();
@@ -136,7 +139,7 @@ class FObject
     };
 
     // Typedefs
-    typedef std::vector<FTimerData> FTimerList;
+    typedef std::vector<FTimerData> FTimerList;  // min-heap by timeout
 
     // Accessor
     FTimerList*           getTimerList() const;
@@ -152,17 +155,34 @@ class FObject
     virtual void          onUserEvent (FUserEvent*);
 
   private:
-    // Method
+    // Constants
+    static constexpr std::size_t NOT_SCHEDULED = static_cast<std::size_t>(-1);
+
+    // Methods
     virtual void          performTimerAction ( const FObject*
                                              , const FEvent* );
+    static bool           isElapsed ( const timeval&, const timeval*
+                                    , uInt64 );
+    static int            getFreeTimerId();
+    static void           releaseTimerId (int);
+    static void           swapTimer (std::size_t, std::size_t);
+    static void           siftUpTimer (std::size_t);
+    static void           siftDownTimer (std::size_t);
+    static void           removeTimer (std::size_t);
 
     // Data members
     FObject*              parent_obj{nullptr};
     FObjectList           children_list{};  // no children yet
     bool                  has_parent{false};
     bool                  widget_object{false};
+    mutable std::size_t   queued_events{0};  // in the FEventQueue
     static bool           timer_modify_lock;
     static FTimerList*    timer_list;
+    static std::vector<std::size_t> timer_position;  // heap index by id
+    static std::vector<int> free_timer_ids;  // min-heap of released ids
+
+    // Friend class
+    friend class FEventQueue;
 };
 
 
@@ -128,6 +128,8 @@ class FOptiAttr final
 
     // Accessors
     const FString getClassName() const;
+    uInt64        getCacheHits() const;
+    uInt64        getCacheMisses() const;
 
     // Mutators
     void          setTermEnvironment (termEnv&);
@@ -171,17 +173,29 @@ class FOptiAttr final
     void          set_orig_pair (char[]);
     void          set_orig_orig_colors (char[]);
 
-    // Inquiry
+    // Inquiries
     static bool   isNormal (const FChar* const&);
+    bool          isDirectSGR() const;
 
     // Methods
     void          initialize();
     static FColor vga2ansi (FColor);
     char*         changeAttribute (FChar*&, FChar*&);
+    void          clearCache();
 
   private:
+    // Constants
+    static constexpr std::size_t ATTR_CACHE_SIZE = 256;  // Power of 2
+    static constexpr std::size_t CACHED_SEQUENCE_SIZE = 64;
+    static constexpr std::size_t COLOR_TABLE_SIZE = 256;
+    static constexpr std::size_t COLOR_PAIR_TABLE_SIZE = 16;
+    static constexpr std::size_t COLOR_SEQUENCE_SIZE = 32;
+    static constexpr std::size_t SGR_ATTRIBUTES = 10;
+    static constexpr std::size_t SGR_PARAMETER_SIZE = 128;
+
     // Typedefs and Enumerations
     typedef char attributebuffer[SGRoptimizer::ATTR_BUF_SIZE];
+    typedef char colorsequence[COLOR_SEQUENCE_SIZE];
 
     typedef struct
     {
@@ -189,6 +203,29 @@ class FOptiAttr final
       bool  caused_reset;
     } capability;
 
+    typedef struct
+    {
+      uInt64 term_key;    // Terminal attributes before the change
+      uInt64 next_key;    // Requested attributes
+      uInt64 term_state;  // Terminal attributes after the change
+      uInt64 next_state;  // Requested attributes after the adjustment
+      bool   valid;
+      bool   no_changes;
+      char   sequence[CACHED_SEQUENCE_SIZE];
+    } attrCacheEntry;
+
+    typedef struct
+    {
+      colorsequence fg;
+      colorsequence bg;
+    } colorTableEntry;
+
+    typedef struct
+    {
+      int enter;  // SGR parameter to switch the attribute on
+      int exit;   // SGR parameter to switch it off (0 = reset)
+    } sgrAttribute;
+
     enum init_reset_tests
     {
       no_test         = 0x00,
@@ -263,6 +300,14 @@ class FOptiAttr final
     static bool   hasNoAttribute (const FChar* const&);
 
     // Methods
+    char*         createAttributeSequence (FChar*&, FChar*&);
+    static uInt64 getAttributeKey (const FChar* const&);
+    static void   setAttributeKey (FChar*&, uInt64);
+    static std::size_t getCacheIndex (uInt64, uInt64);
+    void          storeCacheEntry ( attrCacheEntry&
+                                  , const FChar* const&
+                                  , const FChar* const&
+                                  , const char[] );
     bool          hasColorChanged (const FChar* const&, const FChar* const&);
     void          resetColor (FChar*&);
     void          prevent_no_color_video_attributes (FChar*&, bool = false);
@@ -272,6 +317,22 @@ class FOptiAttr final
     void          change_color (FChar*&, FChar*&);
     void          change_to_default_color (FChar*&, FChar*&, FColor&, FColor&);
     void          change_current_color (const FChar* const&, FColor, FColor);
+    void          initColorTable();
+    void          clearColorTable();
+    static bool   setColorSequence (colorsequence&, char[], int, int = 0);
+    char*         getForegroundSequence (char[], FColor, int);
+    char*         getBackgroundSequence (char[], FColor, int);
+    char*         getColorPairSequence (char[], FColor, FColor);
+    void          initDirectSGR();
+    static bool   isSGRSequence (const char[]);
+    static int    getSGRParameter (const char[]);
+    static uInt16 getSGRAttributes (const FChar* const&);
+    bool          canUseDirectSGR ( const FChar* const&
+                                  , const FChar* const& ) const;
+    void          changeAttributeDirectSGR (FChar*&, FChar*&);
+    void          addSGRColor (char[], FColor, bool) const;
+    static void   addSGRParameter (char[], const char[], std::size_t);
+    static void   addSGRParameter (char[], int);
     void          resetAttribute (FChar*&);
     void          reset (FChar*&);
     bool          caused_reset_attributes (char[], uChar = all_tests);
@@ -324,6 +385,15 @@ class FOptiAttr final
     FChar         reset_byte_mask{};
 
     SGRoptimizer  sgr_optimizer{attr_buf};
+    attrCacheEntry attr_cache[ATTR_CACHE_SIZE]{};
+    uInt64        cache_hits{0};
+    uInt64        cache_misses{0};
+    colorTableEntry color_table[COLOR_TABLE_SIZE]{};
+    colorsequence color_pair_table[COLOR_PAIR_TABLE_SIZE]
+                                  [COLOR_PAIR_TABLE_SIZE]{};
+    std::size_t   color_table_size{0};
+    std::size_t   color_pair_table_size{0};
+    sgrAttribute  sgr_attribute[SGR_ATTRIBUTES]{};
 
     int           max_color{1};
     int           attr_without_color{0};
@@ -333,6 +403,7 @@ class FOptiAttr final
     bool          alt_equal_pc_charset{false};
     bool          monochron{true};
     bool          fake_reverse{false};
+    bool          direct_sgr{false};
 };
 
 
@@ -341,21 +412,42 @@ class FOptiAttr final
 inline const FString FOptiAttr::getClassName() const
 { return "FOptiAttr"; }
 
+//----------------------------------------------------------------------
+inline uInt64 FOptiAttr::getCacheHits() const
+{ return cache_hits; }
+
+//----------------------------------------------------------------------
+inline uInt64 FOptiAttr::getCacheMisses() const
+{ return cache_misses; }
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::setMaxColor (const int& c)
-{ max_color = c; }
+{
+  max_color = c;
+  clearColorTable();
+  clearCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setNoColorVideo (int attr)
-{ attr_without_color = attr; }
+{
+  attr_without_color = attr;
+  clearCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setDefaultColorSupport()
-{ ansi_default_color = true; }
+{
+  ansi_default_color = true;
+  clearCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::unsetDefaultColorSupport()
-{ ansi_default_color = false; }
+{
+  ansi_default_color = false;
+  clearCache();
+}
 
 
 // FChar operator functions
@@ -97,6 +97,8 @@ class FOptiMove final
       char* t_repeat_char;
       char* t_clr_bol;
       char* t_clr_eol;
+      char* t_parm_ich;
+      char* t_parm_dch;
       int   tabstop;
       bool  automatic_left_margin;
       bool  eat_nl_glitch;
@@ -130,9 +132,12 @@ class FOptiMove final
     uInt          getRepeatCharLength() const;
     uInt          getClrBolLength() const;
     uInt          getClrEolLength() const;
+    uInt          getInsertCharsLength() const;
+    uInt          getDeleteCharsLength() const;
 
     // Mutators
     void          setBaudRate (int);
+    void          setThroughput (uInt64);
     void          setTabStop (int);
     void          setTermSize (std::size_t, std::size_t);
     void          setTermEnvironment (termEnv&);
@@ -156,6 +161,8 @@ class FOptiMove final
     void          set_repeat_char (char[]);
     void          set_clr_bol (char[]);
     void          set_clr_eol (char[]);
+    void          set_parm_ich (char[]);
+    void          set_parm_dch (char[]);
     void          set_auto_left_margin (bool);
     void          set_eat_newline_glitch (bool);
 
@@ -180,9 +187,12 @@ class FOptiMove final
     // value for a long capability waiting time
     static constexpr int MOVE_LIMIT{7};
     // maximum character distance to avoid direct cursor addressing
+    static constexpr int BAUD_BYTE{9};
+    // bits per character (7 bit + 1 parity + 1 stop)
 
     // Methods
     void          calculateCharDuration();
+    void          calculateCapDurations();
     int           capDuration (char[], int);
     int           capDurationToLength (int);
     int           repeatedAppend (const capability&, volatile int, char*);
@@ -224,6 +234,8 @@ class FOptiMove final
     capability    F_repeat_char{};
     capability    F_clr_bol{};
     capability    F_clr_eol{};
+    capability    F_parm_ich{};
+    capability    F_parm_dch{};
 
     std::size_t   screen_width{80};
     std::size_t   screen_height{24};
@@ -324,6 +336,14 @@ inline uInt FOptiMove::getClrBolLength() const
 inline uInt FOptiMove::getClrEolLength() const
 { return uInt(F_clr_eol.length); }
 
+//----------------------------------------------------------------------
+inline uInt FOptiMove::getInsertCharsLength() const
+{ return uInt(F_parm_ich.length); }
+
+//----------------------------------------------------------------------
+inline uInt FOptiMove::getDeleteCharsLength() const
+{ return uInt(F_parm_dch.length); }
+
 //----------------------------------------------------------------------
 inline void FOptiMove::set_auto_left_margin (bool bcap)
 { automatic_left_margin = bcap; }
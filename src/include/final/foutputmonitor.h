@@ -0,0 +1,112 @@
+/***********************************************************************
+* foutputmonitor.h - Measures the throughput of the terminal output    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FOutputMonitor ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FOUTPUTMONITOR_H
+#define FOUTPUTMONITOR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <sys/time.h>  // need for timeval
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FSystem;
+
+//----------------------------------------------------------------------
+// class FOutputMonitor
+//----------------------------------------------------------------------
+
+class FOutputMonitor final
+{
+  public:
+    // Constants
+    static constexpr uInt64 MIN_SAMPLE_TIME = 10000;  // 10 ms
+    static constexpr uInt64 MIN_WRITE_TIME = 1000;    // 1 ms
+    static constexpr int    MAX_UNKNOWN_QUEUE = 4096;
+
+    // Constructor
+    FOutputMonitor (FSystem*, int);
+
+    // Accessors
+    const FString         getClassName() const;
+    int                   getQueueLength() const;
+    uInt64                getThroughput() const;
+    uInt64                getDrainTime (uInt64) const;
+
+    // Inquiry
+    bool                  isBacklogged (uInt64) const;
+
+    // Methods
+    void                  addWrittenBytes (std::size_t);
+    bool                  addWriteTime (std::size_t, uInt64);
+    bool                  measure (const timeval&);
+
+  private:
+    // Methods
+    int                   readQueueLength();
+    void                  updateThroughput (uInt64);
+
+    // Data members
+    FSystem*  fsystem{nullptr};
+    int       output_fd{-1};
+    int       queue_length{0};    // bytes in the terminal output queue
+    int       sample_queue{-1};   // queue length at the sample start
+    timeval   sample_time{};      // time of the sample start
+    uInt64    written_bytes{0};   // bytes written since the sample start
+    uInt64    throughput{0};      // bytes per second (0 = unknown)
+};
+
+// FOutputMonitor inline functions
+//----------------------------------------------------------------------
+inline const FString FOutputMonitor::getClassName() const
+{ return "FOutputMonitor"; }
+
+//----------------------------------------------------------------------
+inline int FOutputMonitor::getQueueLength() const
+{ return queue_length; }
+
+//----------------------------------------------------------------------
+inline uInt64 FOutputMonitor::getThroughput() const
+{ return throughput; }
+
+//----------------------------------------------------------------------
+inline void FOutputMonitor::addWrittenBytes (std::size_t bytes)
+{ written_bytes += bytes; }
+
+}  // namespace finalcut
+
+#endif  // FOUTPUTMONITOR_H
@@ -0,0 +1,118 @@
+/***********************************************************************
+* foutputwriter.h - Writes the terminal output in a separate thread    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FOutputWriter ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FOUTPUTWRITER_H
+#define FOUTPUTWRITER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FSystem;
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+class FOutputWriter final
+{
+  public:
+    // Constants
+    static constexpr uInt64 WAIT_INTERVAL = 100000;       // 100 ms
+    static constexpr uInt64 MAX_SHUTDOWN_WAIT = 1000000;  // 1 s
+
+    // Constructor
+    FOutputWriter (FSystem*, int);
+
+    // Disable copy constructor
+    FOutputWriter (const FOutputWriter&) = delete;
+
+    // Destructor
+    ~FOutputWriter();
+
+    // Disable assignment operator (=)
+    FOutputWriter& operator = (const FOutputWriter&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    bool                  getWriteTime (std::size_t&, uInt64&);
+
+    // Inquiry
+    bool                  isBusy();
+
+    // Methods
+    void                  write (std::string&);
+    void                  waitForCompletion();
+
+  private:
+    // Methods
+    void                  openOutput (int);
+    void                  run();
+    void                  writeData (const std::string&);
+    bool                  waitForOutput();
+    bool                  isTerminating();
+
+    // Data members
+    FSystem*                 fsystem{nullptr};
+    int                      output_fd{-1};
+    bool                     own_output_fd{false};
+    std::string              pending_data{};
+    std::string              active_data{};
+    std::size_t              write_length{0};  // bytes of the last write
+    uInt64                   write_time{0};    // duration in microseconds
+    uInt64                   shutdown_wait{0};  // used by the writer thread
+    bool                     writing{false};
+    bool                     terminate{false};
+    std::mutex               mutex{};
+    std::condition_variable  data_available{};
+    std::condition_variable  data_written{};
+    std::thread              thread{};
+};
+
+// FOutputWriter inline functions
+//----------------------------------------------------------------------
+inline const FString FOutputWriter::getClassName() const
+{ return "FOutputWriter"; }
+
+}  // namespace finalcut
+
+#endif  // FOUTPUTWRITER_H
@@ -0,0 +1,136 @@
+/***********************************************************************
+* fpoll.h - Waits for input, file descriptor events and signals        *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▏
+ * ▕ FPoll ▏
+ * ▕▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FPOLL_H
+#define FPOLL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <poll.h>
+
+#include <atomic>
+#include <functional>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FSystem;
+
+//----------------------------------------------------------------------
+// class FPoll
+//----------------------------------------------------------------------
+
+class FPoll final
+{
+  public:
+    // Constants
+    static constexpr uInt64 NO_TIMEOUT = static_cast<uInt64>(-1);
+
+    // Enumeration
+    enum io_events
+    {
+      no_event = 0x00,
+      readable = 0x01,  // includes end of file and errors
+      writable = 0x02
+    };
+
+    // Typedef
+    typedef std::function<void(int, int)> FWatchCallback;  // fd, io_events
+
+    // Constructor
+    FPoll();
+
+    // Disable copy constructor
+    FPoll (const FPoll&) = delete;
+
+    // Destructor
+    virtual ~FPoll();
+
+    // Disable assignment operator (=)
+    FPoll& operator = (const FPoll&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    static std::size_t    getWatchCount();
+
+    // Inquiry
+    static bool           isWatched (int);
+
+    // Methods
+    static bool           init();
+    static void           finish();
+    static bool           addWatch (int, int, const FWatchCallback&);
+    static bool           setWatchEvents (int, int);
+    static bool           delWatch (int);
+    static bool           waitForInput (int, uInt64);
+    static bool           waitForOutput (FSystem*, int, uInt64 = NO_TIMEOUT);
+    static void           wakeUp();
+
+  private:
+    // Typedef
+    struct FWatch
+    {
+      int            fd;
+      int            events;
+      FWatchCallback callback;
+    };
+
+    // Methods
+    static short          toPollEvents (int);
+    static int            fromPollEvents (short);
+    static int            toMilliseconds (uInt64);
+    static void           dispatch (const pollfd&);
+    static void           clearWakeUp();
+
+    // Data members
+    static std::vector<FWatch>  watch_list;
+    static std::vector<pollfd>  poll_list;  // reused for each wait
+    static std::atomic<int>     wakeup_pipe[2];
+};
+
+// FPoll inline functions
+//----------------------------------------------------------------------
+inline const FString FPoll::getClassName() const
+{ return "FPoll"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FPoll::getWatchCount()
+{ return watch_list.size(); }
+
+}  // namespace finalcut
+
+#endif  // FPOLL_H
@@ -0,0 +1,120 @@
+/***********************************************************************
+* fpostqueue.h - Lock-free queue for events from other threads         *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▏1     *▕▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FPostQueue ▏- - - -▕ FPostItem ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// Any number of threads can push items into the queue,
+// but only the thread of the event loop may pop them
+// (multiple producer, single consumer)
+
+#ifndef FPOSTQUEUE_H
+#define FPOSTQUEUE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "final/fevent.h"
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FObject;
+
+//----------------------------------------------------------------------
+// class FPostQueue
+//----------------------------------------------------------------------
+
+class FPostQueue final
+{
+  public:
+    // Typedef
+    typedef std::function<void()> FTask;
+
+    struct FPostItem
+    {
+      const FObject*          receiver{nullptr};
+      std::unique_ptr<FEvent> event{};
+      FTask                   task{};
+    };
+
+    // Constructor
+    FPostQueue();
+
+    // Disable copy constructor
+    FPostQueue (const FPostQueue&) = delete;
+
+    // Destructor
+    ~FPostQueue();
+
+    // Disable assignment operator (=)
+    FPostQueue& operator = (const FPostQueue&) = delete;
+
+    // Accessor
+    const FString         getClassName() const;
+
+    // Inquiry
+    bool                  isEmpty() const;
+
+    // Methods
+    void                  push (const FObject*, std::unique_ptr<FEvent>);
+    void                  push (FTask);
+    bool                  pop (FPostItem&);
+    bool                  removeReceiver (const FObject*);
+
+  private:
+    struct FNode
+    {
+      std::atomic<FNode*> next{nullptr};
+      FPostItem           item{};
+    };
+
+    // Methods
+    void                  pushNode (FNode*);
+    FNode*                popNode();
+
+    // Data members
+    std::atomic<FNode*>   head;  // Last pushed node (producers)
+    FNode*                tail;  // Next node to pop (consumer)
+    FNode                 stub{};
+};
+
+// FPostQueue inline functions
+//----------------------------------------------------------------------
+inline const FString FPostQueue::getClassName() const
+{ return "FPostQueue"; }
+
+}  // namespace finalcut
+
+#endif  // FPOSTQUEUE_H
@@ -82,7 +82,10 @@ class FStartOptions final
     uInt8 sgr_optimizer         : 1;
     uInt8 vgafont               : 1;
     uInt8 newfont               : 1;
+    uInt8 async_output          : 1;
     fc::encoding encoding;
+    uInt max_fps;
+    FString trace_file;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
     uInt8 meta_sends_escape     : 1;
@@ -35,7 +35,12 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
+#include <poll.h>
 #include <pwd.h>
+#include <sys/types.h>
+#include <termios.h>
+
+#include <cstddef>
 #include "final/ftypes.h"
 
 namespace finalcut
@@ -54,6 +59,9 @@ class FSystem
     // Destructor
     virtual ~FSystem();
 
+    // Inquiry
+    virtual bool  canQueryTerminal();
+
     // Methods
     virtual uChar inPortByte (uShort) = 0;
     virtual void  outPortByte (uChar, uShort) = 0;
@@ -64,7 +72,11 @@ class FSystem
     virtual FILE* fopen (const char*, const char*) = 0;
     virtual int   fclose (FILE*) = 0;
     virtual int   putchar (int) = 0;
+    virtual ssize_t write (int, const void*, std::size_t) = 0;
     virtual int   tputs (const char*, int, int (*)(int)) = 0;
+    virtual int   tcgetattr (int, struct termios*);
+    virtual int   tcsetattr (int, int, const struct termios*);
+    virtual int   poll (struct pollfd*, nfds_t, int);
     virtual uid_t getuid() = 0;
     virtual uid_t geteuid() = 0;
     virtual int   getpwuid_r ( uid_t, struct passwd*, char*
@@ -72,6 +84,23 @@ class FSystem
     virtual char* realpath (const char*, char*) = 0;
 };
 
+// FSystem inline functions
+//----------------------------------------------------------------------
+inline bool FSystem::canQueryTerminal()
+{ return true; }
+
+//----------------------------------------------------------------------
+inline int FSystem::tcgetattr (int fd, struct termios* t)
+{ return ::tcgetattr (fd, t); }
+
+//----------------------------------------------------------------------
+inline int FSystem::tcsetattr (int fd, int actions, const struct termios* t)
+{ return ::tcsetattr (fd, actions, t); }
+
+//----------------------------------------------------------------------
+inline int FSystem::poll (struct pollfd* fds, nfds_t nfds, int timeout)
+{ return ::poll (fds, nfds, timeout); }
+
 }  // namespace finalcut
 
 #endif  // FSYSTEM_H
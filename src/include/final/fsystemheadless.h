@@ -0,0 +1,191 @@
+/***********************************************************************
+* fsystemheadless.h - FSystem with an in-memory terminal               *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Inheritance diagram
+ *  ═══════════════════
+ *
+ *     ▕▔▔▔▔▔▔▔▔▔▏
+ *     ▕ FSystem ▏
+ *     ▕▁▁▁▁▁▁▁▁▁▏
+ *          ▲
+ *          │
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FSystemHeadless ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FSYSTEMHEADLESS_H
+#define FSYSTEMHEADLESS_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <string>
+#include <vector>
+
+#include "final/fpoint.h"
+#include "final/fstring.h"
+#include "final/fsystem.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FSystemHeadless
+//----------------------------------------------------------------------
+
+class FSystemHeadless : public FSystem
+{
+  public:
+    // Constructor
+    explicit FSystemHeadless ( std::size_t = 80, std::size_t = 24
+                             , const char* = "xterm-256color" );
+
+    // Disable copy constructor
+    FSystemHeadless (const FSystemHeadless&) = delete;
+
+    // Destructor
+    ~FSystemHeadless() override;
+
+    // Disable assignment operator (=)
+    FSystemHeadless& operator = (const FSystemHeadless&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    std::size_t           getWidth() const;
+    std::size_t           getHeight() const;
+    const std::string&    getOutput() const;
+    wchar_t               getCharacter (const FPoint&) const;
+    const FString         getLine (int) const;
+    const FPoint&         getCursorPos() const;
+
+    // Mutator
+    void                  setSize (std::size_t, std::size_t);
+
+    // Inquiry
+    bool                  canQueryTerminal() override;
+
+    // Methods
+    void                  clearOutput();
+    uChar                 inPortByte (uShort) override;
+    void                  outPortByte (uChar, uShort) override;
+    int                   isTTY (int) override;
+    int                   ioctl (int, uLong, ...) override;
+    int                   open (const char*, int, ...) override;
+    int                   close (int) override;
+    FILE*                 fopen (const char*, const char*) override;
+    int                   fclose (FILE*) override;
+    int                   putchar (int) override;
+    ssize_t               write (int, const void*, std::size_t) override;
+    int                   tputs (const char*, int, int (*)(int)) override;
+    int                   tcgetattr (int, struct termios*) override;
+    int                   tcsetattr (int, int, const struct termios*) override;
+    int                   poll (struct pollfd*, nfds_t, int) override;
+    uid_t                 getuid() override;
+    uid_t                 geteuid() override;
+    int                   getpwuid_r ( uid_t, struct passwd*, char*
+                                     , size_t, struct passwd** ) override;
+    char*                 realpath (const char*, char*) override;
+
+  private:
+    // Enumeration
+    enum parser_state
+    {
+      ground,
+      escape,
+      charset,
+      control_sequence,
+      string_sequence,
+      string_escape
+    };
+
+    // Methods
+    void                  parse (char);
+    void                  parseEscape (char);
+    void                  parseControlSequence();
+    void                  parseUTF8 (uChar);
+    void                  printCharacter (wchar_t);
+    void                  lineFeed();
+    void                  reverseLineFeed();
+    void                  scrollUp (int, int, int);
+    void                  scrollDown (int, int, int);
+    void                  clearCells (int, int, int);
+    void                  eraseInDisplay (int);
+    void                  eraseInLine (int);
+    void                  insertCharacters (int);
+    void                  deleteCharacters (int);
+    void                  setCursor (int, int);
+    int                   getParameter (std::size_t, int = 1) const;
+    wchar_t&              cell (int, int);
+
+    // Data members
+    std::size_t           width{80};
+    std::size_t           height{24};
+    std::string           output{};
+    std::vector<wchar_t>  screen{};
+    FPoint                cursor{0, 0};
+    FPoint                saved_cursor{0, 0};
+    int                   scroll_top{0};
+    int                   scroll_bottom{23};
+    bool                  wrap_pending{false};
+    wchar_t               last_character{L' '};
+    parser_state          state{ground};
+    std::string           sequence{};   // parameters of the sequence
+    std::vector<int>      parameter{};
+    uInt                  utf8_value{0};
+    int                   utf8_remaining{0};
+    struct termios        tty_settings{};
+};
+
+// FSystemHeadless inline functions
+//----------------------------------------------------------------------
+inline const FString FSystemHeadless::getClassName() const
+{ return "FSystemHeadless"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FSystemHeadless::getWidth() const
+{ return width; }
+
+//----------------------------------------------------------------------
+inline std::size_t FSystemHeadless::getHeight() const
+{ return height; }
+
+//----------------------------------------------------------------------
+inline const std::string& FSystemHeadless::getOutput() const
+{ return output; }
+
+//----------------------------------------------------------------------
+inline const FPoint& FSystemHeadless::getCursorPos() const
+{ return cursor; }
+
+//----------------------------------------------------------------------
+inline bool FSystemHeadless::canQueryTerminal()
+{ return false; }  // Nobody answers terminal requests
+
+//----------------------------------------------------------------------
+inline void FSystemHeadless::clearOutput()
+{ output.clear(); }
+
+}  // namespace finalcut
+
+#endif  // FSYSTEMHEADLESS_H
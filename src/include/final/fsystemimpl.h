@@ -170,6 +170,11 @@ class FSystemImpl : public FSystem
 #endif
     }
 
+    ssize_t write (int fd, const void* buf, std::size_t count) override
+    {
+      return ::write (fd, buf, count);
+    }
+
     int tputs (const char* str, int affcnt, int (*putc)(int)) override
     {
 #if defined(__sun) && defined(__SVR4)
@@ -241,6 +241,7 @@ class FTerm final
     static bool            hasShadowCharacter();
     static bool            hasHalfBlockCharacter();
     static bool            hasAlternateScreen();
+    static bool            hasSynchronizedOutput();
     static bool            canChangeColorPalette();
 
     // Mutators
@@ -429,13 +430,10 @@ inline void FTerm::putstringf (const char format[], Args&&... args)
   if ( size == -1 )
     return;
 
-  if ( ! fsys )
-    getFSystem();
-
   const std::size_t count = std::size_t(size);
   std::vector<char> buf(count);
   std::snprintf (&buf[0], count, format, std::forward<Args>(args)...);
-  fsys->tputs (&buf[0], 1, FTerm::putchar_ASCII);
+  putstring (&buf[0], 1);
 }
 
 }  // namespace finalcut
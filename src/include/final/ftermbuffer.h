@@ -70,6 +70,10 @@ class FTermBuffer
     // Overloaded operators
     template <typename typeT>
     FTermBuffer& operator << (const typeT&);
+    FTermBuffer& operator << (char);
+    FTermBuffer& operator << (wchar_t);
+    FTermBuffer& operator << (fc::SpecialCharacter);
+    FTermBuffer& operator << (const FString&);
     FTermBuffer& operator << (const FCharVector&);
     FTermBuffer& operator << (const std::string&);
     FTermBuffer& operator << (const std::wstring&);
@@ -131,6 +135,40 @@ inline FTermBuffer& FTermBuffer::operator << (const typeT& s)
   return *this;
 }
 
+//----------------------------------------------------------------------
+inline FTermBuffer& FTermBuffer::operator << (char c)
+{
+  if ( uChar(c) < 0x80 )
+    write (wchar_t(c));
+  else
+    write (FString{c});
+
+  return *this;
+}
+
+//----------------------------------------------------------------------
+inline FTermBuffer& FTermBuffer::operator << (wchar_t c)
+{
+  write (c);
+  return *this;
+}
+
+//----------------------------------------------------------------------
+inline FTermBuffer& FTermBuffer::operator << (fc::SpecialCharacter c)
+{
+  write (static_cast<wchar_t>(c));  // Required under Solaris
+  return *this;
+}
+
+//----------------------------------------------------------------------
+inline FTermBuffer& FTermBuffer::operator << (const FString& string)
+{
+  if ( ! string.isNull() )
+    write (string);
+
+  return *this;
+}
+
 //----------------------------------------------------------------------
 inline FTermBuffer& FTermBuffer::operator << (const FCharVector& vec)
 {
@@ -209,8 +247,7 @@ inline FChar FTermBuffer::back() const
 //----------------------------------------------------------------------
 inline void FTermBuffer::clear()
 {
-  data.clear();
-  data.shrink_to_fit();
+  data.clear();  // Keeps the capacity for reuse
 }
 
 //----------------------------------------------------------------------
@@ -121,6 +121,7 @@ class FTermDetection final
     static bool           canDisplay256Colors();
     static bool           hasTerminalDetection();
     static bool           hasSetCursorStyleSupport();
+    static bool           hasSynchronizedOutput();
 
     // Mutators
     static void           setAnsiTerminal (bool);
@@ -181,6 +182,8 @@ class FTermDetection final
     static char*          secDA_Analysis_84 (char[]);
     static char*          secDA_Analysis_85 ();
     static char*          secDA_Analysis_vte (char[]);
+    static void           parseSynchronizedOutput();
+    static int            getSynchronizedOutputMode();
 
     // Data members
 #if DEBUG
@@ -191,6 +194,7 @@ class FTermDetection final
     static char           termtype[256];
     static char           ttytypename[256];
     static bool           decscusr_support;
+    static bool           sync_output_support;
     static bool           terminal_detection;
     static bool           color256;
     static int            gnome_terminal_id;
@@ -258,6 +262,10 @@ inline bool FTermDetection::canDisplay256Colors()
 inline bool FTermDetection::hasSetCursorStyleSupport()
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline bool FTermDetection::hasSynchronizedOutput()
+{ return sync_output_support; }
+
 //----------------------------------------------------------------------
 inline bool FTermDetection::isXTerminal()
 { return terminal_type.xterm; }
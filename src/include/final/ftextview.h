@@ -151,6 +151,7 @@ class FTextView : public FWidget
     void                drawBorder() override;
     void                drawScrollbars();
     void                drawText();
+    void                drawText (std::size_t, std::size_t);
     bool                useFDialogBorder();
     bool                isPrintable (wchar_t);
     void                processChanged();
@@ -168,6 +169,7 @@ class FTextView : public FWidget
     bool               update_scrollbar{true};
     int                xoffset{0};
     int                yoffset{0};
+    int                last_yoffset{-1};
     int                nf_offset{0};
     std::size_t        maxLineWidth{0};
 };
@@ -0,0 +1,153 @@
+/***********************************************************************
+* fthreadpool.h - Runs jobs in background threads                      *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FThreadPool ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// Each worker thread takes the oldest job from its own queue and
+// steals the newest job from another queue when its own is empty.
+// The done function of a job is called in the event loop thread.
+
+#ifndef FTHREADPOOL_H
+#define FTHREADPOOL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "final/fstring.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FObject;
+
+//----------------------------------------------------------------------
+// class FThreadPool
+//----------------------------------------------------------------------
+
+class FThreadPool final
+{
+  public:
+    // Typedef
+    typedef std::function<void()> FJobFunction;
+
+    // Constructor
+    explicit FThreadPool (std::size_t = 0);
+
+    // Disable copy constructor
+    FThreadPool (const FThreadPool&) = delete;
+
+    // Destructor
+    ~FThreadPool();
+
+    // Disable assignment operator (=)
+    FThreadPool& operator = (const FThreadPool&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    std::size_t           getThreadCount() const;
+    std::size_t           getJobCount();
+
+    // Inquiry
+    static bool           isCanceled();
+
+    // Methods
+    bool                  submit ( const FObject*
+                                 , FJobFunction
+                                 , FJobFunction = nullptr );
+    bool                  cancel (const FObject*);
+    void                  cancelAll();
+
+  private:
+    // Constants
+    static constexpr std::size_t MAX_THREADS = 4;
+
+    // Typedefs
+    struct FJobState
+    {
+      const FObject*    owner{nullptr};
+      std::atomic<bool> canceled{false};
+      bool              running{false};  // Guarded by the pool mutex
+    };
+
+    typedef std::shared_ptr<FJobState> FJobStatePtr;
+
+    struct FJob
+    {
+      FJobStatePtr state{};
+      FJobFunction work{};
+      FJobFunction done{};
+    };
+
+    struct FWorker
+    {
+      std::deque<FJob> job_queue{};  // Guarded by the pool mutex
+      std::thread      thread{};
+    };
+
+    // Methods
+    void                  run (std::size_t);
+    bool                  takeJob (std::size_t, FJob&);
+    void                  runJob (FJob&);
+    void                  finishJob (const FJobStatePtr&);
+
+    // Data members
+    std::vector<std::unique_ptr<FWorker> > workers{};
+    std::vector<FJobStatePtr>  job_list{};  // Submitted, not finished
+    std::atomic<std::size_t>   next_worker{0};
+    bool                       terminate{false};
+    std::mutex                 mutex{};
+    std::condition_variable    job_available{};
+    std::condition_variable    job_finished{};
+    static thread_local FThreadPool* current_pool;
+    static thread_local std::size_t  current_worker;
+    static thread_local FJobState*   current_job;
+};
+
+// FThreadPool inline functions
+//----------------------------------------------------------------------
+inline const FString FThreadPool::getClassName() const
+{ return "FThreadPool"; }
+
+//----------------------------------------------------------------------
+inline std::size_t FThreadPool::getThreadCount() const
+{ return workers.size(); }
+
+}  // namespace finalcut
+
+#endif  // FTHREADPOOL_H
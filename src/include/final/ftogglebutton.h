@@ -147,12 +147,13 @@ class FToggleButton : public FWidget
 
     // Methods
     void                init();
-    void                drawText (FString&&, std::size_t);
+    void                drawText (const FString&, std::size_t);
     void                correctSize (FSize&);
 
     // Data members
     FButtonGroup* button_group{nullptr};
     FString       text{};
+    FString       label_text{};  // text without the hotkey marker
     std::size_t   label_offset_pos{0};
     std::size_t   button_width{0};  // plus margin spaces
     bool          focus_inside_group{true};
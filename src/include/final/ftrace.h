@@ -0,0 +1,213 @@
+/***********************************************************************
+* ftrace.h - Records a timeline of the event loop                      *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▏
+ * ▕ FTrace ▏
+ * ▕▁▁▁▁▁▁▁▁▏
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTraceScope ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FTRACE_H
+#define FTRACE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <csignal>
+#include <string>
+#include <vector>
+
+#include "final/fstring.h"
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+// class forward declaration
+class FObject;
+
+//----------------------------------------------------------------------
+// class FTrace
+//----------------------------------------------------------------------
+
+class FTrace final
+{
+  public:
+    // Constants
+    static constexpr std::size_t DEFAULT_CAPACITY = 65536;  // spans
+    static constexpr std::size_t MAX_NAME_LENGTH = 47;
+
+    // Typedef
+    typedef struct
+    {
+      char          name[MAX_NAME_LENGTH + 1];
+      const char*   category;  // static string
+      const void*   object;    // traced object or nullptr
+      uInt64        start;     // nanoseconds since start()
+      uInt64        duration;  // nanoseconds
+    } FTraceEvent;
+
+    // Constructor
+    FTrace();
+
+    // Disable copy constructor
+    FTrace (const FTrace&) = delete;
+
+    // Destructor
+    virtual ~FTrace();
+
+    // Disable assignment operator (=)
+    FTrace& operator = (const FTrace&) = delete;
+
+    // Accessors
+    const FString         getClassName() const;
+    static const FString& getFileName();
+    static std::size_t    getEventCount();
+    static uInt64         getTimeStamp();
+
+    // Inquiries
+    static bool           isEnabled();
+    static bool           isDumpRequested();
+
+    // Methods
+    static void           start (const FString&, std::size_t = DEFAULT_CAPACITY);
+    static void           stop();
+    static void           addEvent ( const char*, const char*, const void*
+                                   , uInt64, uInt64 );
+    static bool           dump();
+
+  private:
+    // Constants
+    static constexpr std::size_t BUFFER_SIZE = 4096;
+
+    // Typedef
+    typedef struct
+    {
+      int           fd;
+      std::size_t   length;
+      bool          error;
+      char          data[BUFFER_SIZE];
+    } FTraceOutput;
+
+    // Methods
+    static void           writeEvent (FTraceOutput&, const FTraceEvent&, int);
+    static void           write (FTraceOutput&, const char*);
+    static void           write (FTraceOutput&, char);
+    static void           writeNumber ( FTraceOutput&, uInt64
+                                      , uInt = 10, std::size_t = 1 );
+    static void           flushOutput (FTraceOutput&);
+    static void           signal_handler (int);
+
+    // Data members
+    static std::vector<FTraceEvent>  ring;
+    static std::size_t               next;   // next ring position
+    static std::size_t               count;  // recorded spans
+    static FString                   filename;
+    static std::string               file_path;  // filename as bytes
+    static uInt64                    start_time;
+    static bool                      enabled;
+    static volatile std::sig_atomic_t dump_requested;
+    static struct sigaction          previous_action;  // of SIGUSR1
+};
+
+// FTrace inline functions
+//----------------------------------------------------------------------
+inline const FString FTrace::getClassName() const
+{ return "FTrace"; }
+
+//----------------------------------------------------------------------
+inline const FString& FTrace::getFileName()
+{ return filename; }
+
+//----------------------------------------------------------------------
+inline std::size_t FTrace::getEventCount()
+{ return count; }
+
+//----------------------------------------------------------------------
+inline bool FTrace::isEnabled()
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline bool FTrace::isDumpRequested()
+{ return dump_requested != 0; }
+
+
+//----------------------------------------------------------------------
+// class FTraceScope
+//----------------------------------------------------------------------
+
+class FTraceScope final
+{
+  public:
+    // Constructors
+    FTraceScope (const char*, const char*);
+    FTraceScope (const FObject*, const char*);
+
+    // Disable copy constructor
+    FTraceScope (const FTraceScope&) = delete;
+
+    // Destructor
+    ~FTraceScope();
+
+    // Disable assignment operator (=)
+    FTraceScope& operator = (const FTraceScope&) = delete;
+
+  private:
+    // Data members
+    const char*   name{nullptr};
+    const char*   category{nullptr};
+    const void*   object{nullptr};
+    uInt64        start{0};
+    char          object_name[FTrace::MAX_NAME_LENGTH + 1]{};
+};
+
+// FTraceScope inline functions
+//----------------------------------------------------------------------
+inline FTraceScope::FTraceScope (const char* n, const char* c)
+{
+  // Records the span from here to the end of the scope
+
+  if ( ! FTrace::isEnabled() )
+    return;
+
+  name = n;
+  category = c;
+  start = FTrace::getTimeStamp();
+}
+
+//----------------------------------------------------------------------
+inline FTraceScope::~FTraceScope()
+{
+  if ( name && FTrace::isEnabled() )
+    FTrace::addEvent (name, category, object, start, FTrace::getTimeStamp());
+}
+
+}  // namespace finalcut
+
+#endif  // FTRACE_H
@@ -150,6 +150,14 @@ typedef struct
   } attr;
 } FChar;
 
+typedef struct
+{
+  uInt32 ch;     // character code
+  uInt16 style;  // index in the interned style table (FCharStyleTable)
+  uInt8  state;  // attribute byte #2 (no_changes, printed, char_width)
+  uInt8  : 8;    // padding byte
+} FCharCell;
+
 namespace fc
 {
 
@@ -48,7 +48,8 @@
   #error "Only <final/final.h> can be included directly."
 #endif
 
-#include <queue>
+#include <sys/time.h>  // need for timeval
+
 #include <sstream>  // std::stringstream
 #include <string>
 #include <utility>
@@ -69,6 +70,8 @@ namespace finalcut
 class FColorPair;
 class FKeyboard;
 class FMouseControl;
+class FOutputMonitor;
+class FOutputWriter;
 class FPoint;
 class FRect;
 class FSize;
@@ -87,13 +90,43 @@ class FWidget;
 class FVTerm
 {
   public:
+    // Constants
+    //   Maximum number of separate change ranges per line
+    static constexpr std::size_t MAX_LINE_RANGES = 8;
+
     // Typedefs and Enumeration
     typedef struct
     {
-      uInt xmin;           // X-position with the first change
-      uInt xmax;           // X-position with the last change
-      uInt trans_count;    // Number of transparent characters
-    } FLineChanges;
+      uInt xmin;           // X-position of the first changed character
+      uInt xmax;           // X-position of the last changed character
+    } FChangeRange;
+
+    class FLineChanges;  // forward declaration
+
+    typedef struct
+    {
+      uInt move_length;    // Length of a cursor address sequence
+      uInt erase_length;   // Length of an erase characters sequence
+      uInt repeat_length;  // Length of a repeat character sequence
+      uInt insert_length;  // Length of an insert characters sequence
+      uInt delete_length;  // Length of a delete characters sequence
+    } FUpdateCosts;
+
+    typedef struct
+    {
+      uInt64 frame;               // Number of the frame
+      uInt   composited_areas;    // Areas copied into the virtual terminal
+      uInt64 compared_cells;      // Cells compared with the terminal
+      uInt64 emitted_cells;       // Cells written to the terminal
+      uInt   cursor_moves;        // Number of cursor movements
+      uInt64 cursor_move_bytes;   // Length of the cursor movements
+      uInt   attribute_changes;   // Number of attribute changes
+      uInt64 written_bytes;       // Bytes written to the terminal
+      uInt64 preprocessing_time;  // Time in the preprocessing handlers
+      uInt64 put_area_time;       // Time in putArea()
+      uInt64 update_line_time;    // Time in updateTerminalLine()
+      uInt64 flush_time;          // Time in flush()
+    } FFrameStatistics;           // (times in nanoseconds)
 
     typedef void (FVTerm::*FPreprocessingHandler)();
     typedef std::function<void()> FPreprocessingFunction;
@@ -122,6 +155,12 @@ class FVTerm
       start_refresh
     };
 
+    enum output_flush
+    {
+      flush_on_overflow,  // Write out when the buffer size is reached
+      flush_per_frame     // Grow the buffer and write out on flush() only
+    };
+
     // Constructor
     explicit FVTerm (bool, bool = false);
 
@@ -138,6 +177,11 @@ class FVTerm
     template <typename typeT>
     FVTerm& operator << (const typeT&);
     FVTerm& operator << (fc::SpecialCharacter);
+    FVTerm& operator << (char);
+    FVTerm& operator << (wchar_t);
+    FVTerm& operator << (const wchar_t*);
+    FVTerm& operator << (const char*);
+    FVTerm& operator << (const FString&);
     FVTerm& operator << (const std::string&);
     FVTerm& operator << (const FTermBuffer&);
     FVTerm& operator << (const std::vector<FChar>&);
@@ -161,6 +205,11 @@ class FVTerm
     static char*          getTermType();
     static char*          getTermFileName();
     FTerm&                getFTerm();
+    static std::size_t    getOutputBufferSize();
+    static output_flush   getFlushPolicy();
+    static uInt64         getFrameInterval();
+    static uInt64         getOutputThroughput();
+    static const FFrameStatistics& getFrameStatistics();
 
     // Mutators
     void                  setTermXY (int, int);
@@ -241,6 +290,12 @@ class FVTerm
     static bool           setVGAFont();
     static bool           setNewFont();
     static bool           setOldFont();
+    static void           setOutputBufferSize (std::size_t);
+    static void           setFlushPolicy (output_flush);
+    static void           setFrameInterval (uInt64);
+    static bool           setAsyncOutput (bool);
+    static bool           setAsyncOutput();
+    static bool           unsetAsyncOutput();
 
     // Inquiries
     static bool           isBold();
@@ -281,6 +336,7 @@ class FVTerm
     static bool           isTmuxTerm();
     static bool           isNewFont();
     static bool           isCursorHideable();
+    static bool           isAsyncOutput();
     static bool           hasChangedTermSize();
     static bool           hasUTF8();
 
@@ -291,6 +347,7 @@ class FVTerm
     void                  putVTerm();
     void                  updateTerminal (terminal_update);
     void                  updateTerminal();
+    static void           requestTerminalUpdate();
     virtual void          addPreprocessingHandler ( FVTerm*
                                                   , FPreprocessingFunction );
     virtual void          delPreprocessingHandler (FVTerm*);
@@ -310,7 +367,10 @@ class FVTerm
     virtual void          print (const FStyle&);
     virtual void          print (const FColorPair&);
     virtual FVTerm&       print();
+    void                  scrollArea (const FRect&, int);
+    void                  scrollArea (FTermArea*, const FRect&, int);
     static void           flush();
+    static void           completeOutput();
     static void           beep();
     static void           redefineDefaultColors (bool);
 
@@ -326,6 +386,7 @@ class FVTerm
     static bool           charEncodable (wchar_t);
     static FKeyboard*     getFKeyboard();
     static FMouseControl* getFMouseControl();
+    static uInt64         getFrameWaitTime();
 
     // Mutators
     void                  setPrintArea (FTermArea*);
@@ -362,17 +423,47 @@ class FVTerm
     void                  scrollAreaForward (FTermArea*);
     void                  scrollAreaReverse (FTermArea*);
     void                  clearArea (FTermArea*, int = ' ');
+    static void           addLineChanges (FLineChanges&, uInt, uInt);
+    static void           resetLineChanges (FLineChanges&, uInt);
     void                  processTerminalUpdate();
     static void           startTerminalUpdate();
     static void           finishTerminalUpdate();
     static void           initScreenSettings();
     static void           changeTermSizeFinished();
+    static void           invalidateWindowMap();
+    static bool           getWindowMapOwner (const FPoint&, FTermArea*&);
     static void           exitWithMessage (const FString&)
     #if defined(__clang__) || defined(__GNUC__)
       __attribute__((noreturn))
     #endif
                            ;
   private:
+    // Typedefs
+    struct FWindowState;  // forward declaration
+    typedef std::vector<FWindowState> FWindowStateList;
+
+    typedef struct
+    {
+      uInt64 terminal;  // Line hash of the terminal content (0 = unknown)
+      uInt64 vterm;     // Line hash of the virtual terminal content
+      int    old_line;  // Terminal line with the same content (or -1)
+    } FLineHash;
+
+    typedef struct
+    {
+      uInt64 hash;       // Line hash (0 = free table entry)
+      int    old_line;   // Terminal line with this hash
+      int    old_count;  // Number of terminal lines with this hash
+      int    new_count;  // Number of virtual terminal lines with this hash
+    } FLineHashCount;
+
+    typedef struct
+    {
+      int top;     // First terminal line of the region
+      int bottom;  // Last terminal line of the region
+      int count;   // Scrolled lines (> 0 = up, < 0 = down)
+    } FScrollRegion;
+
     // Enumerations
     enum character_type
     {
@@ -388,8 +479,8 @@ class FVTerm
     };
 
     // Constants
-    //   Buffer size for character output on the terminal
-    static constexpr uInt TERMINAL_OUTPUT_BUFFER_SIZE = 32768;
+    //   Default buffer size for character output on the terminal
+    static constexpr std::size_t DEFAULT_OUTPUT_BUFFER_SIZE = 32768;
 
     // Methods
     void                  setTextToDefault (FTermArea*, const FSize&);
@@ -399,6 +490,11 @@ class FVTerm
     static bool           reallocateTextArea ( FTermArea*
                                              , std::size_t );
     static covered_state  isCovered (const FPoint&, FTermArea*);
+    static void           updateWindowMap();
+    static void           updateWindowMapArea ( const FRect&
+                                              , const FWindowStateList& );
+    static bool           isNonCoveredLine (const FPoint&, int, FTermArea*);
+    static void           setVTermCharacter (FChar*, const FChar&);
     static void           updateOverlappedColor ( FTermArea*
                                                 , const FPoint&
                                                 , const FPoint& );
@@ -430,7 +526,10 @@ class FVTerm
     void                  init (bool);
     static void           init_characterLengths (FOptiMove*);
     void                  finish();
-    static void           putAreaLine (FChar*, FChar*, int);
+    static bool           putAreaLine ( const FChar*, FChar*, std::size_t
+                                      , FLineChanges&, uInt );
+    static void           putAreaRange ( FTermArea*, int
+                                       , const FChangeRange& );
     static void           putAreaCharacter ( const FPoint&, FVTerm*
                                            , FChar*, FChar* );
     static void           getAreaCharacter ( const FPoint&, FTermArea*
@@ -443,6 +542,7 @@ class FVTerm
     static bool           canClearTrailingWS (uInt&, uInt);
     bool                  skipUnchangedCharacters (uInt&, uInt, uInt);
     void                  printRange (uInt, uInt, uInt, bool);
+    void                  printChangedRanges (uInt, uInt, uInt, bool);
     void                  replaceNonPrintableFullwidth (uInt, FChar*&);
     void                  printCharacter (uInt&, uInt, bool, FChar*&);
     void                  printFullWidthCharacter (uInt&, uInt, FChar*&);
@@ -453,15 +553,37 @@ class FVTerm
     exit_state            repeatCharacter (uInt&, uInt, uInt);
     bool                  isFullWidthChar (const FChar* const&);
     bool                  isFullWidthPaddingChar (const FChar* const&);
+    void                  appendCursorMove (int, int);
     static void           cursorWrap();
     bool                  printWrap (FTermArea*);
     void                  printPaddingCharacter (FTermArea*, FChar&);
+    int                   printString (FTermArea*, const wchar_t*);
+    int                   printString (FTermArea*, const char*);
+    bool                  printNextCharacter (FTermArea*, const FChar&);
+    static FChar          getNextCharacter (wchar_t);
+    bool                  shiftTerminalLine (uInt&, uInt&, uInt);
     void                  updateTerminalLine (uInt);
+    uInt64                getLineHash (uInt);
+    static void           invalidateLineHashes();
+    void                  scrollTerminalLines();
+    int                   matchShiftedLines (const FScrollRegion&);
+    static void           countLineHashes();
+    static FLineHashCount& getLineHashCount (uInt64);
+    bool                  scrollTerminalRegion (int, int, int);
+    static void           moveTerminalLine (int, int);
+    void                  markScrolledLines (int, int, int);
     bool                  updateTerminalCursor();
     bool                  isInsideTerminal (const FPoint&);
     bool                  isTermSizeChanged();
+    static bool           isFrameDue();
+    static bool           isOutputPending();
+    static bool           isOutputBacklogged();
+    static uInt64         getOutputDrainTime();
+    static void           updateMoveCosts();
+    static void           finishFrameStatistics();
     static void           markAsPrinted (uInt, uInt);
     static void           markAsPrinted (uInt, uInt, uInt);
+    static void           markAsUnprinted (uInt, uInt, uInt);
     static void           newFontChanges (FChar*&);
     static void           charsetChanges (FChar*&);
     void                  appendCharacter (FChar*&);
@@ -472,6 +594,7 @@ class FVTerm
     static void           appendOutputBuffer (const std::string&);
     static void           appendOutputBuffer (const char[]);
     static int            appendOutputBuffer (int);
+    static void           appendOutputBufferUTF8 (int);
 
     // Data members
     FTermArea*              print_area{nullptr};        // print area for this object
@@ -482,7 +605,22 @@ class FVTerm
     static FTermArea*       vterm;        // virtual terminal
     static FTermArea*       vdesktop;     // virtual desktop
     static FTermArea*       active_area;  // active area
-    static std::queue<int>* output_buffer;
+    static std::string*     output_buffer;
+    static FOutputWriter*   output_writer;   // asynchronous output
+    static FOutputMonitor*  output_monitor;  // output queue measurement
+    static std::vector<FTermArea*>* window_map;  // topmost window per cell
+    static FWindowStateList* window_map_state;
+    static std::vector<FLineHash>* line_hash;
+    static std::vector<FLineHashCount>* line_hash_count;  // hash table
+    static std::vector<FChar>* terminal_data;  // copy of the terminal content
+    static FScrollRegion    scroll_hint;  // region scrolled by scrollArea()
+    static std::size_t      output_buffer_size;
+    static uInt64           frame_interval;   // min. time between two frames
+    static uInt64           move_throughput;  // throughput of the move costs
+    static timeval          last_frame_time;  // time of the last frame
+    static FFrameStatistics frame_statistics;       // current frame
+    static FFrameStatistics last_frame_statistics;  // last written frame
+    static output_flush     flush_policy;
     static FChar            term_attribute;
     static FChar            next_attribute;
     static FChar            s_ch;      // shadow character
@@ -493,15 +631,47 @@ class FVTerm
     static bool             terminal_update_pending;
     static bool             force_terminal_update;
     static bool             stop_terminal_updates;
+    static bool             window_map_changed;
     static int              skipped_terminal_update;
     static uInt             erase_char_length;
     static uInt             repeat_char_length;
     static uInt             clr_bol_length;
     static uInt             clr_eol_length;
+    static uInt             insert_char_length;
+    static uInt             delete_char_length;
     static uInt             cursor_address_length;
 };
 
 
+//----------------------------------------------------------------------
+// class FVTerm::FLineChanges
+//----------------------------------------------------------------------
+
+class FVTerm::FLineChanges  // changed characters of an area line
+{
+  public:
+    // Accessors
+    uInt                getXmin() const;
+    uInt                getXmax() const;
+    uInt                getRangeCount() const;
+    const FChangeRange& getRange (uInt) const;
+
+    // Data member
+    uInt trans_count;    // Number of transparent characters
+
+  private:
+    // The changes can only be modified with
+    // addLineChanges() and resetLineChanges()
+    uInt xmin;           // X-position with the first change
+    uInt xmax;           // X-position with the last change
+    uInt range_count;    // Number of separate change ranges
+    FChangeRange range[MAX_LINE_RANGES];  // Sorted change ranges
+
+    // Friend class
+    friend class FVTerm;
+};
+
+
 //----------------------------------------------------------------------
 // struct FVTerm::FTermArea
 //----------------------------------------------------------------------
@@ -529,6 +699,7 @@ struct FVTerm::FTermArea  // define virtual terminal character properties
     int cursor_y{0};           // Y-position for the next write operation
     int input_cursor_x{-1};    // X-position input cursor
     int input_cursor_y{-1};    // Y-position input cursor
+    int layer{-1};             // Position in the window stacking order
     FWidget* widget{nullptr};  // Widget that owns this FTermArea
     FPreprocessing preproc_list{};
     FLineChanges* changes{nullptr};
@@ -539,6 +710,17 @@ struct FVTerm::FTermArea  // define virtual terminal character properties
 };
 
 
+// non-member function forward declarations
+// implemented in fvterm_functions.cpp
+//----------------------------------------------------------------------
+std::size_t getChangedCharacterPos (const FChar*, const FChar*, std::size_t);
+std::size_t getUnchangedCharacterPos (const FChar*, const FChar*, std::size_t);
+const char* getCharacterCompareKernel();
+bool        setCharacterCompareKernel (const char[]);
+int         getCharacterShift ( const FChar*, const FChar*, std::size_t
+                              , const FVTerm::FUpdateCosts& );
+
+
 // FVTerm inline functions
 //----------------------------------------------------------------------
 template <typename typeT>
@@ -560,6 +742,20 @@ inline FVTerm& FVTerm::operator << (fc::SpecialCharacter c)
   return *this;
 }
 
+//----------------------------------------------------------------------
+inline FVTerm& FVTerm::operator << (char c)
+{
+  const char string[2] = { c, '\0' };
+  return *this << string;
+}
+
+//----------------------------------------------------------------------
+inline FVTerm& FVTerm::operator << (const FString& string)
+{
+  print (string);
+  return *this;
+}
+
 //----------------------------------------------------------------------
 inline FVTerm& FVTerm::operator << (const std::string& string)
 {
@@ -652,6 +848,22 @@ inline char* FVTerm::getTermFileName()
 inline FTerm& FVTerm::getFTerm()
 { return *fterm; }
 
+//----------------------------------------------------------------------
+inline std::size_t FVTerm::getOutputBufferSize()
+{ return output_buffer_size; }
+
+//----------------------------------------------------------------------
+inline FVTerm::output_flush FVTerm::getFlushPolicy()
+{ return flush_policy; }
+
+//----------------------------------------------------------------------
+inline uInt64 FVTerm::getFrameInterval()
+{ return frame_interval; }
+
+//----------------------------------------------------------------------
+inline const FVTerm::FFrameStatistics& FVTerm::getFrameStatistics()
+{ return last_frame_statistics; }
+
 //----------------------------------------------------------------------
 inline void FVTerm::hideCursor()
 { return hideCursor(true); }
@@ -891,6 +1103,22 @@ inline bool FVTerm::setNewFont()
 inline bool FVTerm::setOldFont()
 { return FTerm::setOldFont(); }
 
+//----------------------------------------------------------------------
+inline void FVTerm::setFlushPolicy (output_flush policy)
+{ flush_policy = policy; }
+
+//----------------------------------------------------------------------
+inline void FVTerm::setFrameInterval (uInt64 interval)
+{ frame_interval = interval; }
+
+//----------------------------------------------------------------------
+inline bool FVTerm::setAsyncOutput()
+{ return setAsyncOutput(true); }
+
+//----------------------------------------------------------------------
+inline bool FVTerm::unsetAsyncOutput()
+{ return setAsyncOutput(false); }
+
 //----------------------------------------------------------------------
 inline bool FVTerm::isBold()
 { return next_attribute.attr.bit.bold; }
@@ -1043,6 +1271,10 @@ inline bool FVTerm::isNewFont()
 inline bool FVTerm::isCursorHideable()
 { return FTerm::isCursorHideable(); }
 
+//----------------------------------------------------------------------
+inline bool FVTerm::isAsyncOutput()
+{ return bool(output_writer); }
+
 //----------------------------------------------------------------------
 inline bool FVTerm::hasChangedTermSize()
 { return FTerm::hasChangedTermSize(); }
@@ -1160,10 +1392,32 @@ inline void FVTerm::initScreenSettings()
 inline void FVTerm::changeTermSizeFinished()
 { FTerm::changeTermSizeFinished(); }
 
+//----------------------------------------------------------------------
+inline void FVTerm::invalidateWindowMap()
+{ window_map_changed = true; }
+
 //----------------------------------------------------------------------
 inline void FVTerm::exitWithMessage (const FString& message)
 { FTerm::exitWithMessage(message); }
 
+
+// FVTerm::FLineChanges inline functions
+//----------------------------------------------------------------------
+inline uInt FVTerm::FLineChanges::getXmin() const
+{ return xmin; }
+
+//----------------------------------------------------------------------
+inline uInt FVTerm::FLineChanges::getXmax() const
+{ return xmax; }
+
+//----------------------------------------------------------------------
+inline uInt FVTerm::FLineChanges::getRangeCount() const
+{ return range_count; }
+
+//----------------------------------------------------------------------
+inline const FVTerm::FChangeRange& FVTerm::FLineChanges::getRange (uInt index) const
+{ return range[index]; }
+
 }  // namespace finalcut
 
 #endif  // FVTERM_H
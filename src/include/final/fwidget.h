@@ -531,6 +531,7 @@ bool        isFocusPrevKey (const FKey);
 FKey        getHotkey (const FString&);
 std::size_t getHotkeyPos (const FString& src, FString& dest);
 void        setHotkeyViaString (FWidget*, const FString&);
+void        printRepeated (FWidget*, wchar_t, std::size_t);
 void        drawShadow (FWidget*);
 void        drawTransparentShadow (FWidget*);
 void        drawBlockShadow (FWidget*);
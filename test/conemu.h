@@ -120,6 +120,7 @@ class ConEmu
     char*       getDA (console);
     char*       getDA1 (console);
     char*       getSEC_DA (console);
+    char*       getSyncOutputMode (console);
 
     // Methods
     bool        openMasterPTY();
@@ -795,6 +796,36 @@ inline char* ConEmu::getSEC_DA (console con)
   return SEC_DA[con];
 }
 
+//----------------------------------------------------------------------
+inline char* ConEmu::getSyncOutputMode (console con)
+{
+  static char* SyncOutputMode[] =
+  {
+    0,                            // Ansi,
+    C_STR("\033[?2026;0$y"),      // XTerm
+    0,                            // Rxvt
+    0,                            // Urxvt
+    0,                            // mlterm - Multi Lingual TERMinal
+    0,                            // PuTTY
+    0,                            // KDE Konsole
+    0,                            // GNOME Terminal
+    0,                            // VTE Terminal >= 0.53.0
+    0,                            // kterm,
+    0,                            // Tera Term
+    0,                            // Cygwin
+    C_STR("\033[?2026;2$y"),      // Mintty
+    0,                            // Linux console
+    0,                            // FreeBSD console
+    0,                            // NetBSD console
+    0,                            // OpenBSD console
+    0,                            // Sun console
+    0,                            // screen
+    0                             // tmux
+  };
+
+  return SyncOutputMode[con];
+}
+
 //----------------------------------------------------------------------
 inline bool ConEmu::openMasterPTY()
 {
@@ -943,6 +974,16 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
 
       i += 4;
     }
+    else if ( i < length - 8  // Request synchronized output mode (DECRQM)
+           && std::strncmp(&buffer[i], "\033[?2026$p", 9) == 0 )
+    {
+      char* mode = getSyncOutputMode(con);
+
+      if ( mode )
+        write (fd_master, mode, std::strlen(mode));
+
+      i += 8;  // The device attributes follow directly
+    }
     else if ( i < length - 4  // Report xterm window's title
            && buffer[i] == '\033'
            && buffer[i + 1] == '['
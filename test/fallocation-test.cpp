@@ -0,0 +1,175 @@
+/***********************************************************************
+* fallocation-test.cpp - Heap allocations of the rendering path        *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <utility>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+#include "allocation-counter.inc"
+#include "headless-application.inc"
+
+
+//----------------------------------------------------------------------
+// class FAllocationTest
+//----------------------------------------------------------------------
+
+class FAllocationTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FAllocationTest()
+    { }
+
+  protected:
+    void counterTest();
+    void stringMoveTest();
+    void termBufferTest();
+    void redrawTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FAllocationTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (counterTest);
+    CPPUNIT_TEST (stringMoveTest);
+    CPPUNIT_TEST (termBufferTest);
+    CPPUNIT_TEST (redrawTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FAllocationTest::counterTest()
+{
+  const auto count = test::getAllocationCount();
+  auto p = new int(42);
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count + 1 );
+  delete p;
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count + 1 );
+}
+
+//----------------------------------------------------------------------
+void FAllocationTest::stringMoveTest()
+{
+  finalcut::FString s1{"Steady state"};
+  const auto count = test::getAllocationCount();
+  finalcut::FString s2{std::move(s1)};
+  finalcut::FString s3{};
+  s3 = std::move(s2);
+
+  // Appending characters uses the reserved buffer space
+  s3 += L'!';
+  s3 += L'?';
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count );
+  CPPUNIT_ASSERT ( s1.isNull() );
+  CPPUNIT_ASSERT ( s2.isNull() );
+  CPPUNIT_ASSERT ( s3 == "Steady state!?" );
+}
+
+//----------------------------------------------------------------------
+void FAllocationTest::termBufferTest()
+{
+  const finalcut::FString text{"Column"};
+  finalcut::FTermBuffer buffer{};
+  buffer << L' ' << text << finalcut::fc::BlackUpPointingTriangle << ' ';
+  CPPUNIT_ASSERT ( buffer.getLength() == 9 );
+
+  // clear() keeps the capacity for the next line
+  const auto count = test::getAllocationCount();
+  buffer.clear();
+  buffer << L' ' << text << finalcut::fc::BlackUpPointingTriangle << ' ';
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count );
+  CPPUNIT_ASSERT ( buffer.getLength() == 9 );
+  CPPUNIT_ASSERT ( buffer.toString() == L" Column▲ " );
+}
+
+//----------------------------------------------------------------------
+void FAllocationTest::redrawTest()
+{
+  auto terminal = new finalcut::FSystemHeadless(80, 24);
+  test::FHeadlessApplication app(terminal);
+  finalcut::FVTerm::setFrameInterval(0);
+
+  finalcut::FDialog dialog{&app};
+  dialog.setText ("Allocations");
+  dialog.setGeometry (finalcut::FPoint{2, 2}, finalcut::FSize{60, 20});
+  finalcut::FLabel label{"&Name:", &dialog};
+  label.setGeometry (finalcut::FPoint{2, 1}, finalcut::FSize{6, 1});
+  finalcut::FLineEdit input{"Final Cut", &dialog};
+  input.setGeometry (finalcut::FPoint{9, 1}, finalcut::FSize{20, 1});
+  finalcut::FCheckBox checkbox{"&Active", &dialog};
+  checkbox.setGeometry (finalcut::FPoint{31, 1}, finalcut::FSize{12, 1});
+  finalcut::FButton button{"&OK", &dialog};
+  button.setGeometry (finalcut::FPoint{45, 1}, finalcut::FSize{10, 1});
+  finalcut::FListView listview{&dialog};
+  listview.setGeometry (finalcut::FPoint{2, 3}, finalcut::FSize{55, 14});
+  listview.addColumn ("Name");
+  listview.addColumn ("Value", 10);
+
+  for (int i{0}; i < 30; i++)
+  {
+    const finalcut::FStringList line{ finalcut::FString("Item ") << i
+                                    , finalcut::FString() << i * i };
+    listview.insert (line);
+  }
+
+  dialog.show();
+  app.updateTerminal();
+
+  // Warm-up frames fill all reusable buffers
+  for (int i{0}; i < 2; i++)
+  {
+    dialog.redraw();
+    app.updateTerminal();
+  }
+
+  // Redrawing the unchanged dialog performs no heap allocations
+  // (the cleared output string keeps its capacity)
+  terminal->clearOutput();
+  const auto count = test::getAllocationCount();
+
+  for (int i{0}; i < 5; i++)
+  {
+    dialog.redraw();
+    app.updateTerminal();
+  }
+
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count );
+  CPPUNIT_ASSERT ( terminal->getLine(1).includes("Allocations") );
+  CPPUNIT_ASSERT ( terminal->getLine(3).includes("Name:") );
+  CPPUNIT_ASSERT ( terminal->getLine(6).includes("Item 0") );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FAllocationTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,248 @@
+/***********************************************************************
+* fcharstyletable-test.cpp - FCharStyleTable unit tests                *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FCharStyleTableTest
+//----------------------------------------------------------------------
+
+class FCharStyleTableTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FCharStyleTableTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void sizeTest();
+    void noArgumentTest();
+    void packTest();
+    void internTest();
+    void fullTableTest();
+    void compareTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FCharStyleTableTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (sizeTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (packTest);
+    CPPUNIT_TEST (internTest);
+    CPPUNIT_TEST (fullTableTest);
+    CPPUNIT_TEST (compareTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::classNameTest()
+{
+  const finalcut::FCharStyleTable table;
+  const finalcut::FString& classname = table.getClassName();
+  CPPUNIT_ASSERT ( classname == "FCharStyleTable" );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::sizeTest()
+{
+  CPPUNIT_ASSERT ( sizeof(finalcut::FCharCell) == 8 );
+  CPPUNIT_ASSERT ( sizeof(finalcut::FCharCell) * 2 == sizeof(finalcut::FChar) );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::noArgumentTest()
+{
+  const finalcut::FCharStyleTable table;
+  CPPUNIT_ASSERT ( table.getSize() == 0 );
+  CPPUNIT_ASSERT ( ! table.isFull() );
+
+  // Unknown style index
+  finalcut::FCharCell cell{};
+  cell.ch = 'A';
+  cell.style = 10;
+  const finalcut::FChar fchar = table.unpack(cell);
+  CPPUNIT_ASSERT ( fchar.ch == L'A' );
+  CPPUNIT_ASSERT ( fchar.fg_color == 0 );
+  CPPUNIT_ASSERT ( fchar.bg_color == 0 );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::packTest()
+{
+  finalcut::FCharStyleTable table;
+  finalcut::FChar fchar{};
+  fchar.ch = L'€';
+  fchar.encoded_char = L'E';
+  fchar.fg_color = finalcut::fc::Yellow;
+  fchar.bg_color = finalcut::fc::Default;
+  fchar.attr.bit.bold = true;
+  fchar.attr.bit.reverse = true;
+  fchar.attr.bit.crossed_out = true;
+  fchar.attr.bit.inherit_background = true;
+  fchar.attr.bit.printed = true;
+  fchar.attr.bit.char_width = 1;
+
+  finalcut::FCharCell cell{};
+  CPPUNIT_ASSERT ( table.pack(fchar, cell) );
+  CPPUNIT_ASSERT ( table.getSize() == 1 );
+  CPPUNIT_ASSERT ( cell.ch == uInt32(L'€') );
+  CPPUNIT_ASSERT ( cell.style == 0 );
+
+  const finalcut::FChar unpacked = table.unpack(cell);
+  CPPUNIT_ASSERT ( unpacked == fchar );
+  CPPUNIT_ASSERT ( unpacked.encoded_char == L'€' );
+  CPPUNIT_ASSERT ( unpacked.fg_color == finalcut::fc::Yellow );
+  CPPUNIT_ASSERT ( unpacked.bg_color == finalcut::fc::Default );
+  CPPUNIT_ASSERT ( unpacked.attr.byte[0] == fchar.attr.byte[0] );
+  CPPUNIT_ASSERT ( unpacked.attr.byte[1] == fchar.attr.byte[1] );
+  CPPUNIT_ASSERT ( unpacked.attr.byte[2] == fchar.attr.byte[2] );
+  CPPUNIT_ASSERT ( unpacked.attr.bit.printed );
+  CPPUNIT_ASSERT ( unpacked.attr.bit.char_width == 1 );
+
+  table.clear();
+  CPPUNIT_ASSERT ( table.getSize() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::internTest()
+{
+  finalcut::FCharStyleTable table;
+  finalcut::FChar fchar{};
+  fchar.fg_color = finalcut::fc::Black;
+  fchar.bg_color = finalcut::fc::White;
+  finalcut::FCharCell c1{}, c2{}, c3{}, c4{};
+
+  // Same style with different characters and update states
+  fchar.ch = L'a';
+  CPPUNIT_ASSERT ( table.pack(fchar, c1) );
+  fchar.ch = L'b';
+  fchar.attr.bit.no_changes = true;
+  CPPUNIT_ASSERT ( table.pack(fchar, c2) );
+  CPPUNIT_ASSERT ( table.getSize() == 1 );
+  CPPUNIT_ASSERT ( c1.style == c2.style );
+  CPPUNIT_ASSERT ( c1.state != c2.state );
+
+  // Full-width padding characters have their own style
+  fchar.attr.bit.fullwidth_padding = true;
+  CPPUNIT_ASSERT ( table.pack(fchar, c3) );
+  CPPUNIT_ASSERT ( table.getSize() == 2 );
+  CPPUNIT_ASSERT ( c3.style != c2.style );
+
+  fchar.attr.bit.fullwidth_padding = false;
+  fchar.attr.bit.underline = true;
+  CPPUNIT_ASSERT ( table.pack(fchar, c4) );
+  CPPUNIT_ASSERT ( table.getSize() == 3 );
+  CPPUNIT_ASSERT ( c4.style == 2 );
+  CPPUNIT_ASSERT ( table.unpack(c4).attr.bit.underline );
+  CPPUNIT_ASSERT ( ! table.unpack(c2).attr.bit.underline );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::fullTableTest()
+{
+  finalcut::FCharStyleTable table;
+  finalcut::FChar fchar{};
+  finalcut::FCharCell cell{};
+  fchar.ch = L'x';
+
+  for (std::size_t n{0}; n < finalcut::FCharStyleTable::MAX_STYLES; n++)
+  {
+    fchar.fg_color = FColor(n & 0xff);
+    fchar.bg_color = FColor(n >> 8);
+    CPPUNIT_ASSERT ( table.pack(fchar, cell) );
+    CPPUNIT_ASSERT ( cell.style == n );
+  }
+
+  CPPUNIT_ASSERT ( table.isFull() );
+
+  // A new style does not fit into the table anymore
+  fchar.attr.bit.bold = true;
+  cell.style = 0;
+  CPPUNIT_ASSERT ( ! table.pack(fchar, cell) );
+  CPPUNIT_ASSERT ( cell.style == 0 );
+
+  // Existing styles can still be used
+  fchar.attr.bit.bold = false;
+  fchar.fg_color = 3;
+  fchar.bg_color = 1;
+  CPPUNIT_ASSERT ( table.pack(fchar, cell) );
+  CPPUNIT_ASSERT ( cell.style == 259 );
+}
+
+//----------------------------------------------------------------------
+void FCharStyleTableTest::compareTest()
+{
+  finalcut::FCharStyleTable table;
+  finalcut::FChar fchar{};
+  fchar.ch = L' ';
+  fchar.fg_color = finalcut::fc::LightGray;
+  fchar.bg_color = finalcut::fc::Blue;
+  std::vector<finalcut::FCharCell> line1(40);
+  std::vector<finalcut::FCharCell> line2(40);
+
+  for (auto&& cell : line1)
+    CPPUNIT_ASSERT ( table.pack(fchar, cell) );
+
+  // The update state has no influence on the comparison
+  fchar.attr.bit.printed = true;
+
+  for (auto&& cell : line2)
+    CPPUNIT_ASSERT ( table.pack(fchar, cell) );
+
+  CPPUNIT_ASSERT ( finalcut::FCharStyleTable::isEqual(line1[0], line2[0]) );
+  CPPUNIT_ASSERT ( finalcut::FCharStyleTable::getChangedCellPos \
+                       (line1.data(), line2.data(), 40) == 40 );
+
+  fchar.ch = L'#';
+  CPPUNIT_ASSERT ( table.pack(fchar, line2[31]) );
+  fchar.ch = L' ';
+  fchar.attr.bit.dim = true;
+  CPPUNIT_ASSERT ( table.pack(fchar, line2[17]) );
+  CPPUNIT_ASSERT ( ! finalcut::FCharStyleTable::isEqual(line1[17], line2[17]) );
+  CPPUNIT_ASSERT ( finalcut::FCharStyleTable::getChangedCellPos \
+                       (line1.data(), line2.data(), 40) == 17 );
+  CPPUNIT_ASSERT ( finalcut::FCharStyleTable::getChangedCellPos \
+                       (&line1[18], &line2[18], 22) == 13 );
+  CPPUNIT_ASSERT ( finalcut::FCharStyleTable::getChangedCellPos \
+                       (line1.data(), line2.data(), 0) == 0 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FCharStyleTableTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,389 @@
+/***********************************************************************
+* feventqueue-test.cpp - FEventQueue unit tests                        *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+#include "allocation-counter.inc"
+#include "headless-application.inc"
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+// class FObject_userEvent
+//----------------------------------------------------------------------
+
+class FObject_userEvent : public finalcut::FObject
+{
+  public:
+    explicit FObject_userEvent (finalcut::FObject* parent = nullptr)
+      : finalcut::FObject{parent}
+    { }
+
+    // Data members
+    std::vector<int> ids{};
+    std::vector<FDataPtr> data{};
+
+  protected:
+    void onUserEvent (finalcut::FUserEvent* ev) override
+    {
+      ids.push_back(ev->getUserId());
+      data.push_back(ev->getData());
+    }
+};
+
+//----------------------------------------------------------------------
+int getUserId (const finalcut::FEventQueue::FEventItem& item)
+{
+  return static_cast<finalcut::FUserEvent*>(item.event)->getUserId();
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FEventQueueTest
+//----------------------------------------------------------------------
+
+class FEventQueueTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FEventQueueTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void copyTest();
+    void orderTest();
+    void removeReceiverTest();
+    void allocationTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FEventQueueTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (copyTest);
+    CPPUNIT_TEST (orderTest);
+    CPPUNIT_TEST (removeReceiverTest);
+    CPPUNIT_TEST (allocationTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FEventQueueTest::classNameTest()
+{
+  const finalcut::FEventQueue q;
+  const finalcut::FString& classname = q.getClassName();
+  CPPUNIT_ASSERT ( classname == "FEventQueue" );
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::noArgumentTest()
+{
+  finalcut::FEventQueue q;
+  finalcut::FObject receiver;
+  finalcut::FEventQueue::FEventItem item{};
+  const finalcut::FEvent ev(finalcut::fc::Show_Event);
+  CPPUNIT_ASSERT ( q.isEmpty() );
+  CPPUNIT_ASSERT ( q.getSlotCount() == 0 );
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == nullptr );
+  CPPUNIT_ASSERT ( item.event == nullptr );
+  CPPUNIT_ASSERT ( item.slot == finalcut::FEventQueue::NO_SLOT );
+  CPPUNIT_ASSERT ( ! q.push(nullptr, &ev) );
+  CPPUNIT_ASSERT ( ! q.push(&receiver, nullptr) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(nullptr) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(&receiver) );
+  CPPUNIT_ASSERT ( q.isEmpty() );
+
+  // The destructor destroys the queued and the popped events
+  CPPUNIT_ASSERT ( q.push(&receiver, &ev) );
+  CPPUNIT_ASSERT ( q.push(&receiver, &ev) );
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( ! q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::copyTest()
+{
+  finalcut::FEventQueue q;
+  finalcut::FObject receiver;
+  finalcut::FEventQueue::FEventItem item{};
+  int value{42};
+
+  // The events are copied with their concrete type
+  {
+    finalcut::FUserEvent user_ev(finalcut::fc::User_Event, 7);
+    user_ev.setData(&value);
+    const finalcut::FKeyEvent key_ev(finalcut::fc::KeyPress_Event, finalcut::fc::Fkey_f1);
+    const finalcut::FPoint pos(3, 4);
+    const finalcut::FPoint termpos(13, 14);
+    const finalcut::FMouseEvent mouse_ev ( finalcut::fc::MouseUp_Event
+                                         , pos, termpos
+                                         , finalcut::fc::RightButton );
+    finalcut::FAccelEvent accel_ev(finalcut::fc::Accelerator_Event, &value);
+    accel_ev.accept();
+    const finalcut::FTimerEvent timer_ev(finalcut::fc::Timer_Event, 5);
+    const finalcut::FEvent plain_ev(finalcut::fc::KeyPress_Event);
+    q.push (&receiver, &user_ev);
+    q.push (&receiver, &key_ev);
+    q.push (&receiver, &mouse_ev);
+    q.push (&receiver, &accel_ev);
+    q.push (&receiver, &timer_ev);
+    q.push (&receiver, &plain_ev);
+  }
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == &receiver );
+  const auto user_ev = dynamic_cast<finalcut::FUserEvent*>(item.event);
+  CPPUNIT_ASSERT ( user_ev != nullptr );
+  CPPUNIT_ASSERT ( user_ev->getUserId() == 7 );
+  CPPUNIT_ASSERT ( user_ev->getData() == &value );
+  q.release(item);
+  CPPUNIT_ASSERT ( item.event == nullptr );
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  const auto key_ev = dynamic_cast<finalcut::FKeyEvent*>(item.event);
+  CPPUNIT_ASSERT ( key_ev != nullptr );
+  CPPUNIT_ASSERT ( key_ev->type() == finalcut::fc::KeyPress_Event );
+  CPPUNIT_ASSERT ( key_ev->key() == finalcut::fc::Fkey_f1 );
+  q.release(item);
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  const auto mouse_ev = dynamic_cast<finalcut::FMouseEvent*>(item.event);
+  CPPUNIT_ASSERT ( mouse_ev != nullptr );
+  CPPUNIT_ASSERT ( mouse_ev->getX() == 3 );
+  CPPUNIT_ASSERT ( mouse_ev->getY() == 4 );
+  CPPUNIT_ASSERT ( mouse_ev->getTermX() == 13 );
+  CPPUNIT_ASSERT ( mouse_ev->getTermY() == 14 );
+  CPPUNIT_ASSERT ( mouse_ev->getButton() == finalcut::fc::RightButton );
+  q.release(item);
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  const auto accel_ev = dynamic_cast<finalcut::FAccelEvent*>(item.event);
+  CPPUNIT_ASSERT ( accel_ev != nullptr );
+  CPPUNIT_ASSERT ( accel_ev->focusedWidget() == &value );
+  CPPUNIT_ASSERT ( accel_ev->isAccepted() );
+  q.release(item);
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  const auto timer_ev = dynamic_cast<finalcut::FTimerEvent*>(item.event);
+  CPPUNIT_ASSERT ( timer_ev != nullptr );
+  CPPUNIT_ASSERT ( timer_ev->getTimerId() == 5 );
+  q.release(item);
+
+  // A base class event is not copied as a subclass
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.event->type() == finalcut::fc::KeyPress_Event );
+  CPPUNIT_ASSERT ( dynamic_cast<finalcut::FKeyEvent*>(item.event) == nullptr );
+  q.release(item);
+
+  CPPUNIT_ASSERT ( q.isEmpty() );
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::orderTest()
+{
+  finalcut::FEventQueue q;
+  finalcut::FObject receiver;
+  finalcut::FEventQueue::FEventItem item1{};
+  finalcut::FEventQueue::FEventItem item2{};
+
+  for (int i{1}; i <= 3; i++)
+  {
+    const finalcut::FUserEvent ev(finalcut::fc::User_Event, i);
+    q.push (&receiver, &ev);
+  }
+
+  CPPUNIT_ASSERT ( q.pop(item1) );
+  CPPUNIT_ASSERT ( test::getUserId(item1) == 1 );
+
+  // A popped event stays valid while other events are handled
+  const finalcut::FUserEvent ev(finalcut::fc::User_Event, 4);
+  q.push (&receiver, &ev);
+  CPPUNIT_ASSERT ( q.pop(item2) );
+  CPPUNIT_ASSERT ( test::getUserId(item2) == 2 );
+  q.release(item2);
+  CPPUNIT_ASSERT ( q.pop(item2) );
+  CPPUNIT_ASSERT ( test::getUserId(item2) == 3 );
+  q.release(item2);
+  CPPUNIT_ASSERT ( test::getUserId(item1) == 1 );
+  q.release(item1);
+
+  CPPUNIT_ASSERT ( q.pop(item1) );
+  CPPUNIT_ASSERT ( test::getUserId(item1) == 4 );
+  q.release(item1);
+  CPPUNIT_ASSERT ( q.isEmpty() );
+
+  // More events than fit into one block of slots
+  for (int i{0}; i < 200; i++)
+  {
+    const finalcut::FUserEvent user_ev(finalcut::fc::User_Event, i);
+    q.push (&receiver, &user_ev);
+  }
+
+  CPPUNIT_ASSERT ( q.getSlotCount() >= 200 );
+
+  for (int i{0}; i < 200; i++)
+  {
+    CPPUNIT_ASSERT ( q.pop(item1) );
+    CPPUNIT_ASSERT ( test::getUserId(item1) == i );
+    q.release(item1);
+  }
+
+  CPPUNIT_ASSERT ( q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::removeReceiverTest()
+{
+  finalcut::FEventQueue q;
+  finalcut::FObject receiver1;
+  finalcut::FObject receiver2;
+  finalcut::FEventQueue::FEventItem item{};
+
+  for (int i{1}; i <= 6; i++)
+  {
+    const finalcut::FUserEvent ev(finalcut::fc::User_Event, i);
+    q.push ( ( i % 2 == 1 ) ? &receiver1 : &receiver2, &ev );
+  }
+
+  CPPUNIT_ASSERT ( q.removeReceiver(&receiver1) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(&receiver1) );
+
+  // Events queued after the removal are delivered
+  const finalcut::FUserEvent ev(finalcut::fc::User_Event, 7);
+  q.push (&receiver1, &ev);
+
+  for (int i : {2, 4, 6})
+  {
+    CPPUNIT_ASSERT ( q.pop(item) );
+    CPPUNIT_ASSERT ( item.receiver == &receiver2 );
+    CPPUNIT_ASSERT ( test::getUserId(item) == i );
+    q.release(item);
+  }
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == &receiver1 );
+  CPPUNIT_ASSERT ( test::getUserId(item) == 7 );
+  q.release(item);
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+  CPPUNIT_ASSERT ( q.isEmpty() );
+
+  // A delivered event no longer counts for the receiver
+  q.push (&receiver2, &ev);
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(&receiver2) );
+  q.release(item);
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::allocationTest()
+{
+  finalcut::FEventQueue q;
+  finalcut::FObject receiver1;
+  finalcut::FObject receiver2;
+  finalcut::FEventQueue::FEventItem item{};
+  const finalcut::FUserEvent user_ev(finalcut::fc::User_Event, 1);
+  const finalcut::FKeyEvent key_ev(finalcut::fc::KeyPress_Event, finalcut::fc::Fkey_escape);
+
+  // The first events allocate the slots and the tombstones
+  q.push (&receiver1, &user_ev);
+  q.push (&receiver2, &key_ev);
+  q.removeReceiver(&receiver1);
+  q.clear();
+
+  // Queuing and removing does not allocate in the steady state
+  const auto count = test::getAllocationCount();
+  const auto slots = q.getSlotCount();
+
+  for (int i{0}; i < 1000; i++)
+  {
+    q.push (&receiver1, &user_ev);
+    q.push (&receiver2, &key_ev);
+    q.push (&receiver1, &key_ev);
+
+    if ( i % 10 == 0 )
+      q.removeReceiver(&receiver1);
+
+    while ( q.pop(item) )
+      q.release(item);
+  }
+
+  CPPUNIT_ASSERT ( test::getAllocationCount() == count );
+  CPPUNIT_ASSERT ( q.getSlotCount() == slots );
+}
+
+//----------------------------------------------------------------------
+void FEventQueueTest::applicationTest()
+{
+  test::FHeadlessApplication app;
+  auto receiver = new test::FObject_userEvent(&app);
+  auto removed = new test::FObject_userEvent(&app);
+  int value{3};
+
+  finalcut::FUserEvent ev1(finalcut::fc::User_Event, 1);
+  ev1.setData(&value);
+  finalcut::FApplication::queueEvent (receiver, &ev1);
+  finalcut::FApplication::queueEvent (removed, &ev1);
+  finalcut::FApplication::queueEvent (receiver, nullptr);
+  finalcut::FUserEvent ev2(finalcut::fc::User_Event, 2);
+  finalcut::FApplication::queueEvent (receiver, &ev2);
+  CPPUNIT_ASSERT ( finalcut::FApplication::eventInQueue() );
+  CPPUNIT_ASSERT ( finalcut::FApplication::removeQueuedEvent(removed) );
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::removeQueuedEvent(removed) );
+
+  // The user events arrive with their id and data
+  finalcut::FApplication::sendQueuedEvents();
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::eventInQueue() );
+  CPPUNIT_ASSERT ( receiver->ids.size() == 2 );
+  CPPUNIT_ASSERT ( receiver->ids[0] == 1 );
+  CPPUNIT_ASSERT ( receiver->ids[1] == 2 );
+  CPPUNIT_ASSERT ( receiver->data[0] == &value );
+  CPPUNIT_ASSERT ( receiver->data[1] == nullptr );
+  CPPUNIT_ASSERT ( removed->ids.empty() );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FEventQueueTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -202,14 +202,14 @@ void FMouseTest::doubleClickTest()
   timeval tv = { 0, 0 };
   CPPUNIT_ASSERT ( mouse.isDblclickTimeout(&tv) );
 
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   CPPUNIT_ASSERT ( ! mouse.isDblclickTimeout(&tv) );
 
   tv.tv_sec--;  // Minus one second
   CPPUNIT_ASSERT ( mouse.isDblclickTimeout(&tv) );
 
   mouse.setDblclickInterval(1000000);
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   CPPUNIT_ASSERT ( ! mouse.isDblclickTimeout(&tv) );
 
   timeval tv_delta = { 0, 500000 };
@@ -267,7 +267,7 @@ void FMouseTest::x11MouseTest()
   CPPUNIT_ASSERT ( std::strcmp(rawdata1, "@@") == 0 );
 
   timeval tv;
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
 
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(48, 18) );
@@ -349,7 +349,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( ! x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -377,7 +377,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -410,7 +410,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -443,7 +443,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(80, 25) );
@@ -476,7 +476,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -515,7 +515,7 @@ void FMouseTest::x11MouseTest()
 
   CPPUNIT_ASSERT ( x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   x11_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! x11_mouse.hasData() );
   CPPUNIT_ASSERT ( x11_mouse.getPos() == finalcut::FPoint(16, 32) );
@@ -582,7 +582,7 @@ void FMouseTest::sgrMouseTest()
   CPPUNIT_ASSERT ( std::strcmp(rawdata1, "@@") == 0 );
 
   timeval tv;
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
 
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(73, 4) );
@@ -640,7 +640,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( ! sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(73, 4) );
@@ -667,7 +667,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -700,7 +700,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(3, 3) );
@@ -734,7 +734,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(4, 9) );
@@ -767,7 +767,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(1, 2) );
@@ -806,7 +806,7 @@ void FMouseTest::sgrMouseTest()
 
   CPPUNIT_ASSERT ( sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   sgr_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! sgr_mouse.hasData() );
   CPPUNIT_ASSERT ( sgr_mouse.getPos() == finalcut::FPoint(5, 5) );
@@ -896,7 +896,7 @@ void FMouseTest::urxvtMouseTest()
   CPPUNIT_ASSERT ( std::strcmp(rawdata1, "@@") == 0 );
 
   timeval tv;
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(49, 6) );
   CPPUNIT_ASSERT ( urxvt_mouse.hasEvent() );
@@ -953,7 +953,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( ! urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(49, 6) );
@@ -980,7 +980,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(1, 1) );
@@ -1013,7 +1013,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(3, 3) );
@@ -1047,7 +1047,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(4, 9) );
@@ -1080,7 +1080,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(1, 2) );
@@ -1119,7 +1119,7 @@ void FMouseTest::urxvtMouseTest()
 
   CPPUNIT_ASSERT ( urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   urxvt_mouse.processEvent (&tv);
   CPPUNIT_ASSERT ( ! urxvt_mouse.hasData() );
   CPPUNIT_ASSERT ( urxvt_mouse.getPos() == finalcut::FPoint(5, 5) );
@@ -1272,7 +1272,7 @@ void FMouseTest::mouseControlTest()
   CPPUNIT_ASSERT ( mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.isInputDataPending() );
   timeval tv;
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   mouse_control.processEvent (&tv);
   CPPUNIT_ASSERT ( ! mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(5, 8) );
@@ -1306,7 +1306,7 @@ void FMouseTest::mouseControlTest()
   mouse_control.setRawData (finalcut::FMouse::sgr, rawdata2);
   CPPUNIT_ASSERT ( mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   mouse_control.processEvent (&tv);
   CPPUNIT_ASSERT ( ! mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(1, 1) );
@@ -1337,7 +1337,7 @@ void FMouseTest::mouseControlTest()
   mouse_control.setRawData (finalcut::FMouse::urxvt, rawdata3);
   CPPUNIT_ASSERT ( mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   mouse_control.processEvent (&tv);
   CPPUNIT_ASSERT ( ! mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(3, 3) );
@@ -1370,7 +1370,7 @@ void FMouseTest::mouseControlTest()
   mouse_control.setRawData (finalcut::FMouse::x11, rawdata4);
   CPPUNIT_ASSERT ( mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   mouse_control.processEvent (&tv);
   CPPUNIT_ASSERT ( ! mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(80, 25) );
@@ -1402,7 +1402,7 @@ void FMouseTest::mouseControlTest()
   mouse_control.setRawData (finalcut::FMouse::sgr, rawdata5);
   CPPUNIT_ASSERT ( mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.isInputDataPending() );
-  finalcut::FObject::getCurrentTime(&tv);
+  finalcut::FObject::getMonotonicTime(&tv);
   mouse_control.processEvent (&tv);
   CPPUNIT_ASSERT ( ! mouse_control.hasData() );
   CPPUNIT_ASSERT ( mouse_control.getPos() == finalcut::FPoint(1, 2) );
@@ -20,6 +20,8 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <ctime>
+
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -107,6 +109,35 @@ class FObject_timer : public finalcut::FObject
 
 //----------------------------------------------------------------------
 
+class FObject_timerOrder : public finalcut::FObject
+{
+  public:
+    FObject_timerOrder()
+    { }
+
+    FTimerList* getTimerList() const
+    {
+      return finalcut::FObject::getTimerList();
+    }
+
+    uInt processEvent()
+    {
+      return processTimerEvent();
+    }
+
+    // Data member
+    std::vector<int> order{};
+
+  private:
+    virtual void performTimerAction (const FObject*, const finalcut::FEvent* ev)
+    {
+      const auto timer_ev = static_cast<const finalcut::FTimerEvent*>(ev);
+      order.push_back(timer_ev->getTimerId());
+    }
+};
+
+//----------------------------------------------------------------------
+
 class FObject_userEvent : public finalcut::FObject
 {
   public:
@@ -156,6 +187,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     void timeTest();
     void timerTest();
     void performTimerActionTest();
+    void timerOrderTest();
     void userEventTest();
 
   private:
@@ -175,6 +207,7 @@ class FObjectTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (timeTest);
     CPPUNIT_TEST (timerTest);
     CPPUNIT_TEST (performTimerActionTest);
+    CPPUNIT_TEST (timerOrderTest);
     CPPUNIT_TEST (userEventTest);
 
     // End of test suite definition
@@ -478,6 +511,20 @@ void FObjectTest::timeTest()
   time1.tv_sec = 300;
   time1.tv_usec = 2000000;  // > 1000000 µs to test diff underflow
   CPPUNIT_ASSERT ( finalcut::FObject::isTimeout (&time1, timeout) );
+
+  // getCurrentTime() returns the wall-clock time
+  finalcut::FObject::getCurrentTime(&time1);
+  const time_t wall_time = time(nullptr);
+  CPPUNIT_ASSERT ( time1.tv_sec >= wall_time - 1 );
+  CPPUNIT_ASSERT ( time1.tv_sec <= wall_time + 1 );
+
+  // Time spans of the monotonic clock
+  struct timeval time2;
+  finalcut::FObject::getMonotonicTime(&time2);
+  CPPUNIT_ASSERT ( time2.tv_usec >= 0 && time2.tv_usec < 1000000 );
+  CPPUNIT_ASSERT ( ! finalcut::FObject::isMonotonicTimeout (&time2, timeout) );
+  sleep(1);
+  CPPUNIT_ASSERT ( finalcut::FObject::isMonotonicTimeout (&time2, timeout) );
 }
 
 //----------------------------------------------------------------------
@@ -617,6 +664,71 @@ void FObjectTest::performTimerActionTest()
   CPPUNIT_ASSERT ( t2.getValue() == 10 );
 }
 
+//----------------------------------------------------------------------
+void FObjectTest::timerOrderTest()
+{
+  using finalcut::operator +;
+  using finalcut::operator <;
+
+  test::FObject_timerOrder t;
+  timeval timeout{};
+  CPPUNIT_ASSERT ( ! t.getNextTimerTimeout(&timeout) );
+
+  // The lowest free id is reused
+  const int id1 = t.addTimer(600);
+  const int id2 = t.addTimer(200);
+  const int id3 = t.addTimer(400);
+  CPPUNIT_ASSERT ( id1 == 1 );
+  CPPUNIT_ASSERT ( id2 == 2 );
+  CPPUNIT_ASSERT ( id3 == 3 );
+  CPPUNIT_ASSERT ( t.delTimer(id2) );
+  CPPUNIT_ASSERT ( ! t.delTimer(id2) );
+  CPPUNIT_ASSERT ( t.addTimer(200) == id2 );
+  CPPUNIT_ASSERT ( t.addTimer(800) == 4 );
+  CPPUNIT_ASSERT ( t.delTimer(4) );
+  CPPUNIT_ASSERT ( t.getTimerList()->size() == 3 );
+
+  // The next timeout is the earliest one
+  timeval now{};
+  finalcut::FObject::getMonotonicTime(&now);
+  CPPUNIT_ASSERT ( t.getNextTimerTimeout(&timeout) );
+  const timeval interval{0, 200001};
+  CPPUNIT_ASSERT ( now < timeout );
+  CPPUNIT_ASSERT ( timeout < now + interval );
+
+  // Timers expire in the order of their timeout
+  const struct timespec ms500[]{{0, 500000000L}};
+  nanosleep (ms500, NULL);
+  CPPUNIT_ASSERT ( t.processEvent() == 2 );
+  CPPUNIT_ASSERT ( t.order.size() == 2 );
+  CPPUNIT_ASSERT ( t.order[0] == id2 );
+  CPPUNIT_ASSERT ( t.order[1] == id3 );
+
+  // The rescheduled timers (700 ms and 800 ms) do not
+  // hide the earlier timeout of the first timer (600 ms)
+  const struct timespec ms150[]{{0, 150000000L}};
+  nanosleep (ms150, NULL);
+  t.order.clear();
+  CPPUNIT_ASSERT ( t.processEvent() == 1 );
+  CPPUNIT_ASSERT ( t.order.size() == 1 );
+  CPPUNIT_ASSERT ( t.order[0] == id1 );
+
+  // Each timer expires only once per call
+  t.delAllTimer();
+  t.addTimer(0);
+  t.addTimer(0);
+  t.order.clear();
+  CPPUNIT_ASSERT ( t.processEvent() == 0 );  // No interval
+  CPPUNIT_ASSERT ( t.order.size() == 2 );
+  CPPUNIT_ASSERT ( t.order[0] != t.order[1] );
+
+  // Ids are released with the timers of their object
+  t.delOwnTimer();
+  CPPUNIT_ASSERT ( t.getTimerList()->empty() );
+  CPPUNIT_ASSERT ( t.addTimer(50) == 1 );
+  t.delOwnTimer();
+}
+
 //----------------------------------------------------------------------
 void FObjectTest::userEventTest()
 {
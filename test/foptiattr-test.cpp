@@ -70,6 +70,9 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void vga2ansiTest();
     void sgrOptimizerTest();
     void fakeReverseTest();
+    void cacheTest();
+    void colorTableTest();
+    void directSGRTest();
     void ansiTest();
     void vt100Test();
     void xtermTest();
@@ -93,6 +96,9 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (vga2ansiTest);
     CPPUNIT_TEST (sgrOptimizerTest);
     CPPUNIT_TEST (fakeReverseTest);
+    CPPUNIT_TEST (cacheTest);
+    CPPUNIT_TEST (colorTableTest);
+    CPPUNIT_TEST (directSGRTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
     CPPUNIT_TEST (xtermTest);
@@ -412,6 +418,324 @@ void FOptiAttrTest::fakeReverseTest()
   delete from;
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::cacheTest()
+{
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (8);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode (C_STR(CSI "1m"));
+  oa.set_exit_bold_mode (0);
+  oa.set_enter_reverse_mode (C_STR(CSI "7m"));
+  oa.set_exit_reverse_mode (0);
+  oa.set_enter_secure_mode (0);
+  oa.set_exit_secure_mode (0);
+  oa.set_exit_attribute_mode (C_STR(CSI "0m"));
+  oa.set_a_foreground_color (C_STR(CSI "3%p1%dm"));
+  oa.set_a_background_color (C_STR(CSI "4%p1%dm"));
+  oa.set_orig_pair (C_STR(CSI "39;49m"));
+  oa.initialize();
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 0 );
+
+  finalcut::FChar from{};
+  finalcut::FChar to{};
+  finalcut::FChar* from_ptr = &from;
+  finalcut::FChar* to_ptr = &to;
+
+  // Red bold text on a white background
+  to.fg_color = finalcut::fc::Red;
+  to.bg_color = finalcut::fc::LightGray;
+  to.attr.bit.bold = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr)
+                         , C_STR(CSI "31m" CSI "47m" CSI "1m") );
+  CPPUNIT_ASSERT ( from == to );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 1 );
+
+  // No changes
+  CPPUNIT_ASSERT ( oa.changeAttribute(from_ptr, to_ptr) == 0 );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from_ptr, to_ptr) == 0 );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 1 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 2 );
+
+  // The same transition again
+  from = finalcut::FChar{};
+  from.ch = L'A';
+  to.ch = L'B';
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr)
+                         , C_STR(CSI "31m" CSI "47m" CSI "1m") );
+  CPPUNIT_ASSERT ( from.fg_color == finalcut::fc::Red );
+  CPPUNIT_ASSERT ( from.bg_color == finalcut::fc::LightGray );
+  CPPUNIT_ASSERT ( from.attr.bit.bold );
+  CPPUNIT_ASSERT ( from.ch == L'A' );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 2 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 2 );
+
+  // Invisible characters are simulated with a space
+  to.attr.bit.invisible = true;
+  to.encoded_char = L'B';
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr), C_STR("") );
+  CPPUNIT_ASSERT ( from.attr.bit.invisible );
+  CPPUNIT_ASSERT ( to.encoded_char == L' ' );
+  from.attr.bit.invisible = false;
+  to.encoded_char = L'B';
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr), C_STR("") );
+  CPPUNIT_ASSERT ( from.attr.bit.invisible );
+  CPPUNIT_ASSERT ( to.encoded_char == L' ' );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 3 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 3 );
+
+  // A color mode change invalidates the cache
+  oa.setMaxColor (1);
+  oa.initialize();
+  from = finalcut::FChar{};
+  to.attr.bit.invisible = false;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr)
+                         , C_STR(CSI "1m") );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 3 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 4 );
+
+  oa.clearCache();
+  from = finalcut::FChar{};
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from_ptr, to_ptr)
+                         , C_STR(CSI "1m") );
+  CPPUNIT_ASSERT ( oa.getCacheHits() == 3 );
+  CPPUNIT_ASSERT ( oa.getCacheMisses() == 5 );
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::colorTableTest()
+{
+  // Compares the precomputed color sequences
+  // with the sequences created by tparm()
+
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  char* AF = C_STR(CSI "%?%p1%{8}%<"
+                       "%t3%p1%d"
+                       "%e%p1%{16}%<"
+                       "%t9%p1%{8}%-%d"
+                       "%e38;5;%p1%d%;m");
+  char* AB = C_STR(CSI "%?%p1%{8}%<"
+                       "%t4%p1%d"
+                       "%e%p1%{16}%<"
+                       "%t10%p1%{8}%-%d"
+                       "%e48;5;%p1%d%;m");
+  char* sp = C_STR(CSI "3%p1%d;4%p2%dm");
+  finalcut::FOptiAttr table_oa;
+  finalcut::FOptiAttr tparm_oa;
+  finalcut::FOptiAttr* oa_list[] = { &table_oa, &tparm_oa };
+
+  for (auto&& oa : oa_list)
+  {
+    oa->setDefaultColorSupport();  // ANSI default color
+    oa->setMaxColor (256);
+    oa->setNoColorVideo (0);
+    oa->set_a_foreground_color (AF);
+    oa->set_a_background_color (AB);
+    oa->set_orig_pair (C_STR(CSI "39;49m"));
+    oa->initialize();
+  }
+
+  // Changing a color capability discards the color table
+  tparm_oa.set_a_foreground_color (AF);
+  tparm_oa.set_a_background_color (AB);
+
+  for (FColor color{0}; color < 256; color++)
+  {
+    for (auto&& oa : oa_list)
+    {
+      finalcut::FChar from{};
+      finalcut::FChar to{};
+      finalcut::FChar* from_ptr = &from;
+      finalcut::FChar* to_ptr = &to;
+      from.fg_color = finalcut::fc::Default;
+      from.bg_color = finalcut::fc::Default;
+      to.fg_color = color;
+      to.bg_color = FColor(255 - color);
+      const std::string seq = oa->changeAttribute(from_ptr, to_ptr);
+      CPPUNIT_ASSERT ( from == to );
+
+      if ( oa == &table_oa )
+      {
+        finalcut::FChar tparm_from = finalcut::FChar{};
+        finalcut::FChar* tparm_from_ptr = &tparm_from;
+        tparm_from.fg_color = finalcut::fc::Default;
+        tparm_from.bg_color = finalcut::fc::Default;
+        CPPUNIT_ASSERT_CSTRING ( seq.c_str()
+                               , tparm_oa.changeAttribute(tparm_from_ptr, to_ptr) );
+      }
+    }
+  }
+
+  // Terminal with color pairs
+  for (auto&& oa : oa_list)
+  {
+    oa->setMaxColor (8);
+    oa->unsetDefaultColorSupport();
+    oa->set_term_color_pair (sp);
+    oa->initialize();
+  }
+
+  tparm_oa.set_term_color_pair (sp);
+
+  for (FColor fg{0}; fg < 8; fg++)
+  {
+    for (FColor bg{0}; bg < 8; bg++)
+    {
+      finalcut::FChar from1{}, from2{}, to{};
+      finalcut::FChar* from1_ptr = &from1;
+      finalcut::FChar* from2_ptr = &from2;
+      finalcut::FChar* to_ptr = &to;
+      from1.fg_color = from2.fg_color = finalcut::fc::Default;
+      from1.bg_color = from2.bg_color = finalcut::fc::Default;
+      to.fg_color = fg;
+      to.bg_color = bg;
+      const std::string seq = table_oa.changeAttribute(from1_ptr, to_ptr);
+      CPPUNIT_ASSERT_CSTRING ( seq.c_str()
+                             , tparm_oa.changeAttribute(from2_ptr, to_ptr) );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::directSGRTest()
+{
+  // Simulate an ECMA-48 compatible xterm-256color terminal
+
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = true;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (256);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode (C_STR(CSI "1m"));
+  oa.set_exit_bold_mode (C_STR(CSI "22m"));
+  oa.set_enter_dim_mode (C_STR(CSI "2m"));
+  oa.set_exit_dim_mode (C_STR(CSI "22m"));
+  oa.set_enter_italics_mode (C_STR(CSI "3m"));
+  oa.set_exit_italics_mode (C_STR(CSI "23m"));
+  oa.set_enter_underline_mode (C_STR(CSI "4m"));
+  oa.set_exit_underline_mode (C_STR(CSI "24m"));
+  oa.set_enter_blink_mode (C_STR(CSI "5m"));
+  oa.set_exit_blink_mode (C_STR(CSI "25m"));
+  oa.set_enter_reverse_mode (C_STR(CSI "7m"));
+  oa.set_exit_reverse_mode (C_STR(CSI "27m"));
+  oa.set_enter_standout_mode (C_STR(CSI "7m"));
+  oa.set_exit_standout_mode (C_STR(CSI "27m"));
+  oa.set_enter_secure_mode (C_STR(CSI "8m"));
+  oa.set_exit_secure_mode (C_STR(CSI "28m"));
+  oa.set_exit_protected_mode (C_STR(CSI "0m"));
+  oa.set_enter_crossed_out_mode (C_STR(CSI "9m"));
+  oa.set_exit_crossed_out_mode (C_STR(CSI "29m"));
+  oa.set_enter_dbl_underline_mode (C_STR(CSI "21m"));
+  oa.set_exit_dbl_underline_mode (C_STR(CSI "24m"));
+  oa.set_set_attributes (C_STR("%?%p9%t" ESC "(0"
+                                    "%e" ESC "(B%;" CSI "0"
+                               "%?%p6%t;1%;"
+                               "%?%p5%t;2%;"
+                               "%?%p2%t;4%;"
+                               "%?%p1%p3%|%t;7%;"
+                               "%?%p4%t;5%;"
+                               "%?%p7%t;8%;m"));
+  oa.set_exit_attribute_mode (C_STR(ESC "(B" CSI "m"));
+  oa.set_enter_alt_charset_mode (C_STR(ESC "(0"));
+  oa.set_exit_alt_charset_mode (C_STR(ESC "(B"));
+  oa.set_a_foreground_color (C_STR(CSI "%?%p1%{8}%<"
+                                       "%t3%p1%d"
+                                       "%e%p1%{16}%<"
+                                       "%t9%p1%{8}%-%d"
+                                       "%e38;5;%p1%d%;m"));
+  oa.set_a_background_color (C_STR(CSI "%?%p1%{8}%<"
+                                       "%t4%p1%d"
+                                       "%e%p1%{16}%<"
+                                       "%t10%p1%{8}%-%d"
+                                       "%e48;5;%p1%d%;m"));
+  oa.set_orig_pair (C_STR(CSI "39;49m"));
+  oa.initialize();
+  CPPUNIT_ASSERT ( oa.isDirectSGR() );
+
+  finalcut::FChar* from = new finalcut::FChar();
+  finalcut::FChar* to = new finalcut::FChar();
+  from->fg_color = finalcut::fc::Default;
+  from->bg_color = finalcut::fc::Default;
+  to->fg_color = finalcut::fc::Default;
+  to->bg_color = finalcut::fc::Default;
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // Bold red text
+  to->attr.bit.bold = true;
+  to->fg_color = finalcut::fc::Red;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "1;31m") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // Bold off + italic on
+  to->attr.bit.bold = false;
+  to->attr.bit.italic = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "22;3m") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // Dim + bold, then dim off ("22" switches off both)
+  to->attr.bit.bold = true;
+  to->attr.bit.dim = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "1;2m") );
+  to->attr.bit.dim = false;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "22;1m") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // 256 colors
+  to->fg_color = 200;
+  to->bg_color = finalcut::fc::LightBlue;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , C_STR(CSI "38;5;200;104m") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // Reverse and standout use the same parameter
+  to->attr.bit.reverse = true;
+  to->attr.bit.standout = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "7m") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // A reset is shorter than switching off each attribute
+  to->attr.bit.bold = false;
+  to->attr.bit.italic = false;
+  to->attr.bit.reverse = false;
+  to->attr.bit.standout = false;
+  to->fg_color = finalcut::fc::Default;
+  to->bg_color = finalcut::fc::Default;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(CSI "0m") );
+  CPPUNIT_ASSERT ( *from == *to );
+  CPPUNIT_ASSERT ( oa.changeAttribute(from, to) == 0 );
+
+  // The alternate character set is not switched by SGR
+  to->attr.bit.alt_charset = true;
+  to->attr.bit.underline = true;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , C_STR(ESC "(0" CSI "4m") );
+  CPPUNIT_ASSERT ( *from == *to );
+  to->attr.bit.alt_charset = false;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to), C_STR(ESC "(B") );
+  CPPUNIT_ASSERT ( *from == *to );
+
+  // Without the SGR optimizer the termcap path is used
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = false;
+  CPPUNIT_ASSERT ( ! oa.isDirectSGR() );
+  to->attr.bit.underline = false;
+  CPPUNIT_ASSERT_CSTRING ( oa.changeAttribute(from, to)
+                         , C_STR(ESC "(B" CSI "m") );
+  CPPUNIT_ASSERT ( *from == *to );
+  finalcut::FStartOptions::getFStartOptions().sgr_optimizer = true;
+
+  // Non-ECMA-48 terminal capability
+  oa.set_enter_bold_mode (C_STR(ESC "B"));
+  oa.initialize();
+  CPPUNIT_ASSERT ( ! oa.isDirectSGR() );
+
+  delete to;
+  delete from;
+}
+
 //----------------------------------------------------------------------
 void FOptiAttrTest::ansiTest()
 {
@@ -71,6 +71,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     void fromLeftToRightTest();
     void ansiTest();
     void vt100Test();
+    void throughputTest();
     void xtermTest();
     void rxvtTest();
     void linuxTest();
@@ -92,6 +93,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (fromLeftToRightTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
+    CPPUNIT_TEST (throughputTest);
     CPPUNIT_TEST (xtermTest);
     CPPUNIT_TEST (rxvtTest);
     CPPUNIT_TEST (linuxTest);
@@ -305,6 +307,33 @@ void FOptiMoveTest::vt100Test()
   CPPUNIT_ASSERT_CSTRING (om.moveCursor (53, 2, 53, -3), C_STR(CSI "2A"));
 }
 
+//----------------------------------------------------------------------
+void FOptiMoveTest::throughputTest()
+{
+  finalcut::FOptiMove om;
+  om.setTermSize (80, 24);
+  om.setBaudRate (1200);
+  om.set_cursor_up (C_STR(CSI "A$<2>"));
+  om.set_cursor_address (C_STR(CSI "%i%p1%d;%p2%dH$<5>"));
+
+  // At 1200 baud, the padding is shorter than one character
+  CPPUNIT_ASSERT ( om.getCursorUpLength() == 4 );
+  CPPUNIT_ASSERT ( om.getCursorAddressLength() == 9 );
+
+  // A measured throughput of 1 MB/s makes the padding expensive
+  om.setThroughput (1000000);
+  CPPUNIT_ASSERT ( om.getCursorUpLength() == 23 );
+  CPPUNIT_ASSERT ( om.getCursorAddressLength() == 58 );
+
+  // An unknown throughput does not change the baud rate
+  om.setThroughput (0);
+  CPPUNIT_ASSERT ( om.getCursorAddressLength() == 58 );
+
+  om.setBaudRate (1200);
+  CPPUNIT_ASSERT ( om.getCursorUpLength() == 4 );
+  CPPUNIT_ASSERT ( om.getCursorAddressLength() == 9 );
+}
+
 //----------------------------------------------------------------------
 void FOptiMoveTest::xtermTest()
 {
@@ -630,6 +659,8 @@ void FOptiMoveTest::teratermTest()
     0,                            // Repeat character
     C_STR(CSI "1K"),              // Clear to beginning of line
     C_STR(CSI "K"),               // Clear to end of line
+    C_STR(CSI "%p1%d@"),          // Insert characters
+    C_STR(CSI "%p1%dP"),          // Delete characters
     8,                            // Tab stop
     false,                        // Automatic left margin
     true                          // Eat newline glitch
@@ -637,6 +668,10 @@ void FOptiMoveTest::teratermTest()
 
   om.setTermEnvironment(optimove_env);
 
+  // Lengths of the character update sequences
+  CPPUNIT_ASSERT ( om.getInsertCharsLength() == 5 );
+  CPPUNIT_ASSERT ( om.getDeleteCharsLength() == 5 );
+
   CPPUNIT_ASSERT_CSTRING (om.moveCursor (0, 0, 5, 5), C_STR(CSI "6;6H"));
   CPPUNIT_ASSERT_CSTRING (om.moveCursor (5, 5, 0, 0), C_STR(CSI "H"));
   CPPUNIT_ASSERT_CSTRING (om.moveCursor (79, 1, 0, 1), C_STR("\r"));
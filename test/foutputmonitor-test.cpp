@@ -0,0 +1,368 @@
+/***********************************************************************
+* foutputmonitor-test.cpp - FOutputMonitor unit tests                  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include <cstdarg>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+// class FSystemTest
+//----------------------------------------------------------------------
+
+class FSystemTest : public finalcut::FSystem
+{
+  public:
+    // Constructor
+    FSystemTest() = default;
+
+    // Destructor
+    virtual ~FSystemTest() = default;
+
+    // Mutator
+    void             setOutputQueue (int);
+
+    // Methods
+    uChar            inPortByte (uShort) override;
+    void             outPortByte (uChar, uShort) override;
+    int              isTTY (int) override;
+    int              ioctl (int, uLong, ...) override;
+    int              open (const char*, int, ...) override;
+    int              close (int) override;
+    FILE*            fopen (const char*, const char*) override;
+    int              fclose (FILE*) override;
+    int              putchar (int) override;
+    ssize_t          write (int, const void*, std::size_t) override;
+    int              tputs (const char*, int, int (*)(int)) override;
+    uid_t            getuid() override;
+    uid_t            geteuid() override;
+    int              getpwuid_r (uid_t, struct passwd*, char*
+                                , size_t, struct passwd** ) override;
+    char*            realpath (const char*, char*) override;
+
+  private:
+    int output_queue{-1};  // -1 = TIOCOUTQ not supported
+};
+
+//----------------------------------------------------------------------
+inline void FSystemTest::setOutputQueue (int queue)
+{
+  output_queue = queue;
+}
+
+//----------------------------------------------------------------------
+uChar FSystemTest::inPortByte (uShort)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FSystemTest::outPortByte (uChar, uShort)
+{ }
+
+//----------------------------------------------------------------------
+int FSystemTest::isTTY (int)
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::ioctl (int, uLong request, ...)
+{
+  va_list args{};
+  va_start (args, request);
+  void* argp = va_arg (args, void*);
+  int ret_val{-1};
+
+  if ( request == TIOCOUTQ && output_queue >= 0 )
+  {
+    *static_cast<int*>(argp) = output_queue;
+    ret_val = 0;
+  }
+
+  va_end (args);
+  return ret_val;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::open (const char*, int, ...)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::close (int)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+FILE* FSystemTest::fopen (const char*, const char*)
+{
+  return nullptr;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::fclose (FILE*)
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::putchar (int c)
+{
+  return c;
+}
+
+//----------------------------------------------------------------------
+ssize_t FSystemTest::write (int, const void*, std::size_t count)
+{
+  return ssize_t(count);
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::tputs (const char*, int, int (*)(int))
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+uid_t FSystemTest::getuid()
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+uid_t FSystemTest::geteuid()
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+int FSystemTest::getpwuid_r ( uid_t, struct passwd*, char*
+                            , size_t, struct passwd** )
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+char* FSystemTest::realpath (const char*, char*)
+{
+  return const_cast<char*>("");
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// functions
+//----------------------------------------------------------------------
+timeval msec (int ms)
+{
+  timeval time{};
+  time.tv_sec = ms / 1000;
+  time.tv_usec = (ms % 1000) * 1000;
+  return time;
+}
+
+
+//----------------------------------------------------------------------
+// class FOutputMonitorTest
+//----------------------------------------------------------------------
+
+class FOutputMonitorTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FOutputMonitorTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noQueueTest();
+    void throughputTest();
+    void idleLinkTest();
+    void writeTimeTest();
+    void backlogTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FOutputMonitorTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noQueueTest);
+    CPPUNIT_TEST (throughputTest);
+    CPPUNIT_TEST (idleLinkTest);
+    CPPUNIT_TEST (writeTimeTest);
+    CPPUNIT_TEST (backlogTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::classNameTest()
+{
+  test::FSystemTest fsys{};
+  const finalcut::FOutputMonitor monitor(&fsys, 1);
+  const finalcut::FString& classname = monitor.getClassName();
+  CPPUNIT_ASSERT ( classname == "FOutputMonitor" );
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::noQueueTest()
+{
+  // The system does not support TIOCOUTQ
+  test::FSystemTest fsys{};
+  finalcut::FOutputMonitor monitor(&fsys, 1);
+  monitor.addWrittenBytes (100000);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(0)) );
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(100)) );
+  CPPUNIT_ASSERT ( monitor.getQueueLength() == 0 );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( ! monitor.isBacklogged(0) );
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::throughputTest()
+{
+  test::FSystemTest fsys{};
+  finalcut::FOutputMonitor monitor(&fsys, 1);
+
+  // Sample start
+  fsys.setOutputQueue (1000);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(0)) );
+  CPPUNIT_ASSERT ( monitor.getQueueLength() == 1000 );
+  monitor.addWrittenBytes (5000);
+
+  // Too short for a sample
+  fsys.setOutputQueue (3000);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(5)) );
+  CPPUNIT_ASSERT ( monitor.getQueueLength() == 3000 );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+
+  // 4000 bytes in 100 ms
+  fsys.setOutputQueue (2000);
+  CPPUNIT_ASSERT ( monitor.measure(msec(100)) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 40000 );
+
+  // 2000 bytes in 100 ms
+  monitor.addWrittenBytes (1000);
+  fsys.setOutputQueue (1000);
+  CPPUNIT_ASSERT ( monitor.measure(msec(200)) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 35000 );
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::idleLinkTest()
+{
+  test::FSystemTest fsys{};
+  finalcut::FOutputMonitor monitor(&fsys, 1);
+
+  // An empty queue shows no throughput
+  fsys.setOutputQueue (0);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(0)) );
+  monitor.addWrittenBytes (5000);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(100)) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+
+  fsys.setOutputQueue (500);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(200)) );
+  monitor.addWrittenBytes (1500);
+  fsys.setOutputQueue (0);
+  CPPUNIT_ASSERT ( ! monitor.measure(msec(300)) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( ! monitor.isBacklogged(0) );
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::writeTimeTest()
+{
+  test::FSystemTest fsys{};
+  finalcut::FOutputMonitor monitor(&fsys, 1);
+
+  // Fast writes say nothing about the link
+  CPPUNIT_ASSERT ( ! monitor.addWriteTime(1000, 500) );
+  CPPUNIT_ASSERT ( ! monitor.addWriteTime(0, 5000) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+
+  // 10000 bytes in 500 ms
+  CPPUNIT_ASSERT ( monitor.addWriteTime(10000, 500000) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 20000 );
+
+  // 30000 bytes in 1 s
+  CPPUNIT_ASSERT ( monitor.addWriteTime(30000, 1000000) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 22500 );
+}
+
+//----------------------------------------------------------------------
+void FOutputMonitorTest::backlogTest()
+{
+  test::FSystemTest fsys{};
+  finalcut::FOutputMonitor monitor(&fsys, 1);
+
+  // Unknown throughput
+  fsys.setOutputQueue (4000);
+  monitor.measure(msec(0));
+  CPPUNIT_ASSERT ( ! monitor.isBacklogged(0) );
+  fsys.setOutputQueue (finalcut::FOutputMonitor::MAX_UNKNOWN_QUEUE + 1);
+  monitor.measure(msec(1));
+  CPPUNIT_ASSERT ( monitor.isBacklogged(1000000) );
+  CPPUNIT_ASSERT ( monitor.getDrainTime(1000000) == 1000000 );
+
+  // 10000 bytes per second
+  fsys.setOutputQueue (1000);
+  monitor.addWrittenBytes (7000);
+  CPPUNIT_ASSERT ( monitor.measure(msec(1000)) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 10000 );
+
+  // 1000 bytes need 100 ms
+  CPPUNIT_ASSERT ( monitor.isBacklogged(16667) );
+  CPPUNIT_ASSERT ( monitor.isBacklogged(99999) );
+  CPPUNIT_ASSERT ( ! monitor.isBacklogged(100000) );
+  CPPUNIT_ASSERT ( monitor.getDrainTime(16667) == 83333 );
+  CPPUNIT_ASSERT ( monitor.getDrainTime(100000) == 0 );
+
+  fsys.setOutputQueue (0);
+  monitor.measure(msec(1100));
+  CPPUNIT_ASSERT ( ! monitor.isBacklogged(0) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 10000 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FOutputMonitorTest);
+
+// The general unit test main part
+#include <main-test.inc>
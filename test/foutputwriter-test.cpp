@@ -0,0 +1,260 @@
+/***********************************************************************
+* foutputwriter-test.cpp - FOutputWriter unit tests                    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// functions
+//----------------------------------------------------------------------
+std::string readPipe (int fd, std::size_t length)
+{
+  // Reads length bytes from the pipe
+
+  std::string data{};
+  char buffer[4096];
+
+  while ( data.length() < length )
+  {
+    const ssize_t bytes = read(fd, buffer, sizeof(buffer));
+
+    if ( bytes <= 0 )
+      break;
+
+    data.append(buffer, std::size_t(bytes));
+  }
+
+  return data;
+}
+
+
+//----------------------------------------------------------------------
+// class FOutputWriterTest
+//----------------------------------------------------------------------
+
+class FOutputWriterTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FOutputWriterTest()
+    { }
+
+    void setUp();
+    void tearDown();
+
+  protected:
+    void classNameTest();
+    void writeTest();
+    void combineTest();
+    void nonBlockingTest();
+    void destructorTest();
+    void wakeUpTest();
+    void stalledTerminalTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FOutputWriterTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (writeTest);
+    CPPUNIT_TEST (combineTest);
+    CPPUNIT_TEST (nonBlockingTest);
+    CPPUNIT_TEST (destructorTest);
+    CPPUNIT_TEST (wakeUpTest);
+    CPPUNIT_TEST (stalledTerminalTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data members
+    finalcut::FSystem* fsys{finalcut::FTerm::getFSystem()};
+    int fds[2]{-1, -1};
+};
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::setUp()
+{
+  CPPUNIT_ASSERT ( pipe(fds) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::tearDown()
+{
+  close (fds[0]);
+  close (fds[1]);
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::classNameTest()
+{
+  const finalcut::FOutputWriter writer(fsys, fds[1]);
+  const finalcut::FString& classname = writer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FOutputWriter" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::writeTest()
+{
+  finalcut::FOutputWriter writer(fsys, fds[1]);
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+
+  std::string buffer{"\033[H\033[2JHello"};
+  writer.write (buffer);
+  CPPUNIT_ASSERT ( buffer.empty() );
+  writer.waitForCompletion();
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+  CPPUNIT_ASSERT ( readPipe(fds[0], 12) == "\033[H\033[2JHello" );
+
+  // Empty buffers are ignored
+  writer.write (buffer);
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+
+  // The buffer can be reused after the handover
+  buffer = "World";
+  writer.write (buffer);
+  CPPUNIT_ASSERT ( buffer.empty() );
+  writer.waitForCompletion();
+  CPPUNIT_ASSERT ( readPipe(fds[0], 5) == "World" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::combineTest()
+{
+  finalcut::FOutputWriter writer(fsys, fds[1]);
+  std::string buffer{};
+  std::string expected{};
+
+  // The pipe buffer is too small for the data, so that the
+  // writer thread is still busy with the first frame
+  std::string frame(256 * 1024, 'a');
+  expected += frame;
+  writer.write (frame);
+  CPPUNIT_ASSERT ( writer.isBusy() );
+
+  for (int i{0}; i < 10; i++)
+  {
+    buffer = std::to_string(i);
+    expected += buffer;
+    writer.write (buffer);
+    CPPUNIT_ASSERT ( buffer.empty() );
+  }
+
+  CPPUNIT_ASSERT ( writer.isBusy() );
+  CPPUNIT_ASSERT ( readPipe(fds[0], expected.length()) == expected );
+  writer.waitForCompletion();
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::nonBlockingTest()
+{
+  const int flags = fcntl(fds[1], F_GETFL);
+  CPPUNIT_ASSERT ( fcntl(fds[1], F_SETFL, flags | O_NONBLOCK) == 0 );
+
+  finalcut::FOutputWriter writer(fsys, fds[1]);
+  std::string buffer{};
+
+  for (std::size_t i{0}; i < 512 * 1024; i++)
+    buffer.push_back(char('A' + i % 26));
+
+  const std::string expected{buffer};
+  writer.write (buffer);
+
+  // The writer waits until the pipe can take more data
+  CPPUNIT_ASSERT ( readPipe(fds[0], expected.length()) == expected );
+  writer.waitForCompletion();
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::destructorTest()
+{
+  std::string buffer(16 * 1024, 'x');
+
+  {
+    finalcut::FOutputWriter writer(fsys, fds[1]);
+    writer.write (buffer);
+    buffer = "end";
+    writer.write (buffer);
+  }  // The destructor writes out the remaining data
+
+  const std::string data = readPipe(fds[0], 16 * 1024 + 3);
+  CPPUNIT_ASSERT ( data.length() == 16 * 1024 + 3 );
+  CPPUNIT_ASSERT ( data.substr(16 * 1024) == "end" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::wakeUpTest()
+{
+  CPPUNIT_ASSERT ( finalcut::FPoll::init() );
+  finalcut::FOutputWriter writer(fsys, fds[1]);
+  std::string buffer{"frame"};
+  const auto start = std::chrono::steady_clock::now();
+  writer.write (buffer);
+
+  // The end of the write wakes up the event loop
+  finalcut::FPoll::waitForInput (-1, 10000000);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  CPPUNIT_ASSERT ( elapsed < std::chrono::seconds(5) );
+  writer.waitForCompletion();
+  CPPUNIT_ASSERT ( readPipe(fds[0], 5) == "frame" );
+  finalcut::FPoll::finish();
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::stalledTerminalTest()
+{
+  const int flags = fcntl(fds[1], F_GETFL);
+  CPPUNIT_ASSERT ( fcntl(fds[1], F_SETFL, flags | O_NONBLOCK) == 0 );
+  std::string buffer(512 * 1024, 'x');
+  const auto start = std::chrono::steady_clock::now();
+
+  {
+    finalcut::FOutputWriter writer(fsys, fds[1]);
+    writer.write (buffer);
+    buffer = "end";
+    writer.write (buffer);
+  }  // Nobody reads the pipe
+
+  // The destructor gives up the data that does not fit
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  CPPUNIT_ASSERT ( elapsed < std::chrono::seconds(3) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FOutputWriterTest);
+
+// The general unit test main part
+#include <main-test.inc>
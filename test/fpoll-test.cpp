@@ -0,0 +1,335 @@
+/***********************************************************************
+* fpoll-test.cpp - FPoll unit tests                                    *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+long elapsedMilliseconds (const timeval& start)
+{
+  timeval now{};
+  gettimeofday (&now, nullptr);
+  return long(now.tv_sec - start.tv_sec) * 1000
+       + long(now.tv_usec - start.tv_usec) / 1000;
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FPollTest
+//----------------------------------------------------------------------
+
+class FPollTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FPollTest()
+    { }
+
+    void setUp();
+    void tearDown();
+
+  protected:
+    void classNameTest();
+    void timeoutTest();
+    void inputTest();
+    void readableWatchTest();
+    void writableWatchTest();
+    void watchEventsTest();
+    void closedFileDescriptorTest();
+    void wakeUpTest();
+    void outputTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FPollTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (timeoutTest);
+    CPPUNIT_TEST (inputTest);
+    CPPUNIT_TEST (readableWatchTest);
+    CPPUNIT_TEST (writableWatchTest);
+    CPPUNIT_TEST (watchEventsTest);
+    CPPUNIT_TEST (closedFileDescriptorTest);
+    CPPUNIT_TEST (wakeUpTest);
+    CPPUNIT_TEST (outputTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data member
+    int fd[2]{-1, -1};
+};
+
+//----------------------------------------------------------------------
+void FPollTest::setUp()
+{
+  CPPUNIT_ASSERT ( ::pipe(fd) == 0 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::init() );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::tearDown()
+{
+  finalcut::FPoll::finish();
+
+  for (auto&& f : fd)
+  {
+    if ( f != -1 )
+      ::close(f);
+
+    f = -1;
+  }
+}
+
+//----------------------------------------------------------------------
+void FPollTest::classNameTest()
+{
+  const finalcut::FPoll p;
+  const finalcut::FString& classname = p.getClassName();
+  CPPUNIT_ASSERT ( classname == "FPoll" );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::timeoutTest()
+{
+  timeval start{};
+  gettimeofday (&start, nullptr);
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], 50000) );
+  CPPUNIT_ASSERT ( test::elapsedMilliseconds(start) >= 45 );
+
+  // A zero timeout returns immediately
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], 0) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(-1, 0) );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::inputTest()
+{
+  CPPUNIT_ASSERT ( ::write(fd[1], "x", 1) == 1 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::waitForInput(fd[0], 1000000) );
+
+  // The input stays readable until it is read
+  CPPUNIT_ASSERT ( finalcut::FPoll::waitForInput(fd[0], 0) );
+  char c{};
+  CPPUNIT_ASSERT ( ::read(fd[0], &c, 1) == 1 );
+  CPPUNIT_ASSERT ( c == 'x' );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], 0) );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::readableWatchTest()
+{
+  int calls{0};
+  int ready_fd{-1};
+  int ready_events{finalcut::FPoll::no_event};
+
+  auto cb = [&] (int f, int events)
+  {
+    calls++;
+    ready_fd = f;
+    ready_events = events;
+    char c{};
+    CPPUNIT_ASSERT ( ::read(f, &c, 1) == 1 );
+  };
+
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::addWatch(-1, finalcut::FPoll::readable, cb) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::addWatch(fd[0], finalcut::FPoll::readable, nullptr) );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 0 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::addWatch(fd[0], finalcut::FPoll::readable, cb) );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 1 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::isWatched(fd[0]) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::isWatched(fd[1]) );
+
+  // Nothing to read
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(-1, 0) );
+  CPPUNIT_ASSERT ( calls == 0 );
+
+  // The watch is dispatched without reporting input
+  CPPUNIT_ASSERT ( ::write(fd[1], "x", 1) == 1 );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(-1, 1000000) );
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( ready_fd == fd[0] );
+  CPPUNIT_ASSERT ( ready_events == finalcut::FPoll::readable );
+
+  // A second watch for the same file descriptor replaces the first
+  int replaced_calls{0};
+  auto cb2 = [&replaced_calls] (int f, int)
+  {
+    replaced_calls++;
+    char c{};
+    CPPUNIT_ASSERT ( ::read(f, &c, 1) == 1 );
+  };
+  CPPUNIT_ASSERT ( finalcut::FPoll::addWatch(fd[0], finalcut::FPoll::readable, cb2) );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 1 );
+  CPPUNIT_ASSERT ( ::write(fd[1], "y", 1) == 1 );
+  finalcut::FPoll::waitForInput(-1, 1000000);
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( replaced_calls == 1 );
+
+  // End of file is readable
+  ::close(fd[1]);
+  fd[1] = -1;
+  finalcut::FPoll::addWatch (fd[0], finalcut::FPoll::readable, [&calls] (int, int) { calls++; });
+  finalcut::FPoll::waitForInput(-1, 1000000);
+  CPPUNIT_ASSERT ( calls == 2 );
+
+  CPPUNIT_ASSERT ( finalcut::FPoll::delWatch(fd[0]) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::delWatch(fd[0]) );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::writableWatchTest()
+{
+  int calls{0};
+  int ready_events{finalcut::FPoll::no_event};
+
+  auto cb = [&] (int f, int events)
+  {
+    calls++;
+    ready_events = events;
+    // Removes its own watch after the first write
+    CPPUNIT_ASSERT ( ::write(f, "z", 1) == 1 );
+    finalcut::FPoll::delWatch(f);
+  };
+
+  finalcut::FPoll::addWatch (fd[1], finalcut::FPoll::writable, cb);
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], 1000000) );
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( ready_events == finalcut::FPoll::writable );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 0 );
+
+  // The written byte arrives as input
+  CPPUNIT_ASSERT ( finalcut::FPoll::waitForInput(fd[0], 1000000) );
+  CPPUNIT_ASSERT ( calls == 1 );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::watchEventsTest()
+{
+  int calls{0};
+  finalcut::FPoll::addWatch ( fd[0], finalcut::FPoll::no_event
+                            , [&calls] (int, int) { calls++; } );
+  CPPUNIT_ASSERT ( ::write(fd[1], "x", 1) == 1 );
+
+  // A paused watch is not dispatched
+  finalcut::FPoll::waitForInput(-1, 0);
+  CPPUNIT_ASSERT ( calls == 0 );
+
+  CPPUNIT_ASSERT ( finalcut::FPoll::setWatchEvents(fd[0], finalcut::FPoll::readable) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::setWatchEvents(fd[1], finalcut::FPoll::readable) );
+  finalcut::FPoll::waitForInput(-1, 0);
+  CPPUNIT_ASSERT ( calls == 1 );
+
+  // Only the requested events are reported
+  CPPUNIT_ASSERT ( finalcut::FPoll::setWatchEvents(fd[0], finalcut::FPoll::writable) );
+  finalcut::FPoll::waitForInput(-1, 0);
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::isWatched(fd[0]) );
+}
+
+//----------------------------------------------------------------------
+void FPollTest::closedFileDescriptorTest()
+{
+  int calls{0};
+  finalcut::FPoll::addWatch ( fd[0], finalcut::FPoll::readable
+                            , [&calls] (int, int) { calls++; } );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 1 );
+
+  // A watch on a closed file descriptor is removed
+  ::close(fd[0]);
+  finalcut::FPoll::waitForInput(-1, 0);
+  CPPUNIT_ASSERT ( calls == 0 );
+  CPPUNIT_ASSERT ( finalcut::FPoll::getWatchCount() == 0 );
+  fd[0] = -1;
+}
+
+//----------------------------------------------------------------------
+void FPollTest::wakeUpTest()
+{
+  timeval start{};
+  gettimeofday (&start, nullptr);
+
+  // A pending wake-up ends the next wait immediately
+  finalcut::FPoll::wakeUp();
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], finalcut::FPoll::NO_TIMEOUT) );
+  CPPUNIT_ASSERT ( test::elapsedMilliseconds(start) < 1000 );
+
+  // Multiple wake-ups are consumed by one wait
+  finalcut::FPoll::wakeUp();
+  finalcut::FPoll::wakeUp();
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], finalcut::FPoll::NO_TIMEOUT) );
+  gettimeofday (&start, nullptr);
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForInput(fd[0], 20000) );
+  CPPUNIT_ASSERT ( test::elapsedMilliseconds(start) >= 15 );
+
+  // Without the self-pipe, wakeUp() does nothing
+  finalcut::FPoll::finish();
+  finalcut::FPoll::wakeUp();
+}
+
+//----------------------------------------------------------------------
+void FPollTest::outputTest()
+{
+  const auto fsys = finalcut::FTerm::getFSystem();
+  CPPUNIT_ASSERT ( finalcut::FPoll::waitForOutput(fsys, fd[1], 0) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForOutput(nullptr, fd[1], 0) );
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForOutput(fsys, -1, 0) );
+
+  // A full pipe cannot take more data until the timeout
+  const int flags = ::fcntl(fd[1], F_GETFL);
+  CPPUNIT_ASSERT ( ::fcntl(fd[1], F_SETFL, flags | O_NONBLOCK) == 0 );
+  const char buffer[4096]{};
+
+  while ( ::write(fd[1], buffer, sizeof(buffer)) > 0 );
+
+  timeval start{};
+  gettimeofday (&start, nullptr);
+  CPPUNIT_ASSERT ( ! finalcut::FPoll::waitForOutput(fsys, fd[1], 20000) );
+  CPPUNIT_ASSERT ( test::elapsedMilliseconds(start) >= 15 );
+
+  // The headless terminal is always writable
+  finalcut::FSystemHeadless headless{};
+  CPPUNIT_ASSERT ( finalcut::FPoll::waitForOutput(&headless, fd[1], 0) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FPollTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,336 @@
+/***********************************************************************
+* fpostqueue-test.cpp - FPostQueue unit tests                          *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+#include "headless-application.inc"
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+// class FObject_userEvent
+//----------------------------------------------------------------------
+
+class FObject_userEvent : public finalcut::FObject
+{
+  public:
+    explicit FObject_userEvent (finalcut::FObject* parent = nullptr)
+      : finalcut::FObject{parent}
+    { }
+
+    // Data member
+    std::vector<int> ids{};
+
+  protected:
+    void onUserEvent (finalcut::FUserEvent* ev) override
+    {
+      ids.push_back(ev->getUserId());
+    }
+};
+
+//----------------------------------------------------------------------
+std::unique_ptr<finalcut::FEvent> makeUserEvent (int id)
+{
+  return std::unique_ptr<finalcut::FEvent>
+      (new finalcut::FUserEvent(finalcut::fc::User_Event, id));
+}
+
+//----------------------------------------------------------------------
+int getUserId (const finalcut::FPostQueue::FPostItem& item)
+{
+  return static_cast<finalcut::FUserEvent*>(item.event.get())->getUserId();
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FPostQueueTest
+//----------------------------------------------------------------------
+
+class FPostQueueTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FPostQueueTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void orderTest();
+    void removeReceiverTest();
+    void multiThreadTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FPostQueueTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (orderTest);
+    CPPUNIT_TEST (removeReceiverTest);
+    CPPUNIT_TEST (multiThreadTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FPostQueueTest::classNameTest()
+{
+  const finalcut::FPostQueue q;
+  const finalcut::FString& classname = q.getClassName();
+  CPPUNIT_ASSERT ( classname == "FPostQueue" );
+}
+
+//----------------------------------------------------------------------
+void FPostQueueTest::noArgumentTest()
+{
+  finalcut::FPostQueue q;
+  finalcut::FPostQueue::FPostItem item{};
+  CPPUNIT_ASSERT ( q.isEmpty() );
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(nullptr) );
+  CPPUNIT_ASSERT ( item.receiver == nullptr );
+  CPPUNIT_ASSERT ( ! item.event );
+  CPPUNIT_ASSERT ( ! item.task );
+
+  // The destructor releases items that were not popped
+  q.push (nullptr, test::makeUserEvent(1));
+  q.push ([] () { });
+  CPPUNIT_ASSERT ( ! q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FPostQueueTest::orderTest()
+{
+  finalcut::FPostQueue q;
+  test::FObject_userEvent receiver;
+  finalcut::FPostQueue::FPostItem item{};
+  int value{0};
+
+  // Events and tasks come out in the order they were pushed
+  q.push (&receiver, test::makeUserEvent(1));
+  q.push ([&value] () { value = 2; });
+  q.push (&receiver, test::makeUserEvent(3));
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == &receiver );
+  CPPUNIT_ASSERT ( item.event->type() == finalcut::fc::User_Event );
+  CPPUNIT_ASSERT ( test::getUserId(item) == 1 );
+  CPPUNIT_ASSERT ( ! item.task );
+
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == nullptr );
+  CPPUNIT_ASSERT ( ! item.event );
+  CPPUNIT_ASSERT ( item.task );
+  item.task();
+  CPPUNIT_ASSERT ( value == 2 );
+
+  CPPUNIT_ASSERT ( ! q.isEmpty() );
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( test::getUserId(item) == 3 );
+  CPPUNIT_ASSERT ( q.isEmpty() );
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+
+  // The queue can be refilled after it was emptied
+  for (int i{10}; i < 15; i++)
+    q.push (&receiver, test::makeUserEvent(i));
+
+  for (int i{10}; i < 15; i++)
+  {
+    CPPUNIT_ASSERT ( q.pop(item) );
+    CPPUNIT_ASSERT ( test::getUserId(item) == i );
+  }
+
+  CPPUNIT_ASSERT ( q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FPostQueueTest::removeReceiverTest()
+{
+  finalcut::FPostQueue q;
+  test::FObject_userEvent receiver1;
+  test::FObject_userEvent receiver2;
+  finalcut::FPostQueue::FPostItem item{};
+
+  q.push (&receiver1, test::makeUserEvent(1));
+  q.push (&receiver2, test::makeUserEvent(2));
+  q.push ([] () { });
+  q.push (&receiver1, test::makeUserEvent(3));
+  CPPUNIT_ASSERT ( q.removeReceiver(&receiver1) );
+  CPPUNIT_ASSERT ( ! q.removeReceiver(&receiver1) );
+
+  // The removed events leave empty items behind
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == nullptr );
+  CPPUNIT_ASSERT ( ! item.event );
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.receiver == &receiver2 );
+  CPPUNIT_ASSERT ( test::getUserId(item) == 2 );
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( item.task );
+  CPPUNIT_ASSERT ( q.pop(item) );
+  CPPUNIT_ASSERT ( ! item.event );
+  CPPUNIT_ASSERT ( q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FPostQueueTest::multiThreadTest()
+{
+  constexpr int producer_count{4};
+  constexpr int items_per_producer{20000};
+  finalcut::FPostQueue q;
+  test::FObject_userEvent receiver;
+  std::vector<std::thread> producers{};
+
+  for (int p{0}; p < producer_count; p++)
+  {
+    producers.emplace_back ( [&q, &receiver, p] ()
+                             {
+                               for (int i{0}; i < items_per_producer; i++)
+                                 q.push ( &receiver
+                                        , test::makeUserEvent(p * items_per_producer + i) );
+                             } );
+  }
+
+  // Pops while the producers are still pushing
+  std::vector<int> last(producer_count, -1);
+  finalcut::FPostQueue::FPostItem item{};
+  int count{0};
+  bool in_order{true};
+  const auto start = std::chrono::steady_clock::now();
+
+  while ( count < producer_count * items_per_producer
+       && std::chrono::steady_clock::now() - start < std::chrono::seconds(30) )
+  {
+    if ( ! q.pop(item) )
+    {
+      std::this_thread::yield();
+      continue;
+    }
+
+    const int id = test::getUserId(item);
+    const int p = id / items_per_producer;
+
+    // Items of one producer keep their order
+    if ( id <= last[std::size_t(p)] )
+      in_order = false;
+
+    last[std::size_t(p)] = id;
+    count++;
+  }
+
+  for (auto&& producer : producers)
+    producer.join();
+
+  CPPUNIT_ASSERT ( in_order );
+  CPPUNIT_ASSERT ( count == producer_count * items_per_producer );
+  CPPUNIT_ASSERT ( ! q.pop(item) );
+  CPPUNIT_ASSERT ( q.isEmpty() );
+}
+
+//----------------------------------------------------------------------
+void FPostQueueTest::applicationTest()
+{
+  std::unique_ptr<test::FHeadlessApplication> app{new test::FHeadlessApplication};
+  auto receiver = new test::FObject_userEvent(app.get());
+  auto removed = new test::FObject_userEvent(app.get());
+  std::thread::id task_thread{};
+
+  // Nothing can be posted without a receiver, an event or a task
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::postEvent(nullptr, test::makeUserEvent(0)) );
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::postEvent(receiver, nullptr) );
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::postTask(nullptr) );
+
+  // Events for a destroyed receiver are discarded
+  CPPUNIT_ASSERT ( finalcut::FApplication::postEvent(removed, test::makeUserEvent(9)) );
+  CPPUNIT_ASSERT ( finalcut::FApplication::removeQueuedEvent(removed) );
+
+  std::thread worker ( [receiver, &task_thread] ()
+                       {
+                         std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                         finalcut::FApplication::postEvent (receiver, test::makeUserEvent(1));
+                         finalcut::FApplication::postEvent (receiver, test::makeUserEvent(2));
+                         finalcut::FApplication::postTask
+                         (
+                           [receiver, &task_thread] ()
+                           {
+                             task_thread = std::this_thread::get_id();
+                             receiver->ids.push_back(3);
+                             finalcut::FApplication::getApplicationObject()->quit();
+                           }
+                         );
+                       } );
+
+  // The event loop delivers the posted items in order
+  app->exec();
+  worker.join();
+
+  CPPUNIT_ASSERT ( task_thread == std::this_thread::get_id() );
+  CPPUNIT_ASSERT ( receiver->ids.size() == 3 );
+  CPPUNIT_ASSERT ( receiver->ids[0] == 1 );
+  CPPUNIT_ASSERT ( receiver->ids[1] == 2 );
+  CPPUNIT_ASSERT ( receiver->ids[2] == 3 );
+  CPPUNIT_ASSERT ( removed->ids.empty() );
+
+  // The shutdown rejects the posts of a thread that is still running
+  std::atomic<bool> rejected{false};
+  std::thread poster ( [&rejected] ()
+                       {
+                         while ( finalcut::FApplication::postTask([] () { }) )
+                           std::this_thread::yield();
+
+                         rejected = true;
+                       } );
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  app.reset();
+  poster.join();
+  CPPUNIT_ASSERT ( rejected );
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::postTask([] () { }) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FPostQueueTest);
+
+// The general unit test main part
+#include <main-test.inc>
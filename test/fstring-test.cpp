@@ -477,6 +477,19 @@ void FStringTest::additionAssignmentTest()
   CPPUNIT_ASSERT ( s1 == L"a" );
   s1 += char('b');
   CPPUNIT_ASSERT ( s1 == L"ab" );
+
+  // A null character is not appended
+  s1 += wchar_t(L'\0');
+  s1 += char('\0');
+  CPPUNIT_ASSERT ( s1 == L"ab" );
+  CPPUNIT_ASSERT ( s1.getLength() == 2 );
+
+  // A char above 0x7f is not sign-extended
+  s1.clear();
+  s1 += char('\xe4');
+  CPPUNIT_ASSERT ( s1.getLength() == 1 );
+  CPPUNIT_ASSERT ( s1[0] == wchar_t(0xe4) );
+  CPPUNIT_ASSERT ( s1 == finalcut::FString(char('\xe4')) );
 }
 
 //----------------------------------------------------------------------
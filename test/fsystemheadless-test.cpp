@@ -0,0 +1,319 @@
+/***********************************************************************
+* fsystemheadless-test.cpp - FSystemHeadless unit tests                *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/ioctl.h>
+#include <termios.h>
+
+#include <cstring>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// functions
+//----------------------------------------------------------------------
+void print (finalcut::FSystem& fsys, const std::string& str)
+{
+  fsys.write (1, str.data(), str.length());
+}
+
+//----------------------------------------------------------------------
+// class FSystemHeadlessTest
+//----------------------------------------------------------------------
+
+class FSystemHeadlessTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FSystemHeadlessTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void sizeTest();
+    void outputTest();
+    void cursorMoveTest();
+    void eraseTest();
+    void editTest();
+    void scrollTest();
+    void utf8Test();
+    void tputsTest();
+    void termiosTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FSystemHeadlessTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (sizeTest);
+    CPPUNIT_TEST (outputTest);
+    CPPUNIT_TEST (cursorMoveTest);
+    CPPUNIT_TEST (eraseTest);
+    CPPUNIT_TEST (editTest);
+    CPPUNIT_TEST (scrollTest);
+    CPPUNIT_TEST (utf8Test);
+    CPPUNIT_TEST (tputsTest);
+    CPPUNIT_TEST (termiosTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::classNameTest()
+{
+  const finalcut::FSystemHeadless fsys{};
+  const finalcut::FString& classname = fsys.getClassName();
+  CPPUNIT_ASSERT ( classname == "FSystemHeadless" );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::sizeTest()
+{
+  finalcut::FSystemHeadless fsys(100, 30, "xterm");
+  CPPUNIT_ASSERT ( fsys.getWidth() == 100 );
+  CPPUNIT_ASSERT ( fsys.getHeight() == 30 );
+  CPPUNIT_ASSERT ( std::strcmp(std::getenv("TERM"), "xterm") == 0 );
+  CPPUNIT_ASSERT ( fsys.isTTY(0) == 1 );
+
+  struct winsize win_size{};
+  CPPUNIT_ASSERT ( fsys.ioctl(1, TIOCGWINSZ, &win_size) == 0 );
+  CPPUNIT_ASSERT ( win_size.ws_col == 100 );
+  CPPUNIT_ASSERT ( win_size.ws_row == 30 );
+
+  fsys.setSize (40, 10);
+  CPPUNIT_ASSERT ( fsys.ioctl(1, TIOCGWINSZ, &win_size) == 0 );
+  CPPUNIT_ASSERT ( win_size.ws_col == 40 );
+  CPPUNIT_ASSERT ( win_size.ws_row == 10 );
+  CPPUNIT_ASSERT ( fsys.getLine(9).getLength() == 40 );
+  CPPUNIT_ASSERT ( fsys.getLine(10).isEmpty() );
+
+  // There are no devices
+  CPPUNIT_ASSERT ( fsys.open("/dev/tty0", 0) == -1 );
+  CPPUNIT_ASSERT ( fsys.fopen("/dev/tty0", "r") == nullptr );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::outputTest()
+{
+  finalcut::FSystemHeadless fsys(10, 3);
+  print (fsys, "Hello\r\nWorld");
+  fsys.putchar('!');
+  CPPUNIT_ASSERT ( fsys.getOutput() == "Hello\r\nWorld!" );
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "Hello     " );
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "World!    " );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(6, 1) );
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(4, 0)) == L'o' );
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(10, 0)) == L'\0' );
+
+  fsys.clearOutput();
+  CPPUNIT_ASSERT ( fsys.getOutput().empty() );
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "Hello     " );
+
+  // Automatic margin
+  print (fsys, "\r\n0123456789");
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "0123456789" );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(9, 2) );
+  print (fsys, "ab");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "World!    " );
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "0123456789" );
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "ab        " );
+
+  // Attributes, modes and strings do not change the content
+  print (fsys, "\033[1;31m\033[?25l\033]0;title\007\033(B\033[0m");
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "ab        " );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(2, 2) );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::cursorMoveTest()
+{
+  finalcut::FSystemHeadless fsys(20, 10);
+  print (fsys, "\033[5;8H");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(7, 4) );
+  print (fsys, "\033[2A");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(7, 2) );
+  print (fsys, "\033[B");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(7, 3) );
+  print (fsys, "\033[3C");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(10, 3) );
+  print (fsys, "\033[4D");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(6, 3) );
+  print (fsys, "\033[15G");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(14, 3) );
+  print (fsys, "\033[9d");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(14, 8) );
+  print (fsys, "\033[H");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(0, 0) );
+
+  // The cursor stays on the screen
+  print (fsys, "\033[99;99H");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(19, 9) );
+  print (fsys, "\033[50A\033[50D");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(0, 0) );
+
+  // Save and restore
+  print (fsys, "\033[3;4H\0337\033[H\0338");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(3, 2) );
+
+  // Tabulator and backspace
+  print (fsys, "\r\t");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(8, 2) );
+  print (fsys, "\b\b");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(6, 2) );
+  print (fsys, "\033[I");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(8, 2) );
+  print (fsys, "\033[2I");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(19, 2) );
+  print (fsys, "\033[Z");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(16, 2) );
+  print (fsys, "\033[D\033[Z");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(8, 2) );
+  print (fsys, "\033[5Z");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(0, 2) );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::eraseTest()
+{
+  finalcut::FSystemHeadless fsys(6, 3);
+  print (fsys, "abcdef\r\nghijkl\r\nmnopqr");
+  print (fsys, "\033[2;3H\033[K");
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "gh    " );
+  print (fsys, "\033[1K");
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "      " );
+  print (fsys, "\033[1;2H\033[2X");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "a  def" );
+  print (fsys, "\033[J");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "a     " );
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "      " );
+  print (fsys, "\033[3;1Hxyz\033[2J");
+
+  for (int y{0}; y < 3; y++)
+    CPPUNIT_ASSERT ( fsys.getLine(y) == "      " );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::editTest()
+{
+  finalcut::FSystemHeadless fsys(8, 2);
+  print (fsys, "abcdefgh\033[1;3H\033[2@");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "ab  cdef" );
+  print (fsys, "\033[3P");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "abdef   " );
+
+  // Repeat the preceding character
+  print (fsys, "\033[2;1H-\033[4b");
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "-----   " );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(5, 1) );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::scrollTest()
+{
+  finalcut::FSystemHeadless fsys(4, 4);
+  print (fsys, "1111\r\n2222\r\n3333\r\n4444");
+
+  // Line feed at the bottom margin
+  print (fsys, "\n");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "2222" );
+  CPPUNIT_ASSERT ( fsys.getLine(3) == "    " );
+
+  // Scrolling region
+  print (fsys, "\033[2;3r");
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(0, 0) );
+  print (fsys, "\033[3;1H\n");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "2222" );
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "4444" );
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "    " );
+  CPPUNIT_ASSERT ( fsys.getLine(3) == "    " );
+  print (fsys, "\033[2;1H\033M");
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "    " );
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "4444" );
+
+  // Insert and delete lines
+  print (fsys, "\033[r\033[1;1H\033[L");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "    " );
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "2222" );
+  CPPUNIT_ASSERT ( fsys.getLine(3) == "4444" );
+  print (fsys, "\033[2M");
+  CPPUNIT_ASSERT ( fsys.getLine(0) == "    " );
+  CPPUNIT_ASSERT ( fsys.getLine(1) == "4444" );
+  CPPUNIT_ASSERT ( fsys.getLine(2) == "    " );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::utf8Test()
+{
+  finalcut::FSystemHeadless fsys(10, 2);
+  print (fsys, "\xc3\xa4\xe2\x82\xac\xe2\x94\x80");  // ä€─
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(0, 0)) == L'ä' );
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(1, 0)) == L'€' );
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(2, 0)) == L'─' );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(3, 0) );
+
+  // An incomplete sequence is dropped
+  print (fsys, "\xe2\x82" "a");
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(3, 0)) == L'a' );
+  CPPUNIT_ASSERT ( fsys.getCursorPos() == finalcut::FPoint(4, 0) );
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::tputsTest()
+{
+  finalcut::FSystemHeadless fsys(10, 2);
+  finalcut::FTerm::setFSystem(&fsys);  // putchar() writes to fsys
+  CPPUNIT_ASSERT ( fsys.tputs(nullptr, 1, finalcut::FTerm::putchar_ASCII) == -1 );
+  CPPUNIT_ASSERT ( fsys.tputs("\033[2;5H$<5>x", 1, finalcut::FTerm::putchar_ASCII) == 0 );
+  CPPUNIT_ASSERT ( fsys.getOutput() == "\033[2;5Hx" );
+  CPPUNIT_ASSERT ( fsys.getCharacter(finalcut::FPoint(4, 1)) == L'x' );
+  finalcut::FTerm::setFSystem(nullptr);
+}
+
+//----------------------------------------------------------------------
+void FSystemHeadlessTest::termiosTest()
+{
+  finalcut::FSystemHeadless fsys{};
+  struct termios t{};
+  CPPUNIT_ASSERT ( fsys.tcgetattr(0, &t) == 0 );
+  CPPUNIT_ASSERT ( cfgetospeed(&t) == B38400 );
+  t.c_lflag = ICANON | ECHO;
+  CPPUNIT_ASSERT ( fsys.tcsetattr(0, TCSAFLUSH, &t) == 0 );
+
+  struct termios t2{};
+  CPPUNIT_ASSERT ( fsys.tcgetattr(0, &t2) == 0 );
+  CPPUNIT_ASSERT ( t2.c_lflag == (ICANON | ECHO) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FSystemHeadlessTest);
+
+// The general unit test main part
+#include <main-test.inc>
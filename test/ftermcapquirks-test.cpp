@@ -75,6 +75,8 @@ static tcap_map tcap[] =
   { 0, "ip" },  // insert_padding
   { 0, "ic" },  // insert_character
   { 0, "IC" },  // parm_ich
+  { 0, "dc" },  // delete_character
+  { 0, "DC" },  // parm_dch
   { 0, "rp" },  // repeat_char
   { 0, "Ic" },  // initialize_color
   { 0, "Ip" },  // initialize_pair
@@ -105,6 +107,13 @@ static tcap_map tcap[] =
   { 0, "Ss" },  // set cursor style
   { 0, "sf" },  // scroll_forward
   { 0, "sr" },  // scroll_reverse
+  { 0, "SF" },  // parm_index
+  { 0, "SR" },  // parm_rindex
+  { 0, "cs" },  // change_scroll_region
+  { 0, "al" },  // insert_line
+  { 0, "dl" },  // delete_line
+  { 0, "AL" },  // parm_insert_line
+  { 0, "DL" },  // parm_delete_line
   { 0, "ti" },  // enter_ca_mode
   { 0, "te" },  // exit_ca_mode
   { 0, "eA" },  // enable_acs
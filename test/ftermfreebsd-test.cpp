@@ -61,6 +61,7 @@ class FSystemTest : public finalcut::FSystem
     FILE*            fopen (const char*, const char*) override;
     int              fclose (FILE*) override;
     int              putchar (int) override;
+    ssize_t          write (int, const void*, std::size_t) override;
     int              tputs (const char*, int, int (*)(int)) override;
     uid_t            getuid() override;
     uid_t            geteuid() override;
@@ -523,6 +524,12 @@ int FSystemTest::putchar (int c)
   return 1;
 }
 
+//----------------------------------------------------------------------
+ssize_t FSystemTest::write (int fd, const void* buf, std::size_t count)
+{
+  return ::write (fd, buf, count);
+}
+
 //----------------------------------------------------------------------
 int FSystemTest::tputs (const char* str, int affcnt, int (*putc)(int))
 {
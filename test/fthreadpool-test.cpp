@@ -0,0 +1,306 @@
+/***********************************************************************
+* fthreadpool-test.cpp - FThreadPool unit tests                        *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+#include "headless-application.inc"
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+bool waitForJobs (finalcut::FThreadPool& pool)
+{
+  // Waits up to 10 seconds until all jobs are finished
+
+  const auto start = std::chrono::steady_clock::now();
+
+  while ( pool.getJobCount() > 0 )
+  {
+    if ( std::chrono::steady_clock::now() - start > std::chrono::seconds(10) )
+      return false;
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  return true;
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FThreadPoolTest
+//----------------------------------------------------------------------
+
+class FThreadPoolTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FThreadPoolTest()
+    { }
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void runTest();
+    void stealTest();
+    void cancelTest();
+    void applicationTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FThreadPoolTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (runTest);
+    CPPUNIT_TEST (stealTest);
+    CPPUNIT_TEST (cancelTest);
+    CPPUNIT_TEST (applicationTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::classNameTest()
+{
+  const finalcut::FThreadPool pool{1};
+  const finalcut::FString& classname = pool.getClassName();
+  CPPUNIT_ASSERT ( classname == "FThreadPool" );
+}
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::noArgumentTest()
+{
+  finalcut::FThreadPool pool;
+  CPPUNIT_ASSERT ( pool.getThreadCount() >= 1 );
+  CPPUNIT_ASSERT ( pool.getThreadCount() <= 4 );
+  CPPUNIT_ASSERT ( pool.getJobCount() == 0 );
+  CPPUNIT_ASSERT ( ! pool.submit(nullptr, nullptr) );
+  CPPUNIT_ASSERT ( ! pool.cancel(nullptr) );
+  CPPUNIT_ASSERT ( ! finalcut::FThreadPool::isCanceled() );
+
+  finalcut::FThreadPool pool3{3};
+  CPPUNIT_ASSERT ( pool3.getThreadCount() == 3 );
+}
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::runTest()
+{
+  finalcut::FThreadPool pool{3};
+  std::atomic<int> count{0};
+  std::mutex mutex{};
+  std::set<std::thread::id> threads{};
+
+  for (int i{0}; i < 300; i++)
+  {
+    CPPUNIT_ASSERT ( pool.submit ( nullptr
+                                 , [&] ()
+                                   {
+                                     count++;
+                                     std::lock_guard<std::mutex> lock(mutex);
+                                     threads.insert(std::this_thread::get_id());
+                                   } ) );
+  }
+
+  CPPUNIT_ASSERT ( test::waitForJobs(pool) );
+  CPPUNIT_ASSERT ( count == 300 );
+
+  // The jobs did not run in the calling thread
+  CPPUNIT_ASSERT ( threads.count(std::this_thread::get_id()) == 0 );
+  CPPUNIT_ASSERT ( threads.size() <= 3 );
+}
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::stealTest()
+{
+  finalcut::FThreadPool pool{4};
+  std::atomic<int> count{0};
+  std::mutex mutex{};
+  std::set<std::thread::id> threads{};
+
+  // A job queues its sub-jobs in its own worker queue,
+  // from which the idle workers steal
+  pool.submit ( nullptr
+              , [&] ()
+                {
+                  for (int i{0}; i < 40; i++)
+                  {
+                    pool.submit ( nullptr
+                                , [&] ()
+                                  {
+                                    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                    count++;
+                                    std::lock_guard<std::mutex> lock(mutex);
+                                    threads.insert(std::this_thread::get_id());
+                                  } );
+                  }
+                } );
+
+  CPPUNIT_ASSERT ( test::waitForJobs(pool) );
+  CPPUNIT_ASSERT ( count == 40 );
+  CPPUNIT_ASSERT ( threads.size() > 1 );
+}
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::cancelTest()
+{
+  finalcut::FThreadPool pool{1};
+  finalcut::FObject owner1;
+  finalcut::FObject owner2;
+  std::atomic<bool> started{false};
+  std::atomic<bool> stopped{false};
+  std::atomic<bool> queued_job_run{false};
+  std::atomic<bool> other_job_run{false};
+
+  // Runs until it is canceled
+  pool.submit ( &owner1
+              , [&] ()
+                {
+                  started = true;
+                  const auto start = std::chrono::steady_clock::now();
+
+                  while ( ! finalcut::FThreadPool::isCanceled()
+                       && std::chrono::steady_clock::now() - start < std::chrono::seconds(10) )
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                  stopped = finalcut::FThreadPool::isCanceled();
+                } );
+
+  // Wait for the single worker
+  pool.submit (&owner1, [&] () { queued_job_run = true; });
+  pool.submit (&owner2, [&] () { other_job_run = true; });
+
+  while ( ! started )
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+  CPPUNIT_ASSERT ( pool.getJobCount() == 3 );
+  CPPUNIT_ASSERT ( pool.cancel(&owner1) );
+
+  // cancel() returns after the running job of owner1 has stopped
+  CPPUNIT_ASSERT ( stopped );
+  CPPUNIT_ASSERT ( ! pool.cancel(&owner1) );
+  CPPUNIT_ASSERT ( pool.getJobCount() <= 1 );  // The job of owner2
+  CPPUNIT_ASSERT ( test::waitForJobs(pool) );
+
+  // The running job saw the cancellation, the queued one did not run
+  CPPUNIT_ASSERT ( stopped );
+  CPPUNIT_ASSERT ( ! queued_job_run );
+  CPPUNIT_ASSERT ( other_job_run );
+
+  // The destructor cancels the remaining jobs
+  started = stopped = false;
+  {
+    finalcut::FThreadPool pool2{2};
+    pool2.submit ( &owner2
+                 , [&] ()
+                   {
+                     started = true;
+
+                     while ( ! finalcut::FThreadPool::isCanceled() )
+                       std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                     stopped = true;
+                   } );
+
+    while ( ! started )
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  CPPUNIT_ASSERT ( stopped );
+}
+
+//----------------------------------------------------------------------
+void FThreadPoolTest::applicationTest()
+{
+  CPPUNIT_ASSERT ( finalcut::FApplication::getThreadPool() == nullptr );
+
+  test::FHeadlessApplication app;
+  auto pool = finalcut::FApplication::getThreadPool();
+  CPPUNIT_ASSERT ( pool != nullptr );
+  CPPUNIT_ASSERT ( finalcut::FApplication::getThreadPool() == pool );
+
+  auto widget = new finalcut::FWidget(&app);
+  auto destroyed_widget = new finalcut::FWidget(&app);
+  std::thread::id work_thread{};
+  std::thread::id done_thread{};
+  long result{0};
+  bool destroyed_widget_done{false};
+
+  // The done function of a destroyed widget is not called
+  pool->submit ( destroyed_widget
+               , [] ()
+                 {
+                   std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                 }
+               , [&destroyed_widget_done] ()
+                 {
+                   destroyed_widget_done = true;
+                 } );
+  delete destroyed_widget;
+
+  pool->submit ( widget
+               , [&] ()
+                 {
+                   std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                   work_thread = std::this_thread::get_id();
+
+                   for (long i{1}; i <= 1000; i++)
+                     result += i;
+                 }
+               , [&] ()
+                 {
+                   done_thread = std::this_thread::get_id();
+                   finalcut::FApplication::getApplicationObject()->quit();
+                 } );
+
+  app.exec();
+
+  CPPUNIT_ASSERT ( result == 500500 );
+  CPPUNIT_ASSERT ( work_thread != std::this_thread::get_id() );
+  CPPUNIT_ASSERT ( done_thread == std::this_thread::get_id() );
+  CPPUNIT_ASSERT ( ! destroyed_widget_done );
+  CPPUNIT_ASSERT ( pool->getJobCount() == 0 );
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::cancelBackgroundJobs(widget) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FThreadPoolTest);
+
+// The general unit test main part
+#include <main-test.inc>
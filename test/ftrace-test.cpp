@@ -0,0 +1,274 @@
+/***********************************************************************
+* ftrace-test.cpp - FTrace unit tests                                  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <unistd.h>
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+// Counts the SIGUSR1 signals of the application handler
+volatile std::sig_atomic_t application_signals{0};
+
+//----------------------------------------------------------------------
+void applicationHandler (int)
+{
+  application_signals++;
+}
+
+//----------------------------------------------------------------------
+std::string readFile (const finalcut::FString& filename)
+{
+  std::ifstream file(filename.c_str());
+  std::stringstream content{};
+  content << file.rdbuf();
+  return content.str();
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FTraceTest
+//----------------------------------------------------------------------
+
+class FTraceTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTraceTest()
+    { }
+
+    void setUp();
+    void tearDown();
+
+  protected:
+    void classNameTest();
+    void disabledTest();
+    void spanTest();
+    void ringTest();
+    void dumpTest();
+    void signalTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTraceTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (disabledTest);
+    CPPUNIT_TEST (spanTest);
+    CPPUNIT_TEST (ringTest);
+    CPPUNIT_TEST (dumpTest);
+    CPPUNIT_TEST (signalTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data members
+    finalcut::FString trace_file{};
+};
+
+//----------------------------------------------------------------------
+void FTraceTest::setUp()
+{
+  char name[] = "/tmp/ftrace-test-XXXXXX";
+  const int fd = mkstemp(name);
+
+  if ( fd >= 0 )
+    close(fd);
+
+  trace_file = name;
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::tearDown()
+{
+  finalcut::FTrace::stop();
+  unlink(trace_file.c_str());
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::classNameTest()
+{
+  const finalcut::FTrace trace{};
+  const finalcut::FString& classname = trace.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTrace" );
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::disabledTest()
+{
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::isEnabled() );
+
+  {
+    finalcut::FTraceScope span("idle", "test");
+  }
+
+  CPPUNIT_ASSERT ( finalcut::FTrace::getEventCount() == 0 );
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::dump() );
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::spanTest()
+{
+  finalcut::FTrace::start (trace_file, 16);
+  CPPUNIT_ASSERT ( finalcut::FTrace::isEnabled() );
+  CPPUNIT_ASSERT ( finalcut::FTrace::getFileName() == trace_file );
+
+  {
+    finalcut::FTraceScope outer("outer", "test");
+
+    {
+      finalcut::FTraceScope inner("inner", "test");
+    }
+
+    CPPUNIT_ASSERT ( finalcut::FTrace::getEventCount() == 1 );
+  }
+
+  CPPUNIT_ASSERT ( finalcut::FTrace::getEventCount() == 2 );
+
+  // A span that is still open when tracing stops is dropped
+  {
+    finalcut::FTraceScope span("open", "test");
+    finalcut::FTrace::stop();
+  }
+
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::isEnabled() );
+  CPPUNIT_ASSERT ( finalcut::FTrace::getEventCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::ringTest()
+{
+  finalcut::FTrace::start (trace_file, 4);
+
+  for (uInt64 i{0}; i < 6; i++)
+  {
+    const std::string name = "span" + std::to_string(i);
+    finalcut::FTrace::addEvent (name.c_str(), "test", nullptr, i, i + 1);
+  }
+
+  // The oldest spans were overwritten
+  CPPUNIT_ASSERT ( finalcut::FTrace::getEventCount() == 4 );
+  CPPUNIT_ASSERT ( finalcut::FTrace::dump() );
+  const std::string json = test::readFile(trace_file);
+  CPPUNIT_ASSERT ( json.find("\"span0\"") == std::string::npos );
+  CPPUNIT_ASSERT ( json.find("\"span1\"") == std::string::npos );
+  const auto pos2 = json.find("\"span2\"");
+  const auto pos5 = json.find("\"span5\"");
+  CPPUNIT_ASSERT ( pos2 != std::string::npos );
+  CPPUNIT_ASSERT ( pos5 != std::string::npos );
+  CPPUNIT_ASSERT ( pos2 < pos5 );
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::dumpTest()
+{
+  finalcut::FTrace::start (trace_file, 16);
+  const uInt64 start = finalcut::FTrace::getTimeStamp();
+  finalcut::FTrace::addEvent ( "draw \"x\"", "draw", nullptr
+                             , start + 1500, start + 4250 );
+  const finalcut::FObject object{};
+
+  {
+    finalcut::FTraceScope span(&object, "timer");
+  }
+
+  CPPUNIT_ASSERT ( finalcut::FTrace::dump() );
+  const std::string json = test::readFile(trace_file);
+  const std::string pid = std::to_string(getpid());
+  CPPUNIT_ASSERT ( json.find("{\"traceEvents\":[\n") == 0 );
+  CPPUNIT_ASSERT ( json.find("\"ph\":\"M\",\"pid\":" + pid) != std::string::npos );
+  CPPUNIT_ASSERT ( json.find("\"name\":\"draw \\\"x\\\"\",\"cat\":\"draw\""
+                             ",\"ph\":\"X\"") != std::string::npos );
+  CPPUNIT_ASSERT ( json.find(",\"dur\":2.750}") != std::string::npos );
+  CPPUNIT_ASSERT ( json.find("\"name\":\"FObject\",\"cat\":\"timer\"")
+                   != std::string::npos );
+  char object_str[32]{};
+  std::snprintf (object_str, sizeof(object_str), "%p", &object);
+  CPPUNIT_ASSERT ( json.find("\"args\":{\"object\":\"" + std::string(object_str))
+                   != std::string::npos );
+  CPPUNIT_ASSERT ( json.rfind("\n],\"displayTimeUnit\":\"ns\"}\n")
+                   == json.length() - 27 );
+
+  // Control characters and a dump larger than the output buffer
+  finalcut::FTrace::start (trace_file, 256);
+
+  for (uInt64 i{0}; i < 256; i++)
+    finalcut::FTrace::addEvent ("tab\t", "test", nullptr, start, start + i);
+
+  CPPUNIT_ASSERT ( finalcut::FTrace::dump() );
+  const std::string json2 = test::readFile(trace_file);
+  CPPUNIT_ASSERT ( json2.find("\"name\":\"tab\\u0009\"") != std::string::npos );
+  CPPUNIT_ASSERT ( json2.find(",\"dur\":0.255}") != std::string::npos );
+  CPPUNIT_ASSERT ( json2.rfind("\n],\"displayTimeUnit\":\"ns\"}\n")
+                   == json2.length() - 27 );
+}
+
+//----------------------------------------------------------------------
+void FTraceTest::signalTest()
+{
+  finalcut::FTrace::start (trace_file, 16);
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::isDumpRequested() );
+  std::raise (SIGUSR1);
+  CPPUNIT_ASSERT ( finalcut::FTrace::isDumpRequested() );
+  CPPUNIT_ASSERT ( finalcut::FTrace::dump() );
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::isDumpRequested() );
+  CPPUNIT_ASSERT ( ! test::readFile(trace_file).empty() );
+
+  // stop() restores the handler of the application,
+  // even after a restart
+  finalcut::FTrace::stop();
+  std::signal (SIGUSR1, test::applicationHandler);
+  finalcut::FTrace::start (trace_file, 16);
+  finalcut::FTrace::start (trace_file, 16);
+  std::raise (SIGUSR1);
+  CPPUNIT_ASSERT ( finalcut::FTrace::isDumpRequested() );
+  CPPUNIT_ASSERT ( test::application_signals == 0 );
+  finalcut::FTrace::stop();
+  std::raise (SIGUSR1);
+  CPPUNIT_ASSERT ( test::application_signals == 1 );
+  CPPUNIT_ASSERT ( ! finalcut::FTrace::isDumpRequested() );
+  std::signal (SIGUSR1, SIG_DFL);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTraceTest);
+
+// The general unit test main part
+#include <main-test.inc>
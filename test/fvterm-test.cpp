@@ -0,0 +1,1016 @@
+/***********************************************************************
+* fvterm-test.cpp - FVTerm unit tests                                  *
+*                                                                      *
+* This file is part of the Final Cut widget toolkit                    *
+*                                                                      *
+* Copyright 2020 Markus Gans                                           *
+*                                                                      *
+* The Final Cut is free software; you can redistribute it and/or       *
+* modify it under the terms of the GNU Lesser General Public License   *
+* as published by the Free Software Foundation; either version 3 of    *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* The Final Cut is distributed in the hope that it will be useful,     *
+* but WITHOUT ANY WARRANTY; without even the implied warranty of       *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+#include "headless-application.inc"
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+finalcut::FChar getCharacter (wchar_t ch)
+{
+  finalcut::FChar fchar{};
+  fchar.ch = ch;
+  fchar.fg_color = finalcut::fc::Default;
+  fchar.bg_color = finalcut::fc::Default;
+  fchar.attr.bit.printed = true;
+  return fchar;
+}
+
+//----------------------------------------------------------------------
+std::size_t getChangedPos ( const std::vector<finalcut::FChar>& a
+                          , const std::vector<finalcut::FChar>& b
+                          , std::size_t start = 0 )
+{
+  return finalcut::getChangedCharacterPos ( a.data() + start
+                                          , b.data() + start
+                                          , a.size() - start );
+}
+
+//----------------------------------------------------------------------
+std::size_t getUnchangedPos ( const std::vector<finalcut::FChar>& a
+                            , const std::vector<finalcut::FChar>& b
+                            , std::size_t start = 0 )
+{
+  return finalcut::getUnchangedCharacterPos ( a.data() + start
+                                            , b.data() + start
+                                            , a.size() - start );
+}
+
+//----------------------------------------------------------------------
+// class FVTermChanges
+//----------------------------------------------------------------------
+
+class FVTermChanges : public finalcut::FVTerm
+{
+  public:
+    // Make the line change methods accessible
+    using finalcut::FVTerm::addLineChanges;
+    using finalcut::FVTerm::resetLineChanges;
+};
+
+//----------------------------------------------------------------------
+// class FVTermWindowMap
+//----------------------------------------------------------------------
+
+class FVTermWindowMap : public finalcut::FVTerm
+{
+  public:
+    // Make the window map accessible
+    using finalcut::FVTerm::getWindowMapOwner;
+    using finalcut::FVTerm::restoreVTerm;
+};
+
+//----------------------------------------------------------------------
+// class FSystemNonBlocking
+//----------------------------------------------------------------------
+
+class FSystemNonBlocking : public finalcut::FSystemHeadless
+{
+  public:
+    FSystemNonBlocking (std::size_t width, std::size_t height)
+      : finalcut::FSystemHeadless{width, height}
+    { }
+
+    ssize_t write (int fd, const void* buf, std::size_t count) override
+    {
+      // Refuses every second write like a full non-blocking terminal
+      write_calls++;
+
+      if ( refuse_writes && write_calls % 2 == 1 )
+      {
+        errno = EAGAIN;
+        return -1;
+      }
+
+      return finalcut::FSystemHeadless::write(fd, buf, count);
+    }
+
+    int poll (struct pollfd* fds, nfds_t nfds, int timeout) override
+    {
+      poll_calls++;
+      return finalcut::FSystemHeadless::poll(fds, nfds, timeout);
+    }
+
+    // Data members
+    int  poll_calls{0};
+    int  write_calls{0};
+    bool refuse_writes{false};
+};
+
+//----------------------------------------------------------------------
+// class FTermcapRemoval
+//----------------------------------------------------------------------
+
+class FTermcapRemoval
+{
+  public:
+    // Removes a termcap string until the end of the scope
+    explicit FTermcapRemoval (finalcut::fc::termcaps c)
+      : cap{c}
+      , string{finalcut::FTermcap::strings[c].string}
+    {
+      finalcut::FTermcap::strings[cap].string = nullptr;
+    }
+
+    ~FTermcapRemoval()
+    {
+      finalcut::FTermcap::strings[cap].string = string;
+    }
+
+  private:
+    // Data members
+    finalcut::fc::termcaps cap;
+    char*                  string;
+};
+
+//----------------------------------------------------------------------
+FHeadlessApplication& getApplication()
+{
+  // Only one application can exist per test program,
+  // so the tests share it
+  static std::unique_ptr<FHeadlessApplication> app{};
+
+  if ( ! app )
+  {
+    app.reset(new FHeadlessApplication(new FSystemNonBlocking(40, 12)));
+    finalcut::FVTerm::setFrameInterval(0);
+    app->updateTerminal();
+  }
+
+  return *app;
+}
+
+//----------------------------------------------------------------------
+FSystemNonBlocking& getTerminal()
+{
+  return *static_cast<FSystemNonBlocking*>(finalcut::FTerm::getFSystem());
+}
+
+//----------------------------------------------------------------------
+std::string getRowText (int row)
+{
+  return "row " + std::to_string(row) + " ";
+}
+
+//----------------------------------------------------------------------
+std::string getRowFill (int row, std::size_t length)
+{
+  // Alternating characters cannot be sent as a repeated character
+  std::string fill{};
+
+  for (std::size_t i{0}; i < length; i++)
+    fill += char(( i % 2 == 0 ) ? 'a' + row : 'A' + row);
+
+  return fill;
+}
+
+//----------------------------------------------------------------------
+void printRows (finalcut::FDialog& dialog, int first_row)
+{
+  // Prints six lines without common characters into the pane
+
+  for (int i{0}; i < 6; i++)
+  {
+    const int row = first_row + i;
+    const auto text = getRowText(row);
+    dialog.print() << finalcut::FPoint{2, 2 + i}
+                   << text + getRowFill(row, 30 - text.length());
+  }
+}
+
+//----------------------------------------------------------------------
+void fillDialog (finalcut::FDialog& dialog, char ch)
+{
+  // Fills the client area of the dialog with the character ch
+
+  const auto width = dialog.getWidth() - 2;
+
+  for (int y{2}; y < int(dialog.getHeight()); y++)
+    dialog.print() << finalcut::FPoint{2, y} << std::string(width, ch);
+}
+
+//----------------------------------------------------------------------
+finalcut::FVTerm::FTermArea* getOwner (int x, int y)
+{
+  // Returns the topmost window at the 0-based terminal position
+
+  finalcut::FVTerm::FTermArea* owner{nullptr};
+  const bool found = FVTermWindowMap::getWindowMapOwner({x, y}, owner);
+  CPPUNIT_ASSERT ( found );
+  return owner;
+}
+
+//----------------------------------------------------------------------
+bool hasRow (const FSystemNonBlocking& terminal, int line, int row)
+{
+  return terminal.getLine(line).includes(getRowText(row).c_str());
+}
+
+//----------------------------------------------------------------------
+bool hasRowOutput (const std::string& output, int row)
+{
+  // Searches for the fill characters of the row
+  return output.find(getRowFill(row, 10)) != std::string::npos;
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FVTermTest
+//----------------------------------------------------------------------
+
+class FVTermTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FVTermTest()
+    { }
+
+    void setUp();
+    void tearDown();
+
+  protected:
+    void kernelSelectionTest();
+    void noChangesTest();
+    void unprintedTest();
+    void characterChangesTest();
+    void runTest();
+    void kernelComparisonTest();
+    void shiftTest();
+    void lineChangesTest();
+    void lineRangeLimitTest();
+    void statisticsTest();
+    void refusedWriteTest();
+    void scrollAreaTest();
+    void scrollDetectionTest();
+    void scrollFallbackTest();
+    void characterShiftTest();
+    void asyncOutputTest();
+    void windowMapTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FVTermTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelSelectionTest);
+    CPPUNIT_TEST (noChangesTest);
+    CPPUNIT_TEST (unprintedTest);
+    CPPUNIT_TEST (characterChangesTest);
+    CPPUNIT_TEST (runTest);
+    CPPUNIT_TEST (kernelComparisonTest);
+    CPPUNIT_TEST (shiftTest);
+    CPPUNIT_TEST (lineChangesTest);
+    CPPUNIT_TEST (lineRangeLimitTest);
+    CPPUNIT_TEST (statisticsTest);
+    CPPUNIT_TEST (refusedWriteTest);
+    CPPUNIT_TEST (scrollAreaTest);
+    CPPUNIT_TEST (scrollDetectionTest);
+    CPPUNIT_TEST (scrollFallbackTest);
+    CPPUNIT_TEST (characterShiftTest);
+    CPPUNIT_TEST (asyncOutputTest);
+    CPPUNIT_TEST (windowMapTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data members
+    static const char* const kernel_names[];
+    std::string default_kernel{};
+};
+
+// static class attribute
+const char* const FVTermTest::kernel_names[] = { "avx2", "sse2", "scalar" };
+
+//----------------------------------------------------------------------
+void FVTermTest::setUp()
+{
+  default_kernel = finalcut::getCharacterCompareKernel();
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::tearDown()
+{
+  finalcut::setCharacterCompareKernel (default_kernel.c_str());
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::kernelSelectionTest()
+{
+  CPPUNIT_ASSERT ( default_kernel == "avx2"
+                || default_kernel == "sse2"
+                || default_kernel == "scalar" );
+
+  // The scalar kernel is always available
+  CPPUNIT_ASSERT ( finalcut::setCharacterCompareKernel("scalar") );
+  CPPUNIT_ASSERT ( std::strcmp(finalcut::getCharacterCompareKernel(), "scalar") == 0 );
+  CPPUNIT_ASSERT ( ! finalcut::setCharacterCompareKernel("mmx") );
+  CPPUNIT_ASSERT ( ! finalcut::setCharacterCompareKernel("") );
+  CPPUNIT_ASSERT ( std::strcmp(finalcut::getCharacterCompareKernel(), "scalar") == 0 );
+
+  CPPUNIT_ASSERT ( finalcut::setCharacterCompareKernel(default_kernel.c_str()) );
+  CPPUNIT_ASSERT ( finalcut::getCharacterCompareKernel() == default_kernel );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::noChangesTest()
+{
+  for (auto&& name : kernel_names)
+  {
+    if ( ! finalcut::setCharacterCompareKernel(name) )
+      continue;
+
+    for (std::size_t length{0}; length < 40; length++)
+    {
+      const std::vector<finalcut::FChar> a(length, test::getCharacter(L'A'));
+      std::vector<finalcut::FChar> b(a);
+      CPPUNIT_ASSERT ( test::getChangedPos(a, b) == length );
+
+      if ( length > 0 )
+        CPPUNIT_ASSERT ( test::getUnchangedPos(a, b) == 0 );
+
+      // Properties without influence on the terminal output
+      for (auto&& ch : b)
+      {
+        ch.encoded_char = L'B';
+        ch.attr.bit.no_changes = true;
+      }
+
+      CPPUNIT_ASSERT ( test::getChangedPos(a, b) == length );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::unprintedTest()
+{
+  for (auto&& name : kernel_names)
+  {
+    if ( ! finalcut::setCharacterCompareKernel(name) )
+      continue;
+
+    std::vector<finalcut::FChar> line(23, test::getCharacter(L' '));
+
+    // The same line finds the first unprinted character
+    CPPUNIT_ASSERT ( test::getChangedPos(line, line) == 23 );
+    line[17].attr.bit.printed = false;
+    CPPUNIT_ASSERT ( test::getChangedPos(line, line) == 17 );
+    line[5].attr.bit.printed = false;
+    CPPUNIT_ASSERT ( test::getChangedPos(line, line) == 5 );
+    CPPUNIT_ASSERT ( test::getChangedPos(line, line, 6) == 11 );
+    CPPUNIT_ASSERT ( test::getUnchangedPos(line, line, 5) == 1 );
+    CPPUNIT_ASSERT ( test::getUnchangedPos(line, line, 17) == 1 );
+
+    // The printed flag of the area character is irrelevant
+    std::vector<finalcut::FChar> area(23, test::getCharacter(L' '));
+
+    for (auto&& ch : area)
+      ch.attr.bit.printed = false;
+
+    CPPUNIT_ASSERT ( test::getChangedPos(area, line) == 5 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::characterChangesTest()
+{
+  for (auto&& name : kernel_names)
+  {
+    if ( ! finalcut::setCharacterCompareKernel(name) )
+      continue;
+
+    const std::vector<finalcut::FChar> vterm(9, test::getCharacter(L'x'));
+    std::vector<finalcut::FChar> area(vterm);
+
+    area[8].ch = L'y';
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 8 );
+    area[7].fg_color = finalcut::fc::Red;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 7 );
+    area[6].bg_color = finalcut::fc::Blue;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 6 );
+    area[5].attr.bit.invisible = true;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 5 );
+    area[4].attr.bit.inherit_background = true;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 4 );
+    area[3].attr.bit.fullwidth_padding = true;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 3 );
+    area[2].attr.bit.bold = true;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 2 );
+    area[1].attr.bit.char_width = 2;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 2 );
+    area[0].attr.bit.protect = true;
+    CPPUNIT_ASSERT ( test::getChangedPos(area, vterm) == 0 );
+    CPPUNIT_ASSERT ( test::getUnchangedPos(area, vterm) == 1 );
+    CPPUNIT_ASSERT ( test::getUnchangedPos(area, vterm, 2) == 7 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::runTest()
+{
+  for (auto&& name : kernel_names)
+  {
+    if ( ! finalcut::setCharacterCompareKernel(name) )
+      continue;
+
+    // Walks through the runs of changed characters
+    const std::vector<finalcut::FChar> vterm(80, test::getCharacter(L'.'));
+    std::vector<finalcut::FChar> area(vterm);
+
+    for (std::size_t x{10}; x < 15; x++)
+      area[x].ch = L'#';
+
+    for (std::size_t x{60}; x < 80; x++)
+      area[x].ch = L'#';
+
+    std::size_t x = test::getChangedPos(area, vterm);
+    CPPUNIT_ASSERT ( x == 10 );
+    x += test::getUnchangedPos(area, vterm, x);
+    CPPUNIT_ASSERT ( x == 15 );
+    x += test::getChangedPos(area, vterm, x);
+    CPPUNIT_ASSERT ( x == 60 );
+    x += test::getUnchangedPos(area, vterm, x);
+    CPPUNIT_ASSERT ( x == 80 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::kernelComparisonTest()
+{
+  // All kernels must return the same result as the scalar kernel
+
+  std::srand(4711);
+
+  for (int n{0}; n < 2000; n++)
+  {
+    const auto length = std::size_t(std::rand() % 70);
+    std::vector<finalcut::FChar> vterm(length, test::getCharacter(L'a'));
+    std::vector<finalcut::FChar> area(vterm);
+
+    for (std::size_t x{0}; x < length; x++)
+    {
+      switch ( std::rand() % 24 )
+      {
+        case 0:
+          area[x].ch = L'b';
+          break;
+
+        case 1:
+          area[x].fg_color = finalcut::fc::Green;
+          break;
+
+        case 2:
+          area[x].attr.byte[std::rand() % 2] ^= uInt8(1 << (std::rand() % 8));
+          break;
+
+        case 3:
+          vterm[x].attr.bit.printed = false;
+          break;
+
+        case 4:
+          area[x].encoded_char = L'c';
+          break;
+
+        default:
+          break;
+      }
+    }
+
+    const std::size_t start = ( length > 0 ) ? std::size_t(std::rand()) % length : 0;
+    finalcut::setCharacterCompareKernel("scalar");
+    const std::size_t changed = test::getChangedPos(area, vterm, start);
+    const std::size_t unchanged = test::getUnchangedPos(area, vterm, start);
+
+    for (auto&& name : kernel_names)
+    {
+      if ( ! finalcut::setCharacterCompareKernel(name) )
+        continue;
+
+      CPPUNIT_ASSERT ( test::getChangedPos(area, vterm, start) == changed );
+      CPPUNIT_ASSERT ( test::getUnchangedPos(area, vterm, start) == unchanged );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::shiftTest()
+{
+  const finalcut::FVTerm::FUpdateCosts costs = { 8, 5, 6, 4, 4 };
+  const finalcut::FVTerm::FUpdateCosts no_shift = { 8, 5, 6, INT_MAX, INT_MAX };
+  const std::wstring text = L"The quick brown fox jumps over the lazy dog";
+  const std::size_t length = text.length() + 10;
+  std::vector<finalcut::FChar> term(length, test::getCharacter(L' '));
+  std::vector<finalcut::FChar> vterm(term);
+
+  for (std::size_t x{0}; x < text.length(); x++)
+    term[x].ch = text[x];
+
+  // Insert a character in front of "quick"
+  const std::wstring inserted = L"The Xquick brown fox jumps over the lazy dog";
+
+  for (std::size_t x{0}; x < length; x++)
+  {
+    vterm[x].ch = ( x < inserted.length() ) ? inserted[x] : L' ';
+    vterm[x].attr.bit.printed = ( vterm[x] == term[x] );
+  }
+
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[4], &vterm[4], length - 4, costs) == 1 );
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[4], &vterm[4], length - 4, no_shift) == 0 );
+
+  // Delete "quick "
+  const std::wstring deleted = L"The brown fox jumps over the lazy dog";
+
+  for (std::size_t x{0}; x < length; x++)
+  {
+    vterm[x].ch = ( x < deleted.length() ) ? deleted[x] : L' ';
+    vterm[x].attr.bit.printed = ( vterm[x] == term[x] );
+  }
+
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[4], &vterm[4], length - 4, costs) == -6 );
+
+  // Overwriting a short rest of the line is cheaper
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[36], &vterm[36], 8, costs) == 0 );
+
+  // Unknown terminal characters cannot be shifted
+  for (auto&& ch : term)
+    ch.attr.bit.printed = false;
+
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[4], &vterm[4], length - 4, costs) == 0 );
+
+  // Changed colors do not match
+  for (auto&& ch : term)
+  {
+    ch.attr.bit.printed = true;
+    ch.fg_color = finalcut::fc::Red;
+  }
+
+  CPPUNIT_ASSERT ( finalcut::getCharacterShift \
+                       (&term[4], &vterm[4], length - 4, costs) == 0 );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::lineChangesTest()
+{
+  using test::FVTermChanges;
+  finalcut::FVTerm::FLineChanges changes{};
+  FVTermChanges::resetLineChanges (changes, 300);
+  CPPUNIT_ASSERT ( changes.getXmin() == 300 );
+  CPPUNIT_ASSERT ( changes.getXmax() == 0 );
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 0 );
+
+  // Two changes at opposite ends of the line
+  FVTermChanges::addLineChanges (changes, 2, 4);
+  FVTermChanges::addLineChanges (changes, 290, 290);
+  CPPUNIT_ASSERT ( changes.getXmin() == 2 );
+  CPPUNIT_ASSERT ( changes.getXmax() == 290 );
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 2 );
+  CPPUNIT_ASSERT ( changes.getRange(0).xmin == 2 );
+  CPPUNIT_ASSERT ( changes.getRange(0).xmax == 4 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 290 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmax == 290 );
+
+  // Sorted insertion
+  FVTermChanges::addLineChanges (changes, 100, 110);
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 3 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 100 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmax == 110 );
+
+  // Adjacent and overlapping ranges are combined
+  FVTermChanges::addLineChanges (changes, 5, 5);
+  FVTermChanges::addLineChanges (changes, 95, 99);
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 3 );
+  CPPUNIT_ASSERT ( changes.getRange(0).xmax == 5 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 95 );
+
+  FVTermChanges::addLineChanges (changes, 4, 120);
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 2 );
+  CPPUNIT_ASSERT ( changes.getRange(0).xmin == 2 );
+  CPPUNIT_ASSERT ( changes.getRange(0).xmax == 120 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 290 );
+
+  // A changed line includes all ranges
+  FVTermChanges::addLineChanges (changes, 0, 299);
+  CPPUNIT_ASSERT ( changes.getXmin() == 0 );
+  CPPUNIT_ASSERT ( changes.getXmax() == 299 );
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 1 );
+
+  // An empty range changes nothing
+  FVTermChanges::resetLineChanges (changes, 300);
+  FVTermChanges::addLineChanges (changes, 10, 9);
+  CPPUNIT_ASSERT ( changes.getXmin() > changes.getXmax() );
+  CPPUNIT_ASSERT ( changes.getRangeCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::lineRangeLimitTest()
+{
+  using test::FVTermChanges;
+  constexpr uInt max = finalcut::FVTerm::MAX_LINE_RANGES;
+  finalcut::FVTerm::FLineChanges changes{};
+  FVTermChanges::resetLineChanges (changes, 300);
+
+  // Single changed cells in every 10th column
+  for (uInt i{0}; i < max; i++)
+    FVTermChanges::addLineChanges (changes, 10 * i, 10 * i);
+
+  CPPUNIT_ASSERT ( changes.getRangeCount() == max );
+
+  // The new range joins its closest neighbor
+  FVTermChanges::addLineChanges (changes, 13, 13);
+  FVTermChanges::addLineChanges (changes, 23, 23);
+  CPPUNIT_ASSERT ( changes.getRangeCount() == max );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 10 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmax == 13 );
+  CPPUNIT_ASSERT ( changes.getRange(2).xmin == 20 );
+  CPPUNIT_ASSERT ( changes.getRange(2).xmax == 23 );
+
+  // The two closest existing ranges are merged
+  FVTermChanges::addLineChanges (changes, 200, 200);
+  CPPUNIT_ASSERT ( changes.getRangeCount() == max );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmin == 10 );
+  CPPUNIT_ASSERT ( changes.getRange(1).xmax == 23 );
+  CPPUNIT_ASSERT ( changes.getRange(2).xmin == 30 );
+  CPPUNIT_ASSERT ( changes.getRange(max - 1).xmin == 200 );
+  CPPUNIT_ASSERT ( changes.getXmin() == 0 );
+  CPPUNIT_ASSERT ( changes.getXmax() == 200 );
+
+  // The ranges stay sorted and disjoint
+  for (uInt i{1}; i < changes.getRangeCount(); i++)
+    CPPUNIT_ASSERT ( changes.getRange(i - 1).xmax + 1 < changes.getRange(i).xmin );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::statisticsTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+  const auto& stats = finalcut::FVTerm::getFrameStatistics();
+  const uInt64 first_frame = stats.frame;
+
+  finalcut::FDialog dialog("Stats", &app);
+  dialog.setGeometry (finalcut::FPoint{5, 3}, finalcut::FSize{20, 5});
+  dialog.show();
+  terminal.clearOutput();
+  dialog.setPos (finalcut::FPoint{10, 4});
+
+  CPPUNIT_ASSERT ( stats.frame > first_frame );
+  CPPUNIT_ASSERT ( stats.composited_areas > 0 );
+  CPPUNIT_ASSERT ( stats.compared_cells > 0 );
+  CPPUNIT_ASSERT ( stats.emitted_cells >= 20 * 5 );
+  CPPUNIT_ASSERT ( stats.emitted_cells <= stats.compared_cells );
+  CPPUNIT_ASSERT ( stats.cursor_moves > 0 );
+  CPPUNIT_ASSERT ( stats.cursor_move_bytes >= stats.cursor_moves );
+  CPPUNIT_ASSERT ( stats.attribute_changes > 0 );
+  CPPUNIT_ASSERT ( stats.written_bytes == terminal.getOutput().length() );
+  CPPUNIT_ASSERT ( stats.flush_time > 0 );
+  CPPUNIT_ASSERT ( terminal.getLine(3).includes("Stats") );
+
+  // A frame without changes is not counted
+  const uInt64 frame = stats.frame;
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( stats.frame == frame );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::refusedWriteTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+  const auto& stats = finalcut::FVTerm::getFrameStatistics();
+
+  finalcut::FDialog dialog("Retry", &app);
+  dialog.setGeometry (finalcut::FPoint{5, 3}, finalcut::FSize{20, 5});
+  dialog.show();
+  app.updateTerminal();
+
+  // A refused write waits for the terminal and then retries
+  terminal.clearOutput();
+  terminal.poll_calls = 0;
+  terminal.write_calls = 0;
+  terminal.refuse_writes = true;
+  dialog.setPos (finalcut::FPoint{2, 6});
+  terminal.refuse_writes = false;
+  CPPUNIT_ASSERT ( terminal.write_calls >= 2 );
+  CPPUNIT_ASSERT ( terminal.write_calls % 2 == 0 );
+  CPPUNIT_ASSERT ( terminal.poll_calls == terminal.write_calls / 2 );
+  CPPUNIT_ASSERT ( stats.written_bytes == terminal.getOutput().length() );
+  CPPUNIT_ASSERT ( terminal.getLine(5).includes("Retry") );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::scrollAreaTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  // The scrolled rectangle covers the full terminal width
+  finalcut::FDialog dialog("Scroll", &app);
+  dialog.setGeometry (finalcut::FPoint{1, 2}, finalcut::FSize{40, 8});
+  dialog.show();
+  dialog.print() << finalcut::FPoint{3, 2} << "line A"
+                 << finalcut::FPoint{3, 3} << "line B"
+                 << finalcut::FPoint{3, 4} << "line C"
+                 << finalcut::FPoint{3, 5} << "line D";
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( terminal.getLine(2).includes("line A") );
+
+  // The terminal lines 2 to 4 (0-based) scroll one line up
+  terminal.clearOutput();
+  const finalcut::FRect box { finalcut::FPoint{1, 3}, finalcut::FSize{40, 3} };
+  dialog.scrollArea (box, 1);
+  app.updateTerminal();
+  const auto& output = terminal.getOutput();
+  CPPUNIT_ASSERT ( terminal.getLine(2).includes("line B") );
+  CPPUNIT_ASSERT ( terminal.getLine(3).includes("line C") );
+  CPPUNIT_ASSERT ( ! terminal.getLine(4).includes("line") );
+  CPPUNIT_ASSERT ( terminal.getLine(5).includes("line D") );
+  CPPUNIT_ASSERT ( output.find("\033[3;5r") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("line") == std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::scrollDetectionTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  finalcut::FDialog dialog("Pane", &app);
+  dialog.setGeometry (finalcut::FPoint{1, 2}, finalcut::FSize{40, 8});
+  dialog.show();
+  test::printRows (dialog, 1);
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( terminal.getLine(2).includes("row 1 ") );
+
+  // The pane content moves one line up without a scroll hint
+  terminal.clearOutput();
+  test::printRows (dialog, 2);
+  app.updateTerminal();
+  const auto& output = terminal.getOutput();
+
+  for (int i{0}; i < 6; i++)
+    CPPUNIT_ASSERT ( test::hasRow(terminal, 2 + i, 2 + i) );
+
+  // A scrolling region with a line feed moves the lines,
+  // only the exposed line is transmitted
+  CPPUNIT_ASSERT ( output.find("\033[3;8r") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("\n") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("row 7 ") != std::string::npos );
+
+  for (int i{2}; i < 7; i++)
+    CPPUNIT_ASSERT ( ! test::hasRowOutput(output, i) );
+
+  // The pane content moves one line down
+  terminal.clearOutput();
+  test::printRows (dialog, 1);
+  app.updateTerminal();
+
+  for (int i{0}; i < 6; i++)
+    CPPUNIT_ASSERT ( test::hasRow(terminal, 2 + i, 1 + i) );
+
+  CPPUNIT_ASSERT ( output.find("\033[3;8r") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("\033M") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("row 1 ") != std::string::npos );
+
+  for (int i{2}; i < 7; i++)
+    CPPUNIT_ASSERT ( ! test::hasRowOutput(output, i) );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::scrollFallbackTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  finalcut::FDialog dialog("Pane", &app);
+  dialog.setGeometry (finalcut::FPoint{1, 2}, finalcut::FSize{40, 8});
+  dialog.show();
+  test::printRows (dialog, 1);
+  app.updateTerminal();
+
+  // Without a scrolling region, lines are deleted and inserted
+  const test::FTermcapRemoval csr(finalcut::fc::t_change_scroll_region);
+  terminal.clearOutput();
+  test::printRows (dialog, 2);
+  app.updateTerminal();
+  const auto& output = terminal.getOutput();
+
+  for (int i{0}; i < 6; i++)
+    CPPUNIT_ASSERT ( test::hasRow(terminal, 2 + i, 2 + i) );
+
+  CPPUNIT_ASSERT ( output.find("\033[3;8r") == std::string::npos );
+  CPPUNIT_ASSERT ( output.find("\033[M") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("\033[L") != std::string::npos );
+
+  for (int i{2}; i < 7; i++)
+    CPPUNIT_ASSERT ( ! test::hasRowOutput(output, i) );
+
+  // Without line deletion, the changed lines are repainted
+  const test::FTermcapRemoval dl(finalcut::fc::t_delete_line);
+  const test::FTermcapRemoval DL(finalcut::fc::t_parm_delete_line);
+  terminal.clearOutput();
+  test::printRows (dialog, 1);
+  app.updateTerminal();
+
+  for (int i{0}; i < 6; i++)
+    CPPUNIT_ASSERT ( test::hasRow(terminal, 2 + i, 1 + i) );
+
+  CPPUNIT_ASSERT ( output.find("\033[M") == std::string::npos );
+  CPPUNIT_ASSERT ( output.find("\033[L") == std::string::npos );
+
+  for (int i{1}; i < 7; i++)
+    CPPUNIT_ASSERT ( test::hasRowOutput(output, i) );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::characterShiftTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  finalcut::FDialog dialog("Shift", &app);
+  dialog.setGeometry (finalcut::FPoint{1, 2}, finalcut::FSize{40, 5});
+  dialog.show();
+  dialog.print() << finalcut::FPoint{1, 2} << "0123456789abcdefghijklmnopqrstuvw";
+  app.updateTerminal();
+
+  // A character inserted before the text shifts the terminal line
+  terminal.clearOutput();
+  dialog.print() << finalcut::FPoint{1, 2} << "x0123456789abcdefghijklmnopqrstuv";
+  app.updateTerminal();
+  const auto& output = terminal.getOutput();
+  CPPUNIT_ASSERT ( terminal.getLine(2).includes("x0123456789abcdefghijklmnopqrstuv") );
+  CPPUNIT_ASSERT ( output.find("@") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("0123") == std::string::npos );
+
+  // A single deleted character uses the short delete sequence
+  terminal.clearOutput();
+  dialog.print() << finalcut::FPoint{1, 2} << "0123456789abcdefghijklmnopqrstuv ";
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( terminal.getLine(2).includes("0123456789abcdefghijklmnopqrstuv") );
+  CPPUNIT_ASSERT ( output.find("\033[P") != std::string::npos );
+  CPPUNIT_ASSERT ( output.find("0123") == std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::asyncOutputTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  finalcut::FDialog dialog("Async", &app);
+  dialog.setGeometry (finalcut::FPoint{5, 3}, finalcut::FSize{20, 5});
+  dialog.show();
+  app.updateTerminal();
+
+  // Direct terminal output waits for the frames of the writer thread
+  CPPUNIT_ASSERT ( finalcut::FVTerm::setAsyncOutput() );
+  terminal.clearOutput();
+  dialog.setPos (finalcut::FPoint{1, 3});
+  finalcut::FTerm::beep();
+  const auto& output = terminal.getOutput();
+  CPPUNIT_ASSERT ( output.length() > 1 );
+  CPPUNIT_ASSERT ( output.back() == '\a' );
+  CPPUNIT_ASSERT ( ! finalcut::FVTerm::unsetAsyncOutput() );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::windowMapTest()
+{
+  auto& app = test::getApplication();
+  auto& terminal = test::getTerminal();
+
+  // Window a covers the columns 0-15 and the lines 1-6,
+  // window b covers the columns 8-23 and the lines 3-8
+  finalcut::FDialog dialog_a("A", &app);
+  dialog_a.setGeometry (finalcut::FPoint{1, 2}, finalcut::FSize{16, 6});
+  dialog_a.unsetShadow();
+  dialog_a.show();
+  test::fillDialog (dialog_a, 'a');
+  finalcut::FDialog dialog_b("B", &app);
+  dialog_b.setGeometry (finalcut::FPoint{9, 4}, finalcut::FSize{16, 6});
+  dialog_b.unsetShadow();
+  dialog_b.show();
+  test::fillDialog (dialog_b, 'b');
+  app.updateTerminal();
+  const auto win_a = dialog_a.getVWin();
+  const auto win_b = dialog_b.getVWin();
+
+  // The later window is on top
+  CPPUNIT_ASSERT ( test::getOwner(3, 3) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(20, 7) == win_b );
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_b );
+  CPPUNIT_ASSERT ( test::getOwner(35, 10) == nullptr );
+  CPPUNIT_ASSERT ( terminal.getCharacter({3, 3}) == L'a' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({20, 7}) == L'b' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'b' );
+
+  // Raise window a
+  CPPUNIT_ASSERT ( dialog_a.raiseWindow() );
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(20, 7) == win_b );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'a' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({20, 7}) == L'b' );
+
+  // Lower window a
+  CPPUNIT_ASSERT ( dialog_a.lowerWindow() );
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_b );
+  CPPUNIT_ASSERT ( test::getOwner(3, 3) == win_a );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'b' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({3, 3}) == L'a' );
+
+  // Hide window b
+  // Hiding does not restore the terminal (see FWindow::~FWindow)
+  dialog_b.hide();
+  test::FVTermWindowMap::restoreVTerm (dialog_b.getTermGeometry());
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(20, 7) == nullptr );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'a' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({20, 7}) != L'b' );
+
+  // Show window b again
+  dialog_b.show();
+  test::fillDialog (dialog_b, 'b');
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_b );
+  CPPUNIT_ASSERT ( test::getOwner(20, 7) == win_b );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'b' );
+
+  // Move window b to the columns 20-35
+  dialog_b.setPos (finalcut::FPoint{21, 4});
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(10, 4) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(9, 8) == nullptr );
+  CPPUNIT_ASSERT ( test::getOwner(30, 7) == win_b );
+  CPPUNIT_ASSERT ( terminal.getCharacter({10, 4}) == L'a' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({9, 8}) != L'b' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({30, 7}) == L'b' );
+
+  // Resize window a to the columns 0-29 below window b
+  dialog_a.setSize (finalcut::FSize{30, 6});
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(18, 3) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(22, 5) == win_b );
+  CPPUNIT_ASSERT ( test::getOwner(32, 1) == nullptr );
+  CPPUNIT_ASSERT ( terminal.getCharacter({22, 5}) == L'b' );
+
+  // Shrink window a to its minimum width (columns 0-14)
+  dialog_a.setSize (finalcut::FSize{15, 6});
+  app.updateTerminal();
+  CPPUNIT_ASSERT ( test::getOwner(3, 3) == win_a );
+  CPPUNIT_ASSERT ( test::getOwner(18, 3) == nullptr );
+  CPPUNIT_ASSERT ( test::getOwner(22, 5) == win_b );
+  CPPUNIT_ASSERT ( terminal.getCharacter({18, 3}) == L' ' );
+  CPPUNIT_ASSERT ( terminal.getCharacter({22, 5}) == L'b' );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FVTermTest);
+
+// The general unit test main part
+#include <main-test.inc>